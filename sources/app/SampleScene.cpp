@@ -5,4 +5,15 @@ using namespace mog;
 void SampleScene::onLoad() {
     auto label = Label::create("Hello Mog2d!", 40.0f);
     this->add(label);
+
+    // a half alpha child drawn with and without the group cache, both should look the same
+    for (int i = 0; i < 2; i++) {
+        auto group = Group::create();
+        group->setCacheAsTexture(i == 1);
+        group->setPosition(20.0f + i * 120.0f, 80.0f);
+        auto rect = Rectangle::create(100.0f, 100.0f);
+        rect->setColor(1.0f, 0, 0, 0.5f);
+        group->add(rect);
+        this->add(group);
+    }
 }
@@ -22,6 +22,9 @@
 #define BASE_SCREEN_HEIGHT 640
 #define BASE_SCREEN_WIDTH 0
 #define MOG_STATS_ENABLE 0
+#define DATA_STORE_PAUSE_FLUSH_TIMEOUT 2.0f
+#define DATA_STORE_CACHE_SHARD_NUM 16
+#define DATA_STORE_COMPRESSION_ENABLE 0
 
 #define LOG_DEBUG       1
 #define LOG_INFO        2
@@ -0,0 +1,360 @@
+#include "mog/base/AnimationClip.h"
+#include "mog/base/SpriteSheet.h"
+#include "mog/core/Json.h"
+#include "mog/core/FileUtils.h"
+#include <math.h>
+#include <algorithm>
+
+using namespace mog;
+
+static const std::pair<const char *, Easing> easingNames[] = {
+    {"Linear", Easing::Linear},
+    {"QuadIn", Easing::QuadIn}, {"QuadOut", Easing::QuadOut}, {"QuadInOut", Easing::QuadInOut},
+    {"CubicIn", Easing::CubicIn}, {"CubicOut", Easing::CubicOut}, {"CubicInOut", Easing::CubicInOut},
+    {"QuartIn", Easing::QuartIn}, {"QuartOut", Easing::QuartOut}, {"QuartInOut", Easing::QuartInOut},
+    {"QuintIn", Easing::QuintIn}, {"QuintOut", Easing::QuintOut}, {"QuintInOut", Easing::QuintInOut},
+    {"SineIn", Easing::SineIn}, {"SineOut", Easing::SineOut}, {"SineInOut", Easing::SineInOut},
+    {"BackIn", Easing::BackIn}, {"BackOut", Easing::BackOut}, {"BackInOut", Easing::BackInOut},
+    {"CircIn", Easing::CircIn}, {"CircOut", Easing::CircOut}, {"CircInOut", Easing::CircInOut},
+    {"BounceIn", Easing::BounceIn}, {"BounceOut", Easing::BounceOut}, {"BounceInOut", Easing::BounceInOut},
+    {"ElasticIn", Easing::ElasticIn}, {"ElasticOut", Easing::ElasticOut}, {"ElasticInOut", Easing::ElasticInOut},
+};
+
+static int getValueNum(AnimationProperty property) {
+    switch (property) {
+        case AnimationProperty::Position:
+        case AnimationProperty::Scale:
+            return 2;
+        case AnimationProperty::Color:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+static bool parseProperty(std::string name, AnimationProperty *property) {
+    if (name == "position") {
+        *property = AnimationProperty::Position;
+    } else if (name == "scale") {
+        *property = AnimationProperty::Scale;
+    } else if (name == "rotation") {
+        *property = AnimationProperty::Rotation;
+    } else if (name == "color") {
+        *property = AnimationProperty::Color;
+    } else if (name == "frame") {
+        *property = AnimationProperty::Frame;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool parseKeyframe(const std::shared_ptr<Dictionary> &dict, AnimationProperty property, AnimationKeyframe *keyframe) {
+    const auto &time = dict->getValue("time");
+    if (!time.isNumber()) return false;
+    keyframe->time = time.getFloat();
+    if (!dict->hasKey("value")) return false;
+
+    int valueNum = getValueNum(property);
+    switch (dict->getType("value")) {
+        case DataType::String: {
+            if (property != AnimationProperty::Color) return false;
+            Color color = Color(dict->get<String>("value")->getValue());
+            keyframe->values[0] = color.r;
+            keyframe->values[1] = color.g;
+            keyframe->values[2] = color.b;
+            keyframe->values[3] = color.a;
+            break;
+        }
+        case DataType::List: {
+            auto list = dict->get<List>("value");
+            int size = (int)list->size();
+            if (property == AnimationProperty::Color) {
+                if (size < 3) return false;
+                keyframe->values[3] = 1.0f;
+            } else if (size < valueNum) {
+                return false;
+            }
+            for (int i = 0; i < std::min(size, valueNum); i++) {
+                const auto &value = list->valueAt(i);
+                if (!value.isNumber()) return false;
+                keyframe->values[i] = value.getFloat();
+            }
+            break;
+        }
+        default: {
+            // a single number is a uniform scale, or the value of a one component property
+            const auto &value = dict->getValue("value");
+            if (!value.isNumber() || valueNum == 4) return false;
+            float v = value.getFloat();
+            keyframe->values[0] = v;
+            keyframe->values[1] = v;
+            break;
+        }
+    }
+
+    if (dict->hasKey("easing") && dict->getType("easing") == DataType::String) {
+        std::string name = dict->get<String>("easing")->getValue();
+        for (const auto &pair : easingNames) {
+            if (name == pair.first) {
+                keyframe->easing = pair.second;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+
+#pragma - AnimationKeyframe
+
+AnimationKeyframe::AnimationKeyframe(float time, float value, Easing easing) : time(time), easing(easing) {
+    this->values[0] = value;
+    this->values[1] = value;
+}
+
+AnimationKeyframe::AnimationKeyframe(float time, const Point &value, Easing easing) : time(time), easing(easing) {
+    this->values[0] = value.x;
+    this->values[1] = value.y;
+}
+
+AnimationKeyframe::AnimationKeyframe(float time, const Color &value, Easing easing) : time(time), easing(easing) {
+    this->values[0] = value.r;
+    this->values[1] = value.g;
+    this->values[2] = value.b;
+    this->values[3] = value.a;
+}
+
+AnimationTrack::AnimationTrack(AnimationProperty property, const std::vector<AnimationKeyframe> &keyframes)
+: property(property), keyframes(keyframes) {
+}
+
+
+#pragma - AnimationClip
+
+std::shared_ptr<AnimationClip> AnimationClip::create(const std::vector<AnimationTrack> &tracks) {
+    auto clip = std::shared_ptr<AnimationClip>(new AnimationClip());
+    for (const auto &track : tracks) {
+        if (track.keyframes.size() == 0) continue;
+        auto keyframes = track.keyframes;
+        std::stable_sort(keyframes.begin(), keyframes.end(), [](const AnimationKeyframe &k1, const AnimationKeyframe &k2) {
+            return k1.time < k2.time;
+        });
+
+        Track t;
+        t.property = track.property;
+        t.valueNum = getValueNum(track.property);
+        t.keyframeIdx = (int)clip->times.size();
+        t.keyframeNum = (int)keyframes.size();
+        for (const auto &keyframe : keyframes) {
+            clip->times.emplace_back(keyframe.time);
+            clip->easings.emplace_back(keyframe.easing);
+            for (int i = 0; i < t.valueNum; i++) {
+                clip->values.emplace_back(keyframe.values[i]);
+            }
+        }
+        clip->tracks.emplace_back(t);
+        clip->duration = std::max(clip->duration, keyframes.back().time);
+    }
+    return clip;
+}
+
+std::shared_ptr<AnimationClip> AnimationClip::parse(std::string jsonText) {
+    return AnimationClip::parse(Json::parse(jsonText));
+}
+
+std::shared_ptr<AnimationClip> AnimationClip::parse(const std::shared_ptr<Dictionary> &dict) {
+    std::vector<AnimationTrack> tracks;
+    if (!dict || !dict->hasKey("tracks") || dict->getType("tracks") != DataType::List) {
+        LOGW("AnimationClip: tracks not found.");
+        return AnimationClip::create(tracks);
+    }
+
+    auto trackList = dict->get<List>("tracks");
+    for (int i = 0; i < (int)trackList->size(); i++) {
+        if (trackList->atType(i) != DataType::Dictionary) continue;
+        auto trackDict = trackList->at<Dictionary>(i);
+        if (!trackDict->hasKey("property") || trackDict->getType("property") != DataType::String) continue;
+        if (!trackDict->hasKey("keyframes") || trackDict->getType("keyframes") != DataType::List) continue;
+
+        AnimationTrack track;
+        std::string name = trackDict->get<String>("property")->getValue();
+        if (!parseProperty(name, &track.property)) {
+            LOGW("AnimationClip: unknown property %s", name.c_str());
+            continue;
+        }
+        auto keyframeList = trackDict->get<List>("keyframes");
+        for (int j = 0; j < (int)keyframeList->size(); j++) {
+            if (keyframeList->atType(j) != DataType::Dictionary) continue;
+            AnimationKeyframe keyframe;
+            if (parseKeyframe(keyframeList->at<Dictionary>(j), track.property, &keyframe)) {
+                track.keyframes.emplace_back(keyframe);
+            }
+        }
+        tracks.emplace_back(track);
+    }
+    return AnimationClip::create(tracks);
+}
+
+std::shared_ptr<AnimationClip> AnimationClip::createWithJson(std::string filename) {
+    return AnimationClip::parse(FileUtils::readTextAsset(filename));
+}
+
+float AnimationClip::getDuration() const {
+    return this->duration;
+}
+
+int AnimationClip::getTrackCount() const {
+    return (int)this->tracks.size();
+}
+
+AnimationProperty AnimationClip::getTrackProperty(int trackIdx) const {
+    return this->tracks[trackIdx].property;
+}
+
+int AnimationClip::sample(int trackIdx, float time, int cursor, float *values) const {
+    const auto &track = this->tracks[trackIdx];
+    const float *times = &this->times[track.keyframeIdx];
+    const float *keyValues = &this->values[track.keyframeIdx * track.valueNum];
+    int n = track.keyframeNum;
+    int vn = track.valueNum;
+
+    if (n == 1 || time <= times[0]) {
+        for (int i = 0; i < vn; i++) values[i] = keyValues[i];
+        return 0;
+    }
+    if (time >= times[n - 1]) {
+        for (int i = 0; i < vn; i++) values[i] = keyValues[(n - 1) * vn + i];
+        return n - 2;
+    }
+
+    // players advance monotonically, so the cached segment or the next one almost always matches
+    int seg;
+    if (cursor >= 0 && cursor < n - 1 && times[cursor] <= time) {
+        if (time < times[cursor + 1]) {
+            seg = cursor;
+        } else if (cursor + 2 < n && time < times[cursor + 2]) {
+            seg = cursor + 1;
+        } else {
+            seg = (int)(std::upper_bound(times + cursor, times + n, time) - times) - 1;
+        }
+    } else {
+        seg = (int)(std::upper_bound(times, times + n, time) - times) - 1;
+    }
+
+    const float *v0 = &keyValues[seg * vn];
+    const float *v1 = &keyValues[(seg + 1) * vn];
+    if (track.property == AnimationProperty::Frame) {
+        values[0] = v0[0];
+        return seg;
+    }
+    float span = times[seg + 1] - times[seg];
+    float p = EasingFunc::ease(this->easings[track.keyframeIdx + seg], (time - times[seg]) / span);
+    for (int i = 0; i < vn; i++) {
+        values[i] = v0[i] + (v1[i] - v0[i]) * p;
+    }
+    return seg;
+}
+
+
+#pragma - AnimationPlayer
+
+std::shared_ptr<AnimationPlayer> AnimationPlayer::create(const std::shared_ptr<AnimationClip> &clip, LoopType loopType, int loopCount) {
+    return std::shared_ptr<AnimationPlayer>(new AnimationPlayer(clip, loopType, loopCount));
+}
+
+AnimationPlayer::AnimationPlayer(const std::shared_ptr<AnimationClip> &clip, LoopType loopType, int loopCount)
+: Tween(0, 1.0f, clip->getDuration(), Easing::Linear, loopType, loopCount, 0), clip(clip) {
+}
+
+void AnimationPlayer::init() {
+    Tween::init();
+    this->time = 0;
+    this->cursors.assign(this->clip->getTrackCount(), 0);
+}
+
+std::shared_ptr<AnimationClip> AnimationPlayer::getClip() {
+    return this->clip;
+}
+
+void AnimationPlayer::setSpeed(float speed) {
+    this->speed = speed;
+}
+
+float AnimationPlayer::getSpeed() {
+    return this->speed;
+}
+
+void AnimationPlayer::setTime(float time) {
+    this->time = std::min(std::max(time, 0.0f), this->duration);
+}
+
+float AnimationPlayer::getTime() {
+    return this->time;
+}
+
+void AnimationPlayer::update(float delta, const std::shared_ptr<Drawable> &drawable) {
+    if (this->pausing) return;
+
+    if (!this->started) {
+        this->started = true;
+        this->onStart(drawable);
+    } else {
+        this->time += delta * this->speed;
+    }
+
+    bool finished = false;
+    if (this->time >= this->duration) {
+        if (this->duration <= 0 || this->loopType == LoopType::None ||
+            (this->loopCount > 0 && this->currentCount + 1 >= this->loopCount)) {
+            this->time = this->duration;
+            finished = true;
+        } else {
+            this->time = fmod(this->time, this->duration);
+            this->currentCount++;
+            this->onRestart(drawable);
+        }
+    }
+
+    bool reversed = (this->loopType == LoopType::PingPong && this->currentCount % 2 == 1);
+    this->apply(reversed ? this->duration - this->time : this->time, drawable);
+
+    if (finished) {
+        this->onFinish(drawable);
+        for (auto ev : this->onFinishEventsForParent) {
+            ev(shared_from_this());
+        }
+    }
+}
+
+void AnimationPlayer::apply(float clipTime, const std::shared_ptr<Drawable> &drawable) {
+    if (this->target.lock() != drawable) {
+        this->target = drawable;
+        this->targetIsSpriteSheet = (dynamic_cast<SpriteSheet *>(drawable.get()) != nullptr);
+    }
+    auto spriteSheet = this->targetIsSpriteSheet ? static_cast<SpriteSheet *>(drawable.get()) : nullptr;
+
+    float v[4];
+    for (int i = 0; i < (int)this->cursors.size(); i++) {
+        this->cursors[i] = this->clip->sample(i, clipTime, this->cursors[i], v);
+        switch (this->clip->getTrackProperty(i)) {
+            case AnimationProperty::Position:
+                drawable->setPosition(Point(v[0], v[1]));
+                break;
+            case AnimationProperty::Scale:
+                drawable->setScale(Point(v[0], v[1]));
+                break;
+            case AnimationProperty::Rotation:
+                drawable->setRotation(v[0]);
+                break;
+            case AnimationProperty::Color:
+                drawable->setColor(Color(v[0], v[1], v[2], v[3]));
+                break;
+            case AnimationProperty::Frame:
+                if (spriteSheet && spriteSheet->getCurrentFrame() != (unsigned int)v[0]) {
+                    spriteSheet->selectFrame((unsigned int)v[0]);
+                }
+                break;
+        }
+    }
+}
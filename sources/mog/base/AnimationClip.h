@@ -0,0 +1,103 @@
+#ifndef AnimationClip_h
+#define AnimationClip_h
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "mog/core/plain_objects.h"
+#include "mog/core/Tween.h"
+#include "mog/core/Data.h"
+
+namespace mog {
+    class SpriteSheet;
+
+    enum class AnimationProperty {
+        Position,
+        Scale,
+        Rotation,
+        Color,
+        Frame,
+    };
+
+    class AnimationKeyframe {
+    public:
+        float time = 0;
+        float values[4] = {0, 0, 0, 0};
+        // easing of the segment that starts at this keyframe
+        Easing easing = Easing::Linear;
+
+        AnimationKeyframe() {}
+        AnimationKeyframe(float time, float value, Easing easing = Easing::Linear);
+        AnimationKeyframe(float time, const Point &value, Easing easing = Easing::Linear);
+        AnimationKeyframe(float time, const Color &value, Easing easing = Easing::Linear);
+    };
+
+    class AnimationTrack {
+    public:
+        AnimationProperty property = AnimationProperty::Position;
+        std::vector<AnimationKeyframe> keyframes;
+
+        AnimationTrack() {}
+        AnimationTrack(AnimationProperty property, const std::vector<AnimationKeyframe> &keyframes);
+    };
+
+    class AnimationClip {
+    public:
+        static std::shared_ptr<AnimationClip> create(const std::vector<AnimationTrack> &tracks);
+        static std::shared_ptr<AnimationClip> parse(std::string jsonText);
+        static std::shared_ptr<AnimationClip> parse(const std::shared_ptr<Dictionary> &dict);
+        static std::shared_ptr<AnimationClip> createWithJson(std::string filename);
+
+        float getDuration() const;
+        int getTrackCount() const;
+        AnimationProperty getTrackProperty(int trackIdx) const;
+        // returns the segment index to pass back as the cursor on the next call
+        int sample(int trackIdx, float time, int cursor, float *values) const;
+
+    protected:
+        struct Track {
+            AnimationProperty property;
+            int valueNum;
+            int keyframeIdx;
+            int keyframeNum;
+        };
+
+        AnimationClip() {}
+
+        std::vector<Track> tracks;
+        std::vector<float> times;
+        std::vector<float> values;
+        std::vector<Easing> easings;
+        float duration = 0;
+    };
+
+    class AnimationPlayer : public Tween {
+    public:
+        static std::shared_ptr<AnimationPlayer> create(const std::shared_ptr<AnimationClip> &clip, LoopType loopType = LoopType::None, int loopCount = 0);
+
+        virtual void init() override;
+        virtual void update(float delta, const std::shared_ptr<Drawable> &drawable) override;
+
+        std::shared_ptr<AnimationClip> getClip();
+        void setSpeed(float speed);
+        float getSpeed();
+        void setTime(float time);
+        float getTime();
+
+    protected:
+        AnimationPlayer(const std::shared_ptr<AnimationClip> &clip, LoopType loopType, int loopCount);
+
+        std::shared_ptr<AnimationClip> clip;
+        std::vector<int> cursors;
+        float time = 0;
+        float speed = 1.0f;
+        // weak, so that a new object allocated at the address of a released one is bound again
+        std::weak_ptr<Drawable> target;
+        bool targetIsSpriteSheet = false;
+
+        void apply(float clipTime, const std::shared_ptr<Drawable> &drawable);
+        virtual void onModify(float currentValue, const std::shared_ptr<Drawable> &drawable) override {}
+    };
+}
+
+#endif /* AnimationClip_h */
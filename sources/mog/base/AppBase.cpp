@@ -245,10 +245,20 @@ void AppBase::loadSceneWithSlideIn(const std::shared_ptr<Scene> &scene, Transiti
                                                     duration, easing, loadMode, 0, SceneTransition::SceneOrder::CurrentNext, f);
 }
 
-void AppBase::drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches, unsigned char parentDirtyFlag) {
+// app logic runs on every update, also on frames that are not rendered.
+// with a fixed timestep it runs once per step, and not on the interpolation pass.
+void AppBase::updateFrame(float delta, unsigned char parentDirtyFlag) {
+    auto engine = this->engine.lock();
+    if (this->currentScene && !this->sceneTransition) {
+        this->currentScene->updateFrame(engine, delta, parentDirtyFlag);
+    }
+    if (!engine || !engine->isInterpolatingFrame()) {
+        this->onUpdate(delta);
+    }
+}
+
+void AppBase::drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches) {
     if (this->currentScene) {
-        auto engine = this->engine.lock();
-        
         if (this->sceneTransition) {
             if (this->sceneTransition->update(delta)) {
                 return;
@@ -256,19 +266,15 @@ void AppBase::drawFrame(float delta, const std::map<unsigned int, TouchInput> &t
                 this->sceneTransition = nullptr;
             }
         } else {
-            this->currentScene->updateFrame(engine, delta, parentDirtyFlag);
             this->currentScene->drawFrame(delta, touches);
         }
-        if (this->doLoadScene()) {
-            return;
-        }
-        
-    } else {
-        if (this->doLoadScene()) {
-            return;
-        }
     }
-    this->onUpdate(delta);
+    this->doLoadScene();
+}
+
+bool AppBase::isDirty() {
+    if (this->sceneTransition || this->isReservedLoadScene) return true;
+    return (this->currentScene && this->currentScene->isDirty());
 }
 
 Color AppBase::getBackgroundColor() {
@@ -71,7 +71,9 @@ namespace mog {
         std::shared_ptr<PubSub> getPubSub();
         unsigned int getSceneStackSize();
 
-        virtual void drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches, unsigned char parentDirtyFlag = 0);
+        virtual void updateFrame(float delta, unsigned char parentDirtyFlag = 0);
+        virtual void drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches);
+        virtual bool isDirty();
         
         virtual void onLoad() {};
         virtual void onDispose() {};
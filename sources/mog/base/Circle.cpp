@@ -34,7 +34,7 @@ void Circle::init() {
     }
     this->textures[0] = Texture2D::createWithRGBA(data, texWidth, texHeight, Screen::getDensity());
     this->rect = Rect(Point::zero, this->size);
-    this->initRendererVertices(9, 12);
+    this->initRendererVertices(9, 24);
     
     this->dirtyFlag |= (DIRTY_ALL | DIRTY_SIZE | DIRTY_ANCHOR);
 }
@@ -68,16 +68,11 @@ void Circle::bindVertices(const std::shared_ptr<Renderer> &renderer, int *vertic
     }
 
     if (indicesIdx) {
-        int startI = *indicesIdx;
-        if (startI > 0) {
-            renderer->indices[*indicesIdx] = renderer->indices[(*indicesIdx) - 1];
-            (*indicesIdx)++;
-            renderer->indices[(*indicesIdx)++] = startN;
-        }
-        int ii[12] = {0, 3, 1, 4, 2, 5, 5, 8, 4, 7, 3, 6};
-        for (int i = 0; i < 12; i++) {
-            renderer->indices[(*indicesIdx)++] = ii[i] + startN;
-        }
+        short circleIndices[24] = {
+            0, 3, 1, 1, 3, 4, 1, 4, 2, 2, 4, 5,
+            3, 6, 4, 4, 6, 7, 4, 7, 5, 5, 7, 8,
+        };
+        this->bindIndices(renderer, indicesIdx, startN, circleIndices, 24);
     }
 }
 
@@ -104,7 +99,7 @@ void Circle::setRadius(float radius) {
     this->init();
 }
 
-std::shared_ptr<CIRCLE> Circle::getCIRCLE() {
+void Circle::updateCIRCLE(CIRCLE &circle) {
     float scaleX = sqrt(this->matrix[0] * this->matrix[0] +
                         this->matrix[1] * this->matrix[1]);
     float scaleY = sqrt(this->matrix[4] * this->matrix[4] +
@@ -113,14 +108,13 @@ std::shared_ptr<CIRCLE> Circle::getCIRCLE() {
     auto size = this->transform->size * Point(scaleX, scaleY);
     float centerX = position.x + size.width * 0.5f;
     float centerY = position.y + size.height * 0.5f;
-    return std::shared_ptr<CIRCLE>(new CIRCLE(centerX, centerY, this->getRadius() * fmin(this->getScaleX(), this->getScaleY())));
+    circle = CIRCLE(centerX, centerY, this->getRadius() * fmin(this->getScaleX(), this->getScaleY()));
 }
 
-std::shared_ptr<Collider> Circle::getCollider() {
-    auto collider = std::shared_ptr<Collider>(new Collider(ColliderShape::Circle));
-    collider->aabb = this->getAABB();
-    collider->circle = this->getCIRCLE();
-    return collider;
+void Circle::updateCollider(Collider &collider) {
+    collider.shape = ColliderShape::Circle;
+    this->updateAABB(collider.aabb);
+    this->updateCIRCLE(collider.circle);
 }
 
 std::shared_ptr<Circle> Circle::clone() {
@@ -145,3 +139,7 @@ void Circle::deserializeData(const std::shared_ptr<Dictionary> &dict, const std:
     Entity::deserializeData(dict, params);
     this->radius = this->getPropertyData<Float>(dict, PROP_KEY_RADIUS, params)->getValue();
 }
+
+bool Circle::isInstanceable() {
+    return false;
+}
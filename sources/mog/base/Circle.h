@@ -14,7 +14,6 @@ namespace mog {
         
         float getRadius();
         void setRadius(float radius);
-        virtual std::shared_ptr<Collider> getCollider() override;
         std::shared_ptr<Circle> clone();
         virtual std::shared_ptr<Dictionary> serialize() override;
         
@@ -25,8 +24,10 @@ namespace mog {
         virtual void init() override;
         virtual void bindVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform) override;
         virtual void bindVertexTexCoords(const std::shared_ptr<Renderer> &renderer, int *idx, int texIdx, float x, float y, float w, float h) override;
-        virtual std::shared_ptr<CIRCLE> getCIRCLE();
+        virtual void updateCollider(Collider &collider) override;
+        virtual void updateCIRCLE(CIRCLE &circle);
         virtual std::shared_ptr<Entity> cloneEntity() override;
+        virtual bool isInstanceable() override;
         virtual void deserializeData(const std::shared_ptr<Dictionary> &dict, const std::unordered_map<std::string, std::unordered_map<std::string, std::shared_ptr<Data>>> &params) override;
     };
 }
@@ -1,6 +1,8 @@
 #include "mog/base/Drawable.h"
 #include "mog/base/DrawableContainer.h"
 #include "mog/core/MogStats.h"
+#include "mog/core/TweenManager.h"
+#include "mog/core/Engine.h"
 #include <string.h>
 
 using namespace mog;
@@ -16,16 +18,36 @@ Drawable::~Drawable() {
 }
 
 void Drawable::updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, unsigned char parentDirtyFlag) {
+    if (engine->isInterpolatingFrame()) {
+        this->interpolateFrame(engine->getInterpolationAlpha(), parentMatrix, parentDirtyFlag);
+        return;
+    }
+    if (this->interpolated) {
+        memcpy(this->transform->matrix, this->stepMatrix, sizeof(float) * 16);
+        this->interpolated = false;
+        this->dirtyFlag |= DIRTY_VERTEX;
+    }
+
     this->onUpdate(delta);
     this->updateTween(delta);
     this->renderer->initScreenParameters();
 
     unsigned char mergedDirtyFlag = (this->dirtyFlag | parentDirtyFlag);
     
+    bool interpolation = engine->isInterpolationEnable();
+    this->moving = false;
     if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
+        if (interpolation && this->stepped) {
+            memcpy(this->prevMatrix, this->transform->matrix, sizeof(float) * 16);
+        }
         this->updateTransform();
         this->transform->updateMatrix();
+        if (interpolation && this->stepped && memcmp(this->prevMatrix, this->transform->matrix, sizeof(float) * 16) != 0) {
+            this->moving = true;
+            engine->requestInterpolation();
+        }
     }
+    this->stepped = interpolation;
     if ((this->dirtyFlag & DIRTY_COLOR) == DIRTY_COLOR) {
         this->transform->updateColor();
     }
@@ -40,6 +62,24 @@ void Drawable::updateFrame(const std::shared_ptr<Engine> &engine, float delta, f
     this->dirtyFlag |= parentDirtyFlag;
 }
 
+void Drawable::interpolateFrame(float alpha, float *parentMatrix, unsigned char parentDirtyFlag) {
+    // the local matrix is blended between the last two steps and restored by the next step
+    if (this->moving) {
+        if (!this->interpolated) {
+            memcpy(this->stepMatrix, this->transform->matrix, sizeof(float) * 16);
+            this->interpolated = true;
+        }
+        for (int i = 0; i < 16; i++) {
+            this->transform->matrix[i] = this->prevMatrix[i] + (this->stepMatrix[i] - this->prevMatrix[i]) * alpha;
+        }
+        this->dirtyFlag |= DIRTY_VERTEX;
+    }
+    if (((this->dirtyFlag | parentDirtyFlag) & DIRTY_VERTEX) == DIRTY_VERTEX) {
+        Transform::multiplyMatrix(this->transform->matrix, parentMatrix, this->renderer->matrix);
+    }
+    this->dirtyFlag |= parentDirtyFlag;
+}
+
 void Drawable::drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches) {
     if (!this->active) return;
     if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
@@ -59,6 +99,7 @@ void Drawable::updateTween(float delta) {
             if (this->tweens.count(id) > 0) {
                 this->tweens.erase(id);
             }
+            this->managedTweens.erase(id);
         }
         this->tweenIdsToRemove.clear();
     }
@@ -413,6 +454,10 @@ bool Drawable::isActive() {
     return this->active;
 }
 
+bool Drawable::isDirty() {
+    return ((this->dirtyFlag & DIRTY_ALL) > 0);
+}
+
 /*
 void Drawable::updateMatrix() {
     if (auto g = this->group.lock()) {
@@ -440,16 +485,25 @@ void Drawable::updateMatrix(float *parentMatrix, unsigned char parentDirtyFlag)
 */
 
 void Drawable::runTween(const std::shared_ptr<Tween> &tween) {
-    this->tweens[tween->getTweenId()] = tween;
     tween->addOnFinishEventForParent([this](const std::shared_ptr<Tween> &t) {
         this->tweenIdsToRemove.emplace_back(t->getTweenId());
     });
+    if (tween->getKind() != TweenKind::Custom) {
+        this->managedTweens[tween->getTweenId()] = tween;
+        TweenManager::getInstance()->add(tween, shared_from_this());
+        return;
+    }
+    this->tweens[tween->getTweenId()] = tween;
     tween->init();
     tween->update(0, shared_from_this());
 }
 
 void Drawable::cancelTween(unsigned int tweenId) {
 //    this->tweens.erase(tweenId);
+    auto it = this->managedTweens.find(tweenId);
+    if (it != this->managedTweens.end()) {
+        TweenManager::getInstance()->remove(it->second.get());
+    }
     this->tweenIdsToRemove.emplace_back(tweenId);
 }
 
@@ -457,6 +511,10 @@ void Drawable::cancelAllTweens() {
     for (auto &pair : this->tweens) {
         this->tweenIdsToRemove.emplace_back(pair.first);
     }
+    for (auto &pair : this->managedTweens) {
+        TweenManager::getInstance()->remove(pair.second.get());
+        this->tweenIdsToRemove.emplace_back(pair.first);
+    }
 //    this->tweens.clear();
 }
 
@@ -115,6 +115,7 @@ namespace mog {
         virtual void updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, unsigned char parentDirtyFlag);
         virtual void drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches);
         virtual void updateTween(float delta);
+        virtual bool isDirty();
         std::shared_ptr<Texture2D> getTexture(int textureIdx = 0);
         void setTexture(const std::shared_ptr<Texture2D> &texture, int textureIdx = 0);
 
@@ -123,6 +124,7 @@ namespace mog {
         virtual void bindVertex();
         virtual void onUpdate(float delta) {};
         virtual void getMatrix(float *matrix, Drawable *target);
+        void interpolateFrame(float alpha, float *parentMatrix, unsigned char parentDirtyFlag);
 
         std::shared_ptr<Renderer> renderer = nullptr;
         std::shared_ptr<Transform> transform = nullptr;
@@ -139,7 +141,15 @@ namespace mog {
         std::shared_ptr<Data> param;
         bool active = true;
         std::unordered_map<unsigned int, std::shared_ptr<Tween>> tweens;
+        std::unordered_map<unsigned int, std::shared_ptr<Tween>> managedTweens;
         std::vector<unsigned int> tweenIdsToRemove;
+
+        // local matrices of the last two fixed steps, for render interpolation
+        float prevMatrix[16];
+        float stepMatrix[16];
+        bool stepped = false;
+        bool moving = false;
+        bool interpolated = false;
         
         void init();
     };
@@ -25,11 +25,17 @@ void DrawableGroup::init() {
 void DrawableGroup::updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, unsigned char parentDirtyFlag) {
     this->drawableContainer->sortChildDrawablesToDraw();
     Drawable::updateFrame(engine, delta, parentMatrix, parentDirtyFlag);
+    this->dirtyChildren = false;
     for (const auto &drawable : this->drawableContainer->sortedChildDrawables) {
         drawable->updateFrame(engine, delta, this->renderer->matrix, this->dirtyFlag);
+        if (drawable->isDirty()) this->dirtyChildren = true;
     }
 }
 
+bool DrawableGroup::isDirty() {
+    return (Drawable::isDirty() || this->dirtyChildren);
+}
+
 void DrawableGroup::drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches) {
     if (!this->active) return;
     
@@ -13,7 +13,7 @@ void Entity::updateFrame(const std::shared_ptr<Engine> &engine, float delta, flo
     Drawable::updateFrame(engine, delta, parentRendererMatrix, parentDirtyFlag);
     if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
         Transform::multiplyMatrix(this->transform->matrix, parentMatrix, this->matrix);
-        this->collider = nullptr;
+        this->colliderDirty = true;
     }
     if ((this->dirtyFlag & DIRTY_COLOR) == DIRTY_COLOR) {
         Transform::multiplyColor(this->transform->matrix, parentMatrix, this->matrix);
@@ -22,14 +22,14 @@ void Entity::updateFrame(const std::shared_ptr<Engine> &engine, float delta, flo
 }
 
 void Entity::extractEvent(const std::shared_ptr<Engine> &engine, float delta) {
-    if (!this->active) return;
-    auto self = std::static_pointer_cast<Entity>(shared_from_this());
+    if (!this->active || !engine->isTouchTracking()) return;
     if (this->touchEnable && (this->swallowTouches || this->touchListeners.size() > 0)) {
-        engine->pushTouchableEntity(self);
+        engine->pushTouchableEntity(this);
     }
 }
 
 void Entity::initRendererVertices(int verticesNum, int indicesNum) {
+    this->renderer->setDrawType(DrawType::Triangles);
     this->renderer->setVerticesNum(verticesNum);
     this->renderer->setIndicesNum(indicesNum);
     this->renderer->newVerticesArr();
@@ -65,10 +65,14 @@ void Entity::bindVertex() {
 }
 
 void Entity::bindVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform) {
-    Point p1 = Point(0, 0);
-    Point p2 = Point(0, this->transform->size.height);
-    Point p3 = Point(this->transform->size.width, 0);
-    Point p4 = p2 + p3;
+    this->bindQuadVertices(renderer, verticesIdx, indicesIdx, bakeTransform, 0, 0, this->transform->size.width, this->transform->size.height);
+}
+
+void Entity::bindQuadVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform, float x, float y, float w, float h) {
+    Point p1 = Point(x, y);
+    Point p2 = Point(x, y + h);
+    Point p3 = Point(x + w, y);
+    Point p4 = Point(x + w, y + h);
     
     if (bakeTransform) {
         auto offset = Point(this->renderer->matrix[12], this->renderer->matrix[13]);
@@ -94,16 +98,34 @@ void Entity::bindVertices(const std::shared_ptr<Renderer> &renderer, int *vertic
     renderer->vertices[(*verticesIdx)++] = p4.x;  renderer->vertices[(*verticesIdx)++] = p4.y;
     
     if (indicesIdx) {
-        int startI = *indicesIdx;
-        if (startI > 0) {
-            renderer->indices[*indicesIdx] = renderer->indices[(*indicesIdx) - 1];
-            (*indicesIdx)++;
-            renderer->indices[(*indicesIdx)++] = startN;
-        }
-        renderer->indices[(*indicesIdx)++] = 0 + startN;
-        renderer->indices[(*indicesIdx)++] = 1 + startN;
-        renderer->indices[(*indicesIdx)++] = 2 + startN;
-        renderer->indices[(*indicesIdx)++] = 3 + startN;
+        short quadIndices[6] = {0, 1, 2, 2, 1, 3};
+        this->bindIndices(renderer, indicesIdx, startN, quadIndices, 6);
+    }
+}
+
+void Entity::bindInstance(const std::shared_ptr<Renderer> &renderer, int instanceIdx) {
+    auto &instance = renderer->instances[instanceIdx];
+    float w = this->transform->size.width;
+    float h = this->transform->size.height;
+    if (!this->active) {
+        w = 0;
+        h = 0;
+    }
+    instance.transform[0] = this->renderer->matrix[0] * w;
+    instance.transform[1] = this->renderer->matrix[1] * w;
+    instance.transform[2] = this->renderer->matrix[4] * h;
+    instance.transform[3] = this->renderer->matrix[5] * h;
+    instance.translate[0] = this->renderer->matrix[12];
+    instance.translate[1] = this->renderer->matrix[13];
+    for (int i = 0; i < 4; i++) {
+        float c = fmax(0.0f, fmin(1.0f, this->renderer->matrix[16 + i]));
+        instance.color[i] = (unsigned char)(c * 255.0f + 0.5f);
+    }
+}
+
+void Entity::bindIndices(const std::shared_ptr<Renderer> &renderer, int *indicesIdx, int startN, const short *indices, int indicesNum) {
+    for (int i = 0; i < indicesNum; i++) {
+        renderer->indices[(*indicesIdx)++] = indices[i] + startN;
     }
 }
 
@@ -147,19 +169,27 @@ void Entity::updateMatrix(float *parentMatrix, unsigned char parentDirtyFlag) {
 }
 */
 
-std::string Entity::getName() {
+const std::string &Entity::getName() {
+    return this->name.str();
+}
+
+const Symbol &Entity::getNameSymbol() {
     return this->name;
 }
 
-void Entity::setName(std::string name) {
+void Entity::setName(const Symbol &name) {
     this->name = name;
 }
 
-std::string Entity::getTag() {
+const std::string &Entity::getTag() {
+    return this->tag.str();
+}
+
+const Symbol &Entity::getTagSymbol() {
     return this->tag;
 }
 
-void Entity::setTag(std::string tag) {
+void Entity::setTag(const Symbol &tag) {
     this->tag = tag;
 }
 
@@ -271,15 +301,26 @@ float *Entity::getMatrix() {
     return this->matrix;
 }
 
-std::shared_ptr<Collider> Entity::getCollider() {
-    if (this->collider) return this->collider;
-    this->collider = std::shared_ptr<Collider>(new Collider(ColliderShape::Rect));
-    this->collider->aabb = this->getAABB();
-    this->collider->obb = this->getOBB();
+const Collider &Entity::getCollider() {
+    if (this->colliderDirty) {
+        this->updateCollider(this->collider);
+        this->colliderDirty = false;
+        this->colliderVersion++;
+    }
     return this->collider;
 }
 
-std::shared_ptr<OBB> Entity::getOBB() {
+unsigned int Entity::getColliderVersion() {
+    return this->colliderVersion;
+}
+
+void Entity::updateCollider(Collider &collider) {
+    collider.shape = ColliderShape::Rect;
+    this->updateAABB(collider.aabb);
+    this->updateOBB(collider.obb);
+}
+
+void Entity::updateOBB(OBB &obb) {
     float scaleX = sqrt(this->matrix[0] * this->matrix[0] +
                         this->matrix[1] * this->matrix[1]);
     float scaleY = sqrt(this->matrix[4] * this->matrix[4] +
@@ -294,10 +335,10 @@ std::shared_ptr<OBB> Entity::getOBB() {
     float centerX = x + vec3.x;
     float centerY = y + vec3.y;
     
-    return std::shared_ptr<OBB>(new OBB(vec1, vec2, centerX, centerY));
+    obb = OBB(vec1, vec2, centerX, centerY);
 }
 
-std::shared_ptr<AABB> Entity::getAABB() {
+void Entity::updateAABB(AABB &aabb) {
     auto v1 = Point(this->matrix[0], this->matrix[1]);
     auto v2 = Point(this->matrix[4], this->matrix[5]);
     auto offset = Point(this->matrix[12], this->matrix[13]);
@@ -309,11 +350,11 @@ std::shared_ptr<AABB> Entity::getAABB() {
     Point minP = Point(fmin(fmin(p1.x, p2.x), fmin(p3.x, p4.x)), fmin(fmin(p1.y, p2.y), fmin(p3.y, p4.y)));
     Point maxP = Point(fmax(fmax(p1.x, p2.x), fmax(p3.x, p4.x)), fmax(fmax(p1.y, p2.y), fmax(p3.y, p4.y)));
     
-    return std::shared_ptr<AABB>(new AABB(offset.x + minP.x, offset.y + minP.y, offset.x + maxP.x, offset.y + maxP.y));
+    aabb = AABB(offset.x + minP.x, offset.y + minP.y, offset.x + maxP.x, offset.y + maxP.y);
 }
 
 void Entity::copyProperties(const std::shared_ptr<Entity> &entity) {
-    this->setTag(entity->getTag());
+    this->setTag(entity->getTagSymbol());
     this->setPivot(entity->getPivot());
     this->setPosition(entity->getPosition());
     this->setSize(entity->getSize());
@@ -330,8 +371,8 @@ void Entity::copyProperties(const std::shared_ptr<Entity> &entity) {
 std::shared_ptr<Dictionary> Entity::serialize() {
     auto dict = Dictionary::create();
     dict->put(PROP_KEY_ACTIVE, Bool::create(this->active));
-    dict->put(PROP_KEY_NAME, String::create(this->name));
-    dict->put(PROP_KEY_TAG, String::create(this->tag));
+    dict->put(PROP_KEY_NAME, String::create(this->name.str()));
+    dict->put(PROP_KEY_TAG, String::create(this->tag.str()));
     dict->put(PROP_KEY_POSITION_X, Float::create(this->transform->position.x));
     dict->put(PROP_KEY_POSITION_Y, Float::create(this->transform->position.y));
     dict->put(PROP_KEY_PIVOT_X, Float::create(this->transform->pivot.x));
@@ -372,3 +413,7 @@ void Entity::deserializeData(const std::shared_ptr<Dictionary> &dict, const std:
 bool Entity::isGroup() {
     return false;
 }
+
+bool Entity::isInstanceable() {
+    return false;
+}
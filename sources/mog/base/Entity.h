@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include "mog/base/Drawable.h"
 #include "mog/core/Collision.h"
+#include "mog/core/Symbol.h"
 
 extern void *enabler;
 
@@ -34,10 +35,12 @@ namespace mog {
         friend class Group;
         friend class EntityCreator;
     public:
-        std::string getName();
-        void setName(std::string name);
-        std::string getTag();
-        void setTag(std::string tag);
+        const std::string &getName();
+        const Symbol &getNameSymbol();
+        void setName(const Symbol &name);
+        const std::string &getTag();
+        const Symbol &getTagSymbol();
+        void setTag(const Symbol &tag);
         std::shared_ptr<Group> getGroup();
         virtual Point getAbsolutePosition();
         virtual Size getAbsoluteSize();
@@ -57,7 +60,8 @@ namespace mog {
         void setTouchEnable(bool enable);
         bool isTouchEnable();
         virtual float *getMatrix() override;
-        virtual std::shared_ptr<Collider> getCollider();
+        const Collider &getCollider();
+        unsigned int getColliderVersion();
         virtual std::shared_ptr<Dictionary> serialize();
         
         virtual void updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, unsigned char parentDirtyFlag) override;
@@ -77,14 +81,21 @@ namespace mog {
         virtual std::shared_ptr<Entity> cloneEntity() = 0;
         virtual void deserializeData(const std::shared_ptr<Dictionary> &dict, const std::unordered_map<std::string, std::unordered_map<std::string, std::shared_ptr<Data>>> &params);
         virtual bool isGroup();
+        virtual bool isInstanceable();
+        virtual void bindInstance(const std::shared_ptr<Renderer> &renderer, int instanceIdx);
         void initRendererVertices(int verticesNum, int indicesNum);
+        void bindIndices(const std::shared_ptr<Renderer> &renderer, int *indicesIdx, int startN, const short *indices, int indicesNum);
+        void bindQuadVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform, float x, float y, float w, float h);
 
-        virtual std::shared_ptr<OBB> getOBB();
-        virtual std::shared_ptr<AABB> getAABB();
+        virtual void updateCollider(Collider &collider);
+        virtual void updateOBB(OBB &obb);
+        virtual void updateAABB(AABB &aabb);
 
-        std::string name;
-        std::string tag;
-        std::shared_ptr<Collider> collider = nullptr;
+        Symbol name;
+        Symbol tag;
+        Collider collider;
+        bool colliderDirty = true;
+        unsigned int colliderVersion = 0;
         unsigned int eventIdCounter = 0;
         bool touchEnable = true;
         bool swallowTouches = false;
@@ -99,12 +110,11 @@ namespace mog {
 
         template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
         std::shared_ptr<T> getPropertyData(const std::shared_ptr<Dictionary> &dict, std::string propKey, const std::unordered_map<std::string, std::unordered_map<std::string, std::shared_ptr<Data>>> &params) {
-            std::unordered_map<std::string, std::shared_ptr<Data>> paramMap;
-            if (params.count(this->name) > 0) {
-                paramMap = params.at(this->name);
-                if (paramMap.count(propKey) > 0) {
-                    auto data = paramMap.at(propKey);
-                    return data->cast<T>();
+            auto it = params.find(this->name.str());
+            if (it != params.end()) {
+                auto paramIt = it->second.find(propKey);
+                if (paramIt != it->second.end()) {
+                    return paramIt->second->cast<T>();
                 }
             }
             
@@ -5,6 +5,7 @@
 #include "mog/core/Engine.h"
 #include "mog/core/EntityCreator.h"
 #include <algorithm>
+#include <math.h>
 
 #define VERTICES_IDX 0
 #define INDICES_IDX 1
@@ -21,6 +22,7 @@ std::shared_ptr<Group> Group::create(bool enableBatching) {
 }
 
 Group::Group() {
+    this->renderer->setDrawType(DrawType::Triangles);
     this->drawableContainer = std::make_shared<DrawableContainer>();
     this->drawableContainer->addChildListener = [this](const std::shared_ptr<Drawable> &drawable) {
         auto e = std::static_pointer_cast<Entity>(drawable);
@@ -45,6 +47,19 @@ bool Group::isEnableBatching() {
     return this->enableBatching;
 }
 
+void Group::setCacheAsTexture(bool cacheAsTexture) {
+    this->cacheAsTexture = cacheAsTexture;
+    if (!cacheAsTexture) {
+        this->cacheTexture = nullptr;
+        this->cacheRenderer = nullptr;
+    }
+    this->dirtyFlag = DIRTY_ALL;
+}
+
+bool Group::isCacheAsTexture() {
+    return this->cacheAsTexture;
+}
+
 /*
 void Group::updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, unsigned char parentDirtyFlag) {
     this->drawableContainer->sortChildDrawablesToDraw();
@@ -90,21 +105,53 @@ void Group::updateFrame(const std::shared_ptr<Engine> &engine, float delta, floa
     Entity::updateFrame(engine, delta, parentMatrix, parentRendererMatrix, (parentDirtyFlag & ~IN_BATCHING));
     int verticesNum = 0;
     int indicesNum = 0;
+    this->instanceable = true;
+    this->instancesNum = 0;
 
     float *rendererMatrix = this->renderer->matrix;
     unsigned char dirtyFlag = (parentDirtyFlag | this->dirtyFlag);
-    if (this->enableBatching && (parentDirtyFlag & IN_BATCHING) == 0) {
+    bool batchingRoot = (this->enableBatching && (parentDirtyFlag & IN_BATCHING) == 0);
+    bool caching = (this->cacheAsTexture && (parentDirtyFlag & IN_BATCHING) == 0);
+    if (this->caching != caching) {
+        this->caching = caching;
+        this->cacheDirty = true;
+    }
+    if (batchingRoot) {
         rendererMatrix = Renderer::identityMatrix;
         dirtyFlag |= IN_BATCHING;
+    } else if (caching) {
+        rendererMatrix = Renderer::identityMatrix;
+    }
+    
+    // a cached subtree is rendered in local space, so moving the group does not invalidate it
+    unsigned char cachedDirtyFlag = 0;
+    if (caching && !this->cacheDirty && (dirtyFlag & (DIRTY_SIZE | DIRTY_ANCHOR)) == 0) {
+        cachedDirtyFlag = (dirtyFlag & (DIRTY_VERTEX | DIRTY_COLOR));
+        dirtyFlag &= ~(DIRTY_VERTEX | DIRTY_COLOR);
     }
     for (const auto &drawable : this->drawableContainer->sortedChildDrawables) {
         auto entity = std::static_pointer_cast<Entity>(drawable);
         this->updateFrameForChild(engine, delta, entity, this->matrix, rendererMatrix, dirtyFlag);
         
         verticesNum += entity->renderer->verticesNum;
-        if (indicesNum > 0) indicesNum += 2;
         indicesNum += entity->renderer->indicesNum;
     }
+    if (cachedDirtyFlag > 0) {
+        this->updateChildMatrices(cachedDirtyFlag);
+    }
+    
+    int instancesNum = 0;
+    if (batchingRoot && this->instanceable && this->instancesNum > 0 && Renderer::isInstancingSupported()) {
+        instancesNum = this->instancesNum;
+        verticesNum = 4;
+        indicesNum = 6;
+    }
+    if (this->renderer->setInstancesNum(instancesNum)) {
+        if (instancesNum > 0) {
+            this->renderer->newInstancesArr();
+        }
+        this->dirtyFlag |= DIRTY_ALL;
+    }
     if (this->renderer->setVerticesNum(verticesNum)) {
         this->renderer->newVerticesArr();
         this->renderer->newVertexColorsArr();
@@ -124,21 +171,64 @@ void Group::updateFrameForChild(const std::shared_ptr<Engine> &engine, float del
         auto g = std::static_pointer_cast<Group>(entity);
         if (g->enableTexture) this->enableTexture = true;
         this->dirtyFlagChildren |= (entity->dirtyFlag | g->dirtyFlagChildren);
+        this->instanceable = (this->instanceable && g->instanceable);
+        this->instancesNum += g->instancesNum;
     } else {
         if (entity->textures[0]) this->enableTexture = true;
         this->dirtyFlagChildren |= entity->dirtyFlag;
+        this->instanceable = (this->instanceable && entity->isInstanceable());
+        this->instancesNum++;
+    }
+}
+
+bool Group::isDirty() {
+    return (Entity::isDirty() || (this->dirtyFlagChildren & DIRTY_ALL) > 0);
+}
+
+void Group::updateChildMatrices(unsigned char dirtyFlag) {
+    for (const auto &drawable : this->drawableContainer->sortedChildDrawables) {
+        auto entity = std::static_pointer_cast<Entity>(drawable);
+        if ((dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
+            Transform::multiplyMatrix(entity->transform->matrix, this->matrix, entity->matrix);
+            entity->colliderDirty = true;
+        }
+        if ((dirtyFlag & DIRTY_COLOR) == DIRTY_COLOR) {
+            Transform::multiplyColor(entity->transform->matrix, this->matrix, entity->matrix);
+        }
+        if (entity->isGroup()) {
+            std::static_pointer_cast<Group>(entity)->updateChildMatrices(dirtyFlag);
+        }
     }
 }
 
 void Group::drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches) {
     if (!this->active) return;
     
+    if (this->caching) {
+        if (this->cacheDirty || (this->dirtyFlagChildren & DIRTY_RENDERER_ALL) > 0 ||
+            !this->cacheTexture || this->cacheTexture->textureId == 0 ||
+            this->cacheScreenScale != Screen::getScreenScale()) {
+            this->renderCache(delta, touches);
+        }
+        this->drawCache();
+    } else {
+        this->drawChildren(delta, touches);
+    }
+    if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
+        this->colliderDirty = true;
+    }
+    this->dirtyFlag = 0;
+    this->dirtyFlagChildren = 0;
+}
+
+void Group::drawChildren(float delta, const std::map<unsigned int, TouchInput> &touches) {
     if (this->enableBatching) {
+        float *matrix = this->caching ? Renderer::identityMatrix : this->renderer->matrix;
         if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
-            this->renderer->getShader()->setUniformMatrix(this->renderer->matrix);
+            this->renderer->getShader()->setUniformMatrix(matrix);
         }
         if ((this->dirtyFlag & DIRTY_COLOR) == DIRTY_COLOR) {
-            this->renderer->getShader()->setUniformColor(this->renderer->matrix[16], this->renderer->matrix[17], this->renderer->matrix[18], this->renderer->matrix[19]);
+            this->renderer->getShader()->setUniformColor(matrix[16], matrix[17], matrix[18], matrix[19]);
         }
         if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
             this->bindVertex();
@@ -160,11 +250,137 @@ void Group::drawFrame(float delta, const std::map<unsigned int, TouchInput> &tou
             entity->drawFrame(delta, touches);
         }
     }
-    if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
-        this->collider = nullptr;
+}
+
+void Group::renderCache(float delta, const std::map<unsigned int, TouchInput> &touches) {
+    float bounds[4];
+    if (!this->getChildBounds(bounds)) {
+        this->cacheBounds = Rect::zero;
+        this->cacheDirty = false;
+        return;
     }
-    this->dirtyFlag = 0;
-    this->dirtyFlagChildren = 0;
+    
+    // align the cache origin to the pixel grid so that the cached image is not resampled
+    float scale = Screen::getScreenScale();
+    float x = floor(bounds[0] * scale) / scale;
+    float y = floor(bounds[1] * scale) / scale;
+    int width = (int)ceil((bounds[2] - x) * scale);
+    int height = (int)ceil((bounds[3] - y) * scale);
+    if (width <= 0 || height <= 0) {
+        this->cacheBounds = Rect::zero;
+        this->cacheDirty = false;
+        return;
+    }
+    if (!this->cacheTexture || this->cacheTexture->width != width || this->cacheTexture->height != height) {
+        this->cacheTexture = Texture2D::createWithFramebuffer(width, height, Screen::getDensity());
+    }
+    
+    GLint prevFramebuffer = 0;
+    GLint prevViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    
+    // children are drawn with the screen projection, so shift the viewport to move the cache origin to the top left
+    Size screenSize = Screen::getSize();
+    this->cacheTexture->bindFramebuffer();
+    glViewport((GLint)round(-x * scale), (GLint)round(height - (screenSize.height - y) * scale),
+               (GLsizei)round(screenSize.width * scale), (GLsizei)round(screenSize.height * scale));
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    
+    // the cache holds premultiplied colors, so that alpha is not applied twice when the quad is drawn
+    bool prevPremultiplied = Renderer::premultipliedTarget;
+    Renderer::premultipliedTarget = true;
+    this->drawChildren(delta, touches);
+    Renderer::premultipliedTarget = prevPremultiplied;
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFramebuffer);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    
+    this->cacheBounds = Rect(x, y, width / scale, height / scale);
+    this->cacheScreenScale = scale;
+    this->cacheDirty = false;
+    this->cacheVerticesDirty = true;
+}
+
+void Group::drawCache() {
+    if (this->cacheBounds.size == Size::zero || !this->cacheTexture) return;
+    
+    if (!this->cacheRenderer) {
+        this->cacheRenderer = Renderer::create();
+        this->cacheRenderer->setDrawType(DrawType::Triangles);
+        this->cacheRenderer->setVerticesNum(4);
+        this->cacheRenderer->setIndicesNum(6);
+        this->cacheRenderer->newVerticesArr();
+        this->cacheRenderer->newIndicesArr();
+        this->cacheRenderer->newVertexTexCoordsArr();
+        this->cacheRenderer->setBlendFunc(BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+        this->cacheVerticesDirty = true;
+    }
+    this->cacheRenderer->initScreenParameters();
+    
+    if (this->cacheVerticesDirty) {
+        float x = this->cacheBounds.position.x;
+        float y = this->cacheBounds.position.y;
+        float w = this->cacheBounds.size.width;
+        float h = this->cacheBounds.size.height;
+        float vertices[8] = {x, y, x, y + h, x + w, y, x + w, y + h};
+        float texCoords[8] = {0, 1.0f, 0, 0, 1.0f, 1.0f, 1.0f, 0};
+        short indices[6] = {0, 1, 2, 2, 1, 3};
+        memcpy(this->cacheRenderer->vertices, vertices, sizeof(float) * 8);
+        memcpy(this->cacheRenderer->vertexTexCoords[0], texCoords, sizeof(float) * 8);
+        memcpy(this->cacheRenderer->indices, indices, sizeof(short) * 6);
+        this->cacheRenderer->bindVertex();
+        this->cacheRenderer->bindVertexTexCoords();
+        this->cacheRenderer->bindTexture(this->cacheTexture);
+    }
+    if (this->cacheVerticesDirty || (this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
+        this->cacheRenderer->getShader()->setUniformMatrix(this->renderer->matrix);
+    }
+    if (this->cacheVerticesDirty || (this->dirtyFlag & DIRTY_COLOR) == DIRTY_COLOR) {
+        float a = this->renderer->matrix[19];
+        this->cacheRenderer->getShader()->setUniformColor(this->renderer->matrix[16] * a, this->renderer->matrix[17] * a, this->renderer->matrix[18] * a, a);
+    }
+    this->cacheVerticesDirty = false;
+    
+    this->cacheRenderer->drawFrame();
+}
+
+bool Group::getChildBounds(float *bounds) {
+    bool found = false;
+    for (const auto &drawable : this->drawableContainer->sortedChildDrawables) {
+        auto entity = std::static_pointer_cast<Entity>(drawable);
+        if (!entity->active) continue;
+        
+        float childBounds[4];
+        if (entity->isGroup()) {
+            if (!std::static_pointer_cast<Group>(entity)->getChildBounds(childBounds)) continue;
+        } else {
+            float *m = entity->renderer->matrix;
+            float w = entity->transform->size.width;
+            float h = entity->transform->size.height;
+            float xs[4] = {0, w, 0, w};
+            float ys[4] = {0, 0, h, h};
+            for (int i = 0; i < 4; i++) {
+                float x = m[0] * xs[i] + m[4] * ys[i] + m[12];
+                float y = m[1] * xs[i] + m[5] * ys[i] + m[13];
+                childBounds[0] = (i == 0) ? x : fmin(childBounds[0], x);
+                childBounds[1] = (i == 0) ? y : fmin(childBounds[1], y);
+                childBounds[2] = (i == 0) ? x : fmax(childBounds[2], x);
+                childBounds[3] = (i == 0) ? y : fmax(childBounds[3], y);
+            }
+        }
+        if (!found) {
+            memcpy(bounds, childBounds, sizeof(float) * 4);
+            found = true;
+        } else {
+            bounds[0] = fmin(bounds[0], childBounds[0]);
+            bounds[1] = fmin(bounds[1], childBounds[1]);
+            bounds[2] = fmax(bounds[2], childBounds[2]);
+            bounds[3] = fmax(bounds[3], childBounds[3]);
+        }
+    }
+    return found;
 }
 
 /*
@@ -191,6 +407,21 @@ void Group::bindVertex() {
         this->textureAtlas->bindTexture();
     }
 
+    if (this->renderer->instancesNum > 0) {
+        int instanceIdx = 0;
+        if (this->enableTexture && this->renderer->vertexTexCoords[0] == nullptr) {
+            this->renderer->newVertexTexCoordsArr();
+        }
+        this->bindInstanceVertices();
+        this->bindInstancesRecursive(this->renderer, this->textureAtlas, &instanceIdx, false);
+        this->renderer->bindVertex();
+        this->renderer->bindInstances(true);
+        if (this->enableTexture) {
+            this->renderer->bindTexture(this->textures[0]);
+        }
+        return;
+    }
+
     this->bindVertexRecursive(this->renderer, this->textureAtlas, vertexIndices);
     this->renderer->bindVertex(true);
     this->renderer->bindVertexColors(true);
@@ -233,6 +464,12 @@ void Group::bindVertexRecursive(const std::shared_ptr<Renderer> &renderer, std::
 }
 
 void Group::bindVertexSub() {
+    if (this->renderer->instancesNum > 0) {
+        int instanceIdx = 0;
+        this->bindInstancesRecursive(this->renderer, this->textureAtlas, &instanceIdx, true);
+        this->renderer->bindInstancesSub(0, this->renderer->instancesNum);
+        return;
+    }
     int vertexIndices[4] = {0, 0, 0, 0};
     this->bindVertexSubRecursive(this->renderer, this->textureAtlas, vertexIndices);
 }
@@ -281,6 +518,62 @@ void Group::bindVertexSubRecursive(const std::shared_ptr<Renderer> &renderer, st
     }
 }
 
+void Group::bindInstanceVertices() {
+    float quadVertices[8] = {0, 0, 0, 1, 1, 0, 1, 1};
+    short quadIndices[6] = {0, 1, 2, 2, 1, 3};
+    for (int i = 0; i < 8; i++) {
+        this->renderer->vertices[i] = quadVertices[i];
+    }
+    for (int i = 0; i < 6; i++) {
+        this->renderer->indices[i] = quadIndices[i];
+    }
+}
+
+void Group::bindInstancesRecursive(const std::shared_ptr<Renderer> &renderer, std::shared_ptr<TextureAtlas> &textureAtlas, int *instanceIdx, bool dirtyOnly) {
+    for (const auto &drawable : this->drawableContainer->sortedChildDrawables) {
+        auto entity = std::static_pointer_cast<Entity>(drawable);
+        
+        if (entity->isGroup()) {
+            auto g = std::static_pointer_cast<Group>(entity);
+            g->bindInstancesRecursive(renderer, textureAtlas, instanceIdx, dirtyOnly);
+            
+        } else {
+            if (!dirtyOnly || (entity->dirtyFlag & DIRTY_RENDERER_ALL) > 0) {
+                entity->bindInstance(renderer, *instanceIdx);
+                float *uvRect = renderer->instances[*instanceIdx].uvRect;
+                if (this->enableTexture && entity->textures[0]) {
+                    std::shared_ptr<TextureAtlasCell> cell = textureAtlas->getCell(entity->textures[0]);
+                    float x = 0;
+                    float y = 0;
+                    float w = 0;
+                    float h = 0;
+                    if (cell) {
+                        x = (float)cell->x / (float)textureAtlas->width;
+                        y = (float)cell->y / (float)textureAtlas->height;
+                        w = (float)cell->width / (float)textureAtlas->width;
+                        h = (float)cell->height / (float)textureAtlas->height;
+                    }
+                    // the quad's texture coordinates are resolved into the first 4 slots and reduced to a rect
+                    int idx = 0;
+                    entity->bindVertexTexCoords(renderer, &idx, 0, x, y, w, h);
+                    float *texCoords = renderer->vertexTexCoords[0];
+                    uvRect[0] = texCoords[0];
+                    uvRect[1] = texCoords[1];
+                    uvRect[2] = texCoords[6] - texCoords[0];
+                    uvRect[3] = texCoords[7] - texCoords[1];
+                } else {
+                    uvRect[0] = -1.0f;
+                    uvRect[1] = -1.0f;
+                    uvRect[2] = 0;
+                    uvRect[3] = 0;
+                }
+            }
+            (*instanceIdx)++;
+        }
+        entity->dirtyFlag = 0;
+    }
+}
+
 void Group::add(const std::shared_ptr<Entity> &entity) {
     this->drawableContainer->addChild(entity);
     this->dirtyFlag |= DIRTY_ALL;
@@ -315,10 +608,10 @@ std::vector<std::shared_ptr<Entity>> Group::getChildEntities() {
     return entities;
 }
 
-std::shared_ptr<Entity> Group::findChildByName(std::string name, bool recursive) {
+std::shared_ptr<Entity> Group::findChildByName(const Symbol &name, bool recursive) {
     for (const auto &drawable : this->drawableContainer->childDrawables) {
         auto entity = std::static_pointer_cast<Entity>(drawable);
-        if (entity->getName() == name) return entity;
+        if (entity->name == name) return entity;
         if (!recursive) continue;
         
         if (entity->isGroup()) {
@@ -331,10 +624,10 @@ std::shared_ptr<Entity> Group::findChildByName(std::string name, bool recursive)
     return nullptr;
 }
 
-std::shared_ptr<Entity> Group::findFirstChildByTag(std::string tag, bool recursive) {
+std::shared_ptr<Entity> Group::findFirstChildByTag(const Symbol &tag, bool recursive) {
     for (const auto &drawable : this->drawableContainer->childDrawables) {
         auto entity = std::static_pointer_cast<Entity>(drawable);
-        if (entity->getTag() == tag) return entity;
+        if (entity->tag == tag) return entity;
         if (!recursive) continue;
         
         if (entity->isGroup()) {
@@ -347,11 +640,11 @@ std::shared_ptr<Entity> Group::findFirstChildByTag(std::string tag, bool recursi
     return nullptr;
 }
 
-std::vector<std::shared_ptr<Entity>> Group::findChildrenByTag(std::string tag, bool recursive) {
+std::vector<std::shared_ptr<Entity>> Group::findChildrenByTag(const Symbol &tag, bool recursive) {
     std::vector<std::shared_ptr<Entity>> vec;
     for (const auto &drawable : this->drawableContainer->childDrawables) {
         auto entity = std::static_pointer_cast<Entity>(drawable);
-        if (entity->getTag() == tag) {
+        if (entity->tag == tag) {
             vec.emplace_back(entity);
         };
         if (!recursive) continue;
@@ -21,6 +21,8 @@ namespace mog {
 
         void setEnableBatching(bool enableBatching);
         bool isEnableBatching();
+        void setCacheAsTexture(bool cacheAsTexture);
+        bool isCacheAsTexture();
 
         virtual void add(const std::shared_ptr<Entity> &entity);
         virtual void insertBefore(const std::shared_ptr<Entity> &entity, const std::shared_ptr<Entity> &baseEntity);
@@ -28,15 +30,16 @@ namespace mog {
         virtual void remove(const std::shared_ptr<Entity> &entity);
         virtual void removeAll();
         std::vector<std::shared_ptr<Entity>> getChildEntities();
-        std::shared_ptr<Entity> findChildByName(std::string name, bool recursive = true);
-        std::shared_ptr<Entity> findFirstChildByTag(std::string tag, bool recursive = true);
-        std::vector<std::shared_ptr<Entity>> findChildrenByTag(std::string tag, bool recursive = true);
+        std::shared_ptr<Entity> findChildByName(const Symbol &name, bool recursive = true);
+        std::shared_ptr<Entity> findFirstChildByTag(const Symbol &tag, bool recursive = true);
+        std::vector<std::shared_ptr<Entity>> findChildrenByTag(const Symbol &tag, bool recursive = true);
         std::shared_ptr<Group> clone();
 
 //        virtual void updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, unsigned char parentDirtyFlag = 0) override;
         virtual void updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, float *parentRendererMatrix, unsigned char parentDirtyFlag) override;
         virtual void updateFrameForChild(const std::shared_ptr<Engine> &engine, float delta, const std::shared_ptr<Entity> &entity, float *parentMatrix, float *parentRendererMatrix, unsigned char parentDirtyFlag);
         virtual void drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches) override;
+        virtual bool isDirty() override;
 //        virtual void updateMatrix(float *parentMatrix, unsigned char parentDirtyFlag) override;
 
         virtual std::shared_ptr<Dictionary> serialize() override;
@@ -45,9 +48,19 @@ namespace mog {
         std::shared_ptr<DrawableContainer> drawableContainer;
         bool enableBatching = false;
         bool enableTexture = false;
+        bool instanceable = true;
+        int instancesNum = 0;
         unsigned char dirtyFlagChildren = 0;
         std::unordered_map<unsigned long, std::shared_ptr<TextureAtlasCell>> cellMap;
         std::shared_ptr<TextureAtlas> textureAtlas;
+        bool cacheAsTexture = false;
+        bool caching = false;
+        bool cacheDirty = true;
+        bool cacheVerticesDirty = true;
+        float cacheScreenScale = 0;
+        Rect cacheBounds = Rect::zero;
+        std::shared_ptr<Texture2D> cacheTexture;
+        std::shared_ptr<Renderer> cacheRenderer;
 
         Group();
         virtual void init() override;
@@ -61,9 +74,17 @@ namespace mog {
         
         void bindVertexRecursive(const std::shared_ptr<Renderer> &renderer, std::shared_ptr<TextureAtlas> &textureAtlas, int *vertexIndices);
         void bindVertexSubRecursive(const std::shared_ptr<Renderer> &renderer, std::shared_ptr<TextureAtlas> &textureAtlas, int *vertexIndices);
+        void bindInstancesRecursive(const std::shared_ptr<Renderer> &renderer, std::shared_ptr<TextureAtlas> &textureAtlas, int *instanceIdx, bool dirtyOnly);
+        void bindInstanceVertices();
 //        virtual void multiplyChildEntityMatrix(const std::shared_ptr<Entity> &entity, float *parentMatrix);
 
         virtual void addTextureTo(const std::shared_ptr<TextureAtlas> &textureAtlas);
+
+        void drawChildren(float delta, const std::map<unsigned int, TouchInput> &touches);
+        void renderCache(float delta, const std::map<unsigned int, TouchInput> &touches);
+        void drawCache();
+        bool getChildBounds(float *bounds);
+        void updateChildMatrices(unsigned char dirtyFlag);
     };
 }
 
@@ -35,7 +35,7 @@ void Label::init() {
     this->size.width = this->textures[0]->width / this->textures[0]->density.value;
     this->size.height = this->textures[0]->height / this->textures[0]->density.value;
 
-    this->initRendererVertices(4, 4);
+    this->initRendererVertices(4, 6);
     this->dirtyFlag |= (DIRTY_ALL | DIRTY_SIZE | DIRTY_ANCHOR);
 }
 
@@ -107,3 +107,7 @@ void Label::deserializeData(const std::shared_ptr<Dictionary> &dict, const std::
     this->fontFilename = this->getPropertyData<String>(dict, PROP_KEY_FONT_FILENAME, params)->getValue();
     this->fontHeight = this->getPropertyData<Float>(dict, PROP_KEY_FONT_HEIGHT, params)->getValue();
 }
+
+bool Label::isInstanceable() {
+    return true;
+}
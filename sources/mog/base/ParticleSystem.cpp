@@ -0,0 +1,545 @@
+#include "mog/Constants.h"
+#include "mog/base/ParticleSystem.h"
+#include "mog/core/Json.h"
+#include "mog/core/FileUtils.h"
+#include "mog/core/simd.h"
+#include <math.h>
+#include <algorithm>
+
+#define PARTICLE_X 0
+#define PARTICLE_Y 1
+#define PARTICLE_VX 2
+#define PARTICLE_VY 3
+#define PARTICLE_LIFE 4
+#define PARTICLE_SCALE 5
+#define PARTICLE_SCALE_DELTA 6
+#define PARTICLE_ROTATION 7
+#define PARTICLE_ROTATION_DELTA 8
+#define PARTICLE_R 9
+#define PARTICLE_G 10
+#define PARTICLE_B 11
+#define PARTICLE_A 12
+#define PARTICLE_DR 13
+#define PARTICLE_DG 14
+#define PARTICLE_DB 15
+#define PARTICLE_DA 16
+#define PARTICLE_FIELDS_NUM 17
+
+// 16bit indices limit a non-instanced draw to 16383 quads
+#define PARTICLE_MAX_QUADS 16383
+
+using namespace mog;
+
+static bool getNumberValues(const std::shared_ptr<Dictionary> &dict, std::string key, float *values, int size) {
+    if (!dict->hasKey(key) || dict->getType(key) != DataType::List) return false;
+    auto list = dict->get<List>(key);
+    if ((int)list->size() < size) return false;
+    for (int i = 0; i < size; i++) {
+        const auto &value = list->valueAt(i);
+        if (!value.isNumber()) return false;
+        values[i] = value.getFloat();
+    }
+    return true;
+}
+
+static Point getPointValue(const std::shared_ptr<Dictionary> &dict, std::string key, const Point &defaultValue) {
+    float v[2];
+    if (!getNumberValues(dict, key, v, 2)) return defaultValue;
+    return Point(v[0], v[1]);
+}
+
+static Color getColorValue(const std::shared_ptr<Dictionary> &dict, std::string key, const Color &defaultValue) {
+    if (dict->hasKey(key) && dict->getType(key) == DataType::String) {
+        return Color(dict->get<String>(key)->getValue());
+    }
+    float v[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    if (getNumberValues(dict, key, v, 4) || getNumberValues(dict, key, v, 3)) {
+        return Color(v[0], v[1], v[2], v[3]);
+    }
+    return defaultValue;
+}
+
+
+#pragma - ParticleEmitter
+
+ParticleEmitter ParticleEmitter::parse(std::string jsonText) {
+    return ParticleEmitter::parse(Json::parse(jsonText));
+}
+
+ParticleEmitter ParticleEmitter::parse(const std::shared_ptr<Dictionary> &dict) {
+    ParticleEmitter emitter;
+    if (!dict) return emitter;
+
+    if (dict->hasKey("texture") && dict->getType("texture") == DataType::String) {
+        emitter.textureFilename = dict->get<String>("texture")->getValue();
+    }
+    float rect[4];
+    if (getNumberValues(dict, "rect", rect, 4)) {
+        emitter.textureRect = Rect(rect[0], rect[1], rect[2], rect[3]);
+    }
+    emitter.maxParticles = dict->getValue("maxParticles").getInt(emitter.maxParticles);
+    emitter.emissionRate = dict->getValue("emissionRate").getFloat(emitter.emissionRate);
+    emitter.duration = dict->getValue("duration").getFloat(emitter.duration);
+    emitter.lifeTime = dict->getValue("lifeTime").getFloat(emitter.lifeTime);
+    emitter.lifeTimeVariance = dict->getValue("lifeTimeVariance").getFloat(emitter.lifeTimeVariance);
+    emitter.speed = dict->getValue("speed").getFloat(emitter.speed);
+    emitter.speedVariance = dict->getValue("speedVariance").getFloat(emitter.speedVariance);
+    emitter.angle = dict->getValue("angle").getFloat(emitter.angle);
+    emitter.angleVariance = dict->getValue("angleVariance").getFloat(emitter.angleVariance);
+    emitter.positionVariance = getPointValue(dict, "positionVariance", emitter.positionVariance);
+    emitter.gravity = getPointValue(dict, "gravity", emitter.gravity);
+    emitter.drag = dict->getValue("drag").getFloat(emitter.drag);
+    emitter.startScale = dict->getValue("startScale").getFloat(emitter.startScale);
+    emitter.startScaleVariance = dict->getValue("startScaleVariance").getFloat(emitter.startScaleVariance);
+    emitter.endScale = dict->getValue("endScale").getFloat(emitter.endScale);
+    emitter.startRotation = dict->getValue("startRotation").getFloat(emitter.startRotation);
+    emitter.startRotationVariance = dict->getValue("startRotationVariance").getFloat(emitter.startRotationVariance);
+    emitter.rotationSpeed = dict->getValue("rotationSpeed").getFloat(emitter.rotationSpeed);
+    emitter.rotationSpeedVariance = dict->getValue("rotationSpeedVariance").getFloat(emitter.rotationSpeedVariance);
+    emitter.startColor = getColorValue(dict, "startColor", emitter.startColor);
+    emitter.startColorVariance = getColorValue(dict, "startColorVariance", emitter.startColorVariance);
+    emitter.endColor = getColorValue(dict, "endColor", emitter.endColor);
+    return emitter;
+}
+
+
+#pragma - ParticleSystem
+
+std::shared_ptr<ParticleSystem> ParticleSystem::create(const ParticleEmitter &emitter) {
+    auto particleSystem = std::shared_ptr<ParticleSystem>(new ParticleSystem());
+    particleSystem->emitter = emitter;
+    particleSystem->rect = emitter.textureRect;
+    particleSystem->init();
+    return particleSystem;
+}
+
+std::shared_ptr<ParticleSystem> ParticleSystem::createWithTexture(const std::shared_ptr<Texture2D> &texture, const ParticleEmitter &emitter, const Rect &rect) {
+    auto particleSystem = std::shared_ptr<ParticleSystem>(new ParticleSystem());
+    particleSystem->emitter = emitter;
+    particleSystem->rect = rect;
+    particleSystem->initWithTexture(texture);
+    return particleSystem;
+}
+
+std::shared_ptr<ParticleSystem> ParticleSystem::createWithJson(std::string filename) {
+    auto emitter = ParticleEmitter::parse(FileUtils::readTextAsset(filename));
+    return ParticleSystem::create(emitter);
+}
+
+ParticleSystem::~ParticleSystem() {
+    if (this->particleData) mogfree(this->particleData);
+}
+
+void ParticleSystem::init() {
+    std::shared_ptr<Texture2D> texture = nullptr;
+    if (this->emitter.textureFilename.length() > 0) {
+        texture = Texture2D::createWithAsset(this->emitter.textureFilename);
+    }
+    this->initWithTexture(texture);
+}
+
+void ParticleSystem::initWithTexture(const std::shared_ptr<Texture2D> &texture) {
+    this->textures[0] = texture;
+    if (this->textures[0] && this->rect.size == Size::zero) {
+        this->rect.size = Size(this->textures[0]->width / this->textures[0]->density.value,
+                               this->textures[0]->height / this->textures[0]->density.value);
+    }
+    this->particleSize = this->rect.size;
+    if (this->particleSize == Size::zero) {
+        this->particleSize = Size(8.0f, 8.0f);
+    }
+    this->initParticles();
+}
+
+void ParticleSystem::initParticles() {
+    int maxParticles = (this->emitter.maxParticles > 0) ? this->emitter.maxParticles : 1;
+    this->capacity = (maxParticles + 3) & ~3;
+    this->particleData = (float *)mogrealloc(this->particleData, sizeof(float) * this->capacity * PARTICLE_FIELDS_NUM);
+    this->particlesNum = 0;
+    this->elapsedTime = 0;
+    this->emitCounter = 0;
+    this->finished = false;
+    this->rendererInitialized = false;
+    this->dirtyFlag |= DIRTY_ALL;
+}
+
+void ParticleSystem::initRendererBuffers() {
+    if (this->instancing) {
+        this->initRendererVertices(4, 6);
+        float quadVertices[8] = {0, 0, 0, 1, 1, 0, 1, 1};
+        short quadIndices[6] = {0, 1, 2, 2, 1, 3};
+        for (int i = 0; i < 8; i++) {
+            this->renderer->vertices[i] = quadVertices[i];
+        }
+        for (int i = 0; i < 6; i++) {
+            this->renderer->indices[i] = quadIndices[i];
+        }
+        this->renderer->setInstancesNum(this->capacity);
+        this->renderer->newInstancesArr();
+
+    } else {
+        this->renderer->setInstancesNum(0);
+        int quadsNum = this->capacity;
+        if (quadsNum > PARTICLE_MAX_QUADS) {
+            LOGW("ParticleSystem: instancing is not available, only %d of %d particles are drawn.", PARTICLE_MAX_QUADS, quadsNum);
+            quadsNum = PARTICLE_MAX_QUADS;
+        }
+        this->initRendererVertices(quadsNum * 4, quadsNum * 6);
+        this->renderer->newVertexColorsArr();
+    }
+    if (this->textures[0]) {
+        this->renderer->newVertexTexCoordsArr();
+    }
+    this->rendererInitialized = true;
+    this->dirtyFlag |= DIRTY_ALL;
+}
+
+void ParticleSystem::start() {
+    this->emitting = true;
+    this->finished = false;
+    this->elapsedTime = 0;
+}
+
+void ParticleSystem::stop() {
+    this->emitting = false;
+}
+
+void ParticleSystem::reset() {
+    this->particlesNum = 0;
+    this->elapsedTime = 0;
+    this->emitCounter = 0;
+    this->emitting = true;
+    this->finished = false;
+    this->dirtyFlag |= (DIRTY_VERTEX | DIRTY_COLOR);
+}
+
+void ParticleSystem::emit(int count) {
+    count = std::min(count, this->capacity - this->particlesNum);
+    for (int i = 0; i < count; i++) {
+        this->emitParticle(this->particlesNum++);
+    }
+    if (count > 0) this->finished = false;
+}
+
+bool ParticleSystem::isEmitting() {
+    return this->emitting;
+}
+
+int ParticleSystem::getParticleCount() {
+    return this->particlesNum;
+}
+
+ParticleEmitter ParticleSystem::getEmitter() {
+    return this->emitter;
+}
+
+void ParticleSystem::setEmitter(const ParticleEmitter &emitter) {
+    this->emitter = emitter;
+    this->initParticles();
+}
+
+void ParticleSystem::setOnFinishEvent(std::function<void(const std::shared_ptr<ParticleSystem> &particleSystem)> onFinishEvent) {
+    this->onFinishEvent = onFinishEvent;
+}
+
+float *ParticleSystem::getParticleField(int field) {
+    return this->particleData + field * this->capacity;
+}
+
+float ParticleSystem::random() {
+    unsigned int x = this->randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    this->randomState = x;
+    return (float)(x & 0xFFFFFF) / 16777216.0f;
+}
+
+float ParticleSystem::randomMinus1To1() {
+    return this->random() * 2.0f - 1.0f;
+}
+
+void ParticleSystem::emitParticle(int idx) {
+    auto &e = this->emitter;
+    float life = fmax(e.lifeTime + e.lifeTimeVariance * this->randomMinus1To1(), 0.0001f);
+    float radian = (e.angle + e.angleVariance * this->randomMinus1To1()) * M_PI / 180.0f;
+    float speed = e.speed + e.speedVariance * this->randomMinus1To1();
+    float scale = e.startScale + e.startScaleVariance * this->randomMinus1To1();
+    float startColor[4] = {
+        e.startColor.r + e.startColorVariance.r * this->randomMinus1To1(),
+        e.startColor.g + e.startColorVariance.g * this->randomMinus1To1(),
+        e.startColor.b + e.startColorVariance.b * this->randomMinus1To1(),
+        e.startColor.a + e.startColorVariance.a * this->randomMinus1To1(),
+    };
+    float endColor[4] = {e.endColor.r, e.endColor.g, e.endColor.b, e.endColor.a};
+
+    this->getParticleField(PARTICLE_X)[idx] = e.positionVariance.x * this->randomMinus1To1();
+    this->getParticleField(PARTICLE_Y)[idx] = e.positionVariance.y * this->randomMinus1To1();
+    this->getParticleField(PARTICLE_VX)[idx] = cos(radian) * speed;
+    this->getParticleField(PARTICLE_VY)[idx] = -sin(radian) * speed;
+    this->getParticleField(PARTICLE_LIFE)[idx] = life;
+    this->getParticleField(PARTICLE_SCALE)[idx] = scale;
+    this->getParticleField(PARTICLE_SCALE_DELTA)[idx] = (e.endScale - scale) / life;
+    this->getParticleField(PARTICLE_ROTATION)[idx] = e.startRotation + e.startRotationVariance * this->randomMinus1To1();
+    this->getParticleField(PARTICLE_ROTATION_DELTA)[idx] = e.rotationSpeed + e.rotationSpeedVariance * this->randomMinus1To1();
+    for (int i = 0; i < 4; i++) {
+        float c = fmax(0.0f, fmin(1.0f, startColor[i]));
+        this->getParticleField(PARTICLE_R + i)[idx] = c;
+        this->getParticleField(PARTICLE_DR + i)[idx] = (endColor[i] - c) / life;
+    }
+}
+
+void ParticleSystem::updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, float *parentRendererMatrix, unsigned char parentDirtyFlag) {
+    Entity::updateFrame(engine, delta, parentMatrix, parentRendererMatrix, parentDirtyFlag);
+
+    bool instancing = ((parentDirtyFlag & IN_BATCHING) == 0 && Renderer::isInstancingSupported());
+    if (!this->rendererInitialized || this->instancing != instancing) {
+        this->instancing = instancing;
+        this->initRendererBuffers();
+    }
+
+    if (engine->isInterpolatingFrame()) return;
+
+    int prevParticlesNum = this->particlesNum;
+    this->updateParticles(delta);
+    if (this->particlesNum > 0 || prevParticlesNum > 0) {
+        this->dirtyFlag |= (DIRTY_VERTEX | DIRTY_COLOR);
+    }
+
+    if (!this->emitting && this->particlesNum == 0 && !this->finished) {
+        this->finished = true;
+        if (this->onFinishEvent) {
+            this->onFinishEvent(std::static_pointer_cast<ParticleSystem>(shared_from_this()));
+        }
+    }
+}
+
+void ParticleSystem::updateParticles(float delta) {
+    if (this->emitting) {
+        this->elapsedTime += delta;
+        if (this->emitter.duration >= 0 && this->elapsedTime >= this->emitter.duration) {
+            this->emitting = false;
+        } else {
+            this->emitCounter += this->emitter.emissionRate * delta;
+            int count = (int)this->emitCounter;
+            this->emitCounter -= count;
+            this->emit(count);
+        }
+    }
+
+    int n = this->particlesNum;
+    if (n == 0) return;
+
+    simd::add(this->getParticleField(PARTICLE_LIFE), -delta, n);
+
+    // gravity
+    if (this->emitter.gravity.x != 0) simd::add(this->getParticleField(PARTICLE_VX), this->emitter.gravity.x * delta, n);
+    if (this->emitter.gravity.y != 0) simd::add(this->getParticleField(PARTICLE_VY), this->emitter.gravity.y * delta, n);
+
+    // drag
+    if (this->emitter.drag > 0) {
+        float damping = fmax(0.0f, 1.0f - this->emitter.drag * delta);
+        simd::mul(this->getParticleField(PARTICLE_VX), damping, n);
+        simd::mul(this->getParticleField(PARTICLE_VY), damping, n);
+    }
+
+    simd::madd(this->getParticleField(PARTICLE_X), this->getParticleField(PARTICLE_VX), delta, n);
+    simd::madd(this->getParticleField(PARTICLE_Y), this->getParticleField(PARTICLE_VY), delta, n);
+
+    // size over life, rotation
+    simd::madd(this->getParticleField(PARTICLE_SCALE), this->getParticleField(PARTICLE_SCALE_DELTA), delta, n);
+    simd::madd(this->getParticleField(PARTICLE_ROTATION), this->getParticleField(PARTICLE_ROTATION_DELTA), delta, n);
+
+    // color over life
+    for (int i = 0; i < 4; i++) {
+        simd::madd(this->getParticleField(PARTICLE_R + i), this->getParticleField(PARTICLE_DR + i), delta, n);
+    }
+
+    this->removeDeadParticles();
+}
+
+void ParticleSystem::removeDeadParticles() {
+    float *life = this->getParticleField(PARTICLE_LIFE);
+    int i = 0;
+    while (i < this->particlesNum) {
+        if (life[i] > 0) {
+            i++;
+            continue;
+        }
+        int last = --this->particlesNum;
+        if (i != last) {
+            for (int f = 0; f < PARTICLE_FIELDS_NUM; f++) {
+                float *field = this->getParticleField(f);
+                field[i] = field[last];
+            }
+        }
+    }
+}
+
+void ParticleSystem::drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches) {
+    if (this->particlesNum == 0) return;
+    Entity::drawFrame(delta, touches);
+}
+
+void ParticleSystem::bindVertex() {
+    if (this->dirtyFlag == 0) return;
+
+    if ((this->dirtyFlag & DIRTY_TEXTURE) == DIRTY_TEXTURE && this->textures[0]) {
+        this->textures[0]->bindTexture(0);
+    }
+
+    if (this->instancing) {
+        if ((this->dirtyFlag & DIRTY_TEX_COORDS) == DIRTY_TEX_COORDS) {
+            this->renderer->bindVertex();
+            if (this->textures[0]) {
+                int idx = 0;
+                this->bindVertexTexCoords(this->renderer, &idx, 0, 0, 0, 1.0f, 1.0f);
+                float *texCoords = this->renderer->vertexTexCoords[0];
+                this->uvRect[0] = texCoords[0];
+                this->uvRect[1] = texCoords[1];
+                this->uvRect[2] = texCoords[6] - texCoords[0];
+                this->uvRect[3] = texCoords[7] - texCoords[1];
+                this->renderer->bindTexture(this->textures[0], 0);
+            }
+        }
+        this->bindParticleInstances();
+
+    } else {
+        if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
+            int vertexIdx = 0;
+            int indexIdx = 0;
+            this->bindVertices(this->renderer, &vertexIdx, &indexIdx, false);
+            this->renderer->bindVertex(true);
+        }
+        if ((this->dirtyFlag & DIRTY_COLOR) == DIRTY_COLOR) {
+            int colorIdx = 0;
+            this->bindParticleColors(this->renderer, &colorIdx, &Renderer::identityMatrix[16]);
+            this->renderer->bindVertexColors(true);
+        }
+        if ((this->dirtyFlag & DIRTY_TEX_COORDS) == DIRTY_TEX_COORDS && this->textures[0]) {
+            int vertexTexCoordsIdx = 0;
+            this->bindVertexTexCoords(this->renderer, &vertexTexCoordsIdx, 0, 0, 0, 1.0f, 1.0f);
+            this->renderer->bindVertexTexCoords(0);
+            this->renderer->bindTexture(this->textures[0], 0);
+        }
+    }
+
+    this->dirtyFlag = 0;
+}
+
+void ParticleSystem::bindParticleInstances() {
+    float *px = this->getParticleField(PARTICLE_X);
+    float *py = this->getParticleField(PARTICLE_Y);
+    float *scale = this->getParticleField(PARTICLE_SCALE);
+    float *rotation = this->getParticleField(PARTICLE_ROTATION);
+    float w = this->particleSize.width;
+    float h = this->particleSize.height;
+
+    for (int i = 0; i < this->particlesNum; i++) {
+        auto &instance = this->renderer->instances[i];
+        float radian = rotation[i] * M_PI / 180.0f;
+        float c = cos(radian) * scale[i];
+        float s = sin(radian) * scale[i];
+        instance.transform[0] = c * w;
+        instance.transform[1] = s * w;
+        instance.transform[2] = -s * h;
+        instance.transform[3] = c * h;
+        instance.translate[0] = px[i] - (instance.transform[0] + instance.transform[2]) * 0.5f;
+        instance.translate[1] = py[i] - (instance.transform[1] + instance.transform[3]) * 0.5f;
+        for (int j = 0; j < 4; j++) {
+            instance.uvRect[j] = this->uvRect[j];
+            float color = fmax(0.0f, fmin(1.0f, this->getParticleField(PARTICLE_R + j)[i]));
+            instance.color[j] = (unsigned char)(color * 255.0f + 0.5f);
+        }
+    }
+    this->renderer->setInstancesNum(this->particlesNum);
+    this->renderer->bindInstances(true);
+}
+
+void ParticleSystem::bindVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform) {
+    float *px = this->getParticleField(PARTICLE_X);
+    float *py = this->getParticleField(PARTICLE_Y);
+    float *scale = this->getParticleField(PARTICLE_SCALE);
+    float *rotation = this->getParticleField(PARTICLE_ROTATION);
+    float hw = this->particleSize.width * 0.5f;
+    float hh = this->particleSize.height * 0.5f;
+    float *m = this->renderer->matrix;
+    short quadIndices[6] = {0, 1, 2, 2, 1, 3};
+
+    int quadsNum = this->renderer->verticesNum / 4;
+    for (int i = 0; i < quadsNum; i++) {
+        Point p[4] = {Point::zero, Point::zero, Point::zero, Point::zero};
+        if (i < this->particlesNum && this->active) {
+            float radian = rotation[i] * M_PI / 180.0f;
+            float c = cos(radian) * scale[i];
+            float s = sin(radian) * scale[i];
+            float cx[4] = {-hw, -hw, hw, hw};
+            float cy[4] = {-hh, hh, -hh, hh};
+            for (int j = 0; j < 4; j++) {
+                p[j].x = cx[j] * c - cy[j] * s + px[i];
+                p[j].y = cx[j] * s + cy[j] * c + py[i];
+                if (bakeTransform) {
+                    float x = p[j].x;
+                    float y = p[j].y;
+                    p[j].x = m[0] * x + m[4] * y + m[12];
+                    p[j].y = m[1] * x + m[5] * y + m[13];
+                }
+            }
+        }
+
+        int startN = *verticesIdx / 2;
+        for (int j = 0; j < 4; j++) {
+            renderer->vertices[(*verticesIdx)++] = p[j].x;
+            renderer->vertices[(*verticesIdx)++] = p[j].y;
+        }
+        if (indicesIdx) {
+            this->bindIndices(renderer, indicesIdx, startN, quadIndices, 6);
+        }
+    }
+}
+
+void ParticleSystem::bindVertexColors(const std::shared_ptr<Renderer> &renderer, int *idx) {
+    this->bindParticleColors(renderer, idx, &this->renderer->matrix[16]);
+}
+
+void ParticleSystem::bindParticleColors(const std::shared_ptr<Renderer> &renderer, int *idx, const float *color) {
+    int quadsNum = this->renderer->verticesNum / 4;
+    for (int i = 0; i < quadsNum; i++) {
+        float c[4] = {0, 0, 0, 0};
+        if (i < this->particlesNum) {
+            for (int j = 0; j < 4; j++) {
+                c[j] = this->getParticleField(PARTICLE_R + j)[i] * color[j];
+            }
+        }
+        for (int v = 0; v < 4; v++) {
+            renderer->vertexColors[(*idx)++] = c[0];
+            renderer->vertexColors[(*idx)++] = c[1];
+            renderer->vertexColors[(*idx)++] = c[2];
+            renderer->vertexColors[(*idx)++] = c[3];
+        }
+    }
+}
+
+void ParticleSystem::bindVertexTexCoords(const std::shared_ptr<Renderer> &renderer, int *idx, int texIdx, float x, float y, float w, float h) {
+    int quadsNum = this->renderer->verticesNum / 4;
+    if (!this->textures[0]) {
+        for (int i = 0; i < quadsNum * 8; i++) {
+            renderer->vertexTexCoords[texIdx][(*idx)++] = -1.0f;
+        }
+        return;
+    }
+    Size texSize = Size(this->textures[0]->width, this->textures[0]->height) / this->textures[0]->density.value;
+    x += this->rect.position.x / texSize.width * w;
+    y += this->rect.position.y / texSize.height * h;
+    w *= this->rect.size.width / texSize.width;
+    h *= this->rect.size.height / texSize.height;
+    for (int i = 0; i < quadsNum; i++) {
+        Entity::bindVertexTexCoords(renderer, idx, texIdx, x, y, w, h);
+    }
+}
+
+std::shared_ptr<Entity> ParticleSystem::cloneEntity() {
+    auto particleSystem = ParticleSystem::createWithTexture(this->textures[0], this->emitter, this->rect);
+    particleSystem->copyProperties(std::static_pointer_cast<Entity>(shared_from_this()));
+    return particleSystem;
+}
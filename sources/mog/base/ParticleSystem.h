@@ -0,0 +1,106 @@
+#ifndef ParticleSystem_h
+#define ParticleSystem_h
+
+#include <memory>
+#include <string>
+#include <functional>
+#include <map>
+#include "mog/base/Entity.h"
+#include "mog/core/plain_objects.h"
+#include "mog/core/Data.h"
+
+namespace mog {
+    class ParticleEmitter {
+    public:
+        static ParticleEmitter parse(std::string jsonText);
+        static ParticleEmitter parse(const std::shared_ptr<Dictionary> &dict);
+
+        std::string textureFilename = "";
+        Rect textureRect = Rect::zero;
+        int maxParticles = 1000;
+        float emissionRate = 100.0f;
+        float duration = -1.0f;
+        float lifeTime = 1.0f;
+        float lifeTimeVariance = 0;
+        float speed = 100.0f;
+        float speedVariance = 0;
+        // degrees, counterclockwise from +x (90 = up)
+        float angle = 90.0f;
+        float angleVariance = 0;
+        Point positionVariance = Point::zero;
+        Point gravity = Point::zero;
+        float drag = 0;
+        float startScale = 1.0f;
+        float startScaleVariance = 0;
+        float endScale = 1.0f;
+        float startRotation = 0;
+        float startRotationVariance = 0;
+        float rotationSpeed = 0;
+        float rotationSpeedVariance = 0;
+        Color startColor = Color::white;
+        Color startColorVariance = Color(0, 0, 0, 0);
+        Color endColor = Color::white;
+    };
+
+    class ParticleSystem : public Entity {
+    public:
+        static std::shared_ptr<ParticleSystem> create(const ParticleEmitter &emitter);
+        static std::shared_ptr<ParticleSystem> createWithTexture(const std::shared_ptr<Texture2D> &texture, const ParticleEmitter &emitter, const Rect &rect = Rect::zero);
+        static std::shared_ptr<ParticleSystem> createWithJson(std::string filename);
+
+        ~ParticleSystem();
+
+        void start();
+        void stop();
+        void reset();
+        void emit(int count);
+        bool isEmitting();
+        int getParticleCount();
+        ParticleEmitter getEmitter();
+        void setEmitter(const ParticleEmitter &emitter);
+        void setOnFinishEvent(std::function<void(const std::shared_ptr<ParticleSystem> &particleSystem)> onFinishEvent);
+
+        virtual void updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, float *parentRendererMatrix, unsigned char parentDirtyFlag) override;
+        virtual void drawFrame(float delta, const std::map<unsigned int, TouchInput> &touches) override;
+
+    protected:
+        ParticleSystem() {}
+
+        ParticleEmitter emitter;
+        Rect rect = Rect::zero;
+        Size particleSize = Size::zero;
+        int capacity = 0;
+        int particlesNum = 0;
+        float *particleData = nullptr;
+        bool emitting = true;
+        bool finished = false;
+        bool instancing = false;
+        bool rendererInitialized = false;
+        float uvRect[4] = {-1.0f, -1.0f, 0, 0};
+        float elapsedTime = 0;
+        float emitCounter = 0;
+        unsigned int randomState = 2463534242;
+        std::function<void(const std::shared_ptr<ParticleSystem> &particleSystem)> onFinishEvent;
+
+        virtual void init() override;
+        void initWithTexture(const std::shared_ptr<Texture2D> &texture);
+        void initParticles();
+        void initRendererBuffers();
+        void emitParticle(int idx);
+        void updateParticles(float delta);
+        void removeDeadParticles();
+        float *getParticleField(int field);
+        float random();
+        float randomMinus1To1();
+
+        virtual void bindVertex() override;
+        virtual void bindVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform) override;
+        virtual void bindVertexColors(const std::shared_ptr<Renderer> &renderer, int *idx) override;
+        virtual void bindVertexTexCoords(const std::shared_ptr<Renderer> &renderer, int *idx, int texIdx, float x, float y, float w, float h) override;
+        void bindParticleColors(const std::shared_ptr<Renderer> &renderer, int *idx, const float *color);
+        void bindParticleInstances();
+        virtual std::shared_ptr<Entity> cloneEntity() override;
+    };
+}
+
+#endif /* ParticleSystem_h */
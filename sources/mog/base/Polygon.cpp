@@ -10,6 +10,14 @@ std::shared_ptr<Polygon> Polygon::create(const std::vector<Point> &vertexPoints)
     return polygon;
 }
 
+std::shared_ptr<Polygon> Polygon::create(const std::vector<Point> &vertexPoints, DrawType drawType) {
+    auto polygon = std::shared_ptr<Polygon>(new Polygon());
+    polygon->vertexPoints = vertexPoints;
+    polygon->drawType = drawType;
+    polygon->init();
+    return polygon;
+}
+
 void Polygon::init() {
     
     this->minPosition = vertexPoints[0];
@@ -22,7 +30,40 @@ void Polygon::init() {
     }
     this->size.width = this->maxPosition.x - this->minPosition.x;
     this->size.height = this->maxPosition.y - this->minPosition.y;
-    this->initRendererVertices((int)vertexPoints.size(), (int)vertexPoints.size());
+    this->initVertexIndices();
+    this->initRendererVertices((int)this->vertexPoints.size(), (int)this->vertexIndices.size());
+}
+
+void Polygon::initVertexIndices() {
+    this->vertexIndices.clear();
+    int size = (int)this->vertexPoints.size();
+    switch (this->drawType) {
+        case DrawType::Triangles:
+            for (int i = 0; i + 2 < size; i += 3) {
+                this->vertexIndices.emplace_back(i);
+                this->vertexIndices.emplace_back(i + 1);
+                this->vertexIndices.emplace_back(i + 2);
+            }
+            break;
+        case DrawType::TriangleFan:
+            for (int i = 1; i + 1 < size; i++) {
+                this->vertexIndices.emplace_back(0);
+                this->vertexIndices.emplace_back(i);
+                this->vertexIndices.emplace_back(i + 1);
+            }
+            break;
+        default:
+            for (int i = 0; i + 2 < size; i++) {
+                auto &p0 = this->vertexPoints[i];
+                auto &p1 = this->vertexPoints[i + 1];
+                auto &p2 = this->vertexPoints[i + 2];
+                if (p0 == p1 || p1 == p2 || p0 == p2) continue;
+                this->vertexIndices.emplace_back(i);
+                this->vertexIndices.emplace_back(i + 1);
+                this->vertexIndices.emplace_back(i + 2);
+            }
+            break;
+    }
 }
 
 void Polygon::bindVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform) {
@@ -30,23 +71,13 @@ void Polygon::bindVertices(const std::shared_ptr<Renderer> &renderer, int *verti
     float height = this->maxPosition.y - this->minPosition.y;
     Point scale = Point(this->transform->size.width / width, this->transform->size.height / height);
 
-    int startI = -1;
     int startN = *verticesIdx / 2;
-    if (indicesIdx) {
-        startI = *indicesIdx;
-    }
     Point offset, v1, v2;
     if (bakeTransform) {
         offset = Point(this->renderer->matrix[12], this->renderer->matrix[13]);
         v1 = Point(this->renderer->matrix[0], this->renderer->matrix[1]);
         v2 = Point(this->renderer->matrix[4], this->renderer->matrix[5]);
     }
-    if (startI > 0) {
-        renderer->indices[*indicesIdx] = renderer->indices[startI - 1];
-        (*indicesIdx)++;
-        renderer->indices[(*indicesIdx)++] = startN;
-    }
-    int i = 0;
     for (auto p : this->vertexPoints) {
         if (bakeTransform) {
             p = v1 * p.x + v2 * p.y + offset;
@@ -57,10 +88,9 @@ void Polygon::bindVertices(const std::shared_ptr<Renderer> &renderer, int *verti
         }
         renderer->vertices[(*verticesIdx)++] = p.x * scale.x;
         renderer->vertices[(*verticesIdx)++] = p.y * scale.y;
-        if (startI > -1) {
-            renderer->indices[(*indicesIdx)++] = startN + i;
-        }
-        i++;
+    }
+    if (indicesIdx) {
+        this->bindIndices(renderer, indicesIdx, startN, this->vertexIndices.data(), (int)this->vertexIndices.size());
     }
 }
 
@@ -81,7 +111,11 @@ std::vector<Point> Polygon::getPoints() {
     return this->vertexPoints;
 }
 
-std::shared_ptr<AABB> Polygon::getAABB() {
+DrawType Polygon::getDrawType() {
+    return this->drawType;
+}
+
+void Polygon::updateAABB(AABB &aabb) {
     auto v1 = Point(this->matrix[0], this->matrix[1]);
     auto v2 = Point(this->matrix[4], this->matrix[5]);
     auto offset = Point(this->matrix[12], this->matrix[13]) + this->minPosition;
@@ -93,31 +127,30 @@ std::shared_ptr<AABB> Polygon::getAABB() {
     Point minP = Point(fmin(fmin(p1.x, p2.x), fmin(p3.x, p4.x)), fmin(fmin(p1.y, p2.y), fmin(p3.y, p4.y)));
     Point maxP = Point(fmax(fmax(p1.x, p2.x), fmax(p3.x, p4.x)), fmax(fmax(p1.y, p2.y), fmax(p3.y, p4.y)));
     
-    return std::shared_ptr<AABB>(new AABB(offset.x + minP.x, offset.y + minP.y, offset.x + maxP.x, offset.y + maxP.y));
+    aabb = AABB(offset.x + minP.x, offset.y + minP.y, offset.x + maxP.x, offset.y + maxP.y);
 }
 
-std::shared_ptr<POLYGON> Polygon::getPOLYGON() {
+void Polygon::updatePOLYGON(POLYGON &polygon) {
     auto offset = Point(this->matrix[12], this->matrix[13]);
     auto v1 = Point(this->matrix[0], this->matrix[1]);
     auto v2 = Point(this->matrix[4], this->matrix[5]);
     int size = (int)this->vertexPoints.size();
-    Point *points = (Point *)mogmalloc(sizeof(Point) * size);
+    this->colliderPoints.resize(size);
     for (int i = 0; i < size; i++) {
         auto p = this->vertexPoints[i];
-        points[i] = v1 * p.x + v2 * p.y + offset;
+        this->colliderPoints[i] = v1 * p.x + v2 * p.y + offset;
     }
-    return std::shared_ptr<POLYGON>(new POLYGON(points, size));
+    polygon = POLYGON(this->colliderPoints.data(), size);
 }
 
-std::shared_ptr<Collider> Polygon::getCollider() {
-    auto collider = std::shared_ptr<Collider>(new Collider(ColliderShape::Polygon));
-    collider->aabb = this->getAABB();
-    collider->polygon = this->getPOLYGON();
-    return collider;
+void Polygon::updateCollider(Collider &collider) {
+    collider.shape = ColliderShape::Polygon;
+    this->updateAABB(collider.aabb);
+    this->updatePOLYGON(collider.polygon);
 }
 
 std::shared_ptr<Entity> Polygon::cloneEntity() {
-    auto polygon = Polygon::create(this->vertexPoints);
+    auto polygon = Polygon::create(this->vertexPoints, this->drawType);
     this->copyProperties(std::static_pointer_cast<Entity>(shared_from_this()));
     return polygon;
 }
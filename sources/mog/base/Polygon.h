@@ -9,6 +9,7 @@ namespace mog {
     class Polygon : public Entity {
     public:
         static std::shared_ptr<Polygon> create(const std::vector<Point> &vertexPoints);
+        static std::shared_ptr<Polygon> create(const std::vector<Point> &vertexPoints, DrawType drawType);
         
         template<class First, class... Rest>
         static std::shared_ptr<Polygon> create(const First& first, const Rest&... rest) {
@@ -21,19 +22,24 @@ namespace mog {
         }
 
         std::vector<Point> getPoints();
-        virtual std::shared_ptr<Collider> getCollider() override;
+        DrawType getDrawType();
 
     protected:
         virtual void init() override;
         virtual void bindVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform = false) override;
         virtual void bindVertexTexCoords(const std::shared_ptr<Renderer> &renderer, int *idx, int texIdx, float x, float y, float w, float h) override;
-        virtual std::shared_ptr<AABB> getAABB() override;
-        virtual std::shared_ptr<POLYGON> getPOLYGON();
+        virtual void updateCollider(Collider &collider) override;
+        virtual void updateAABB(AABB &aabb) override;
+        virtual void updatePOLYGON(POLYGON &polygon);
         virtual std::shared_ptr<Entity> cloneEntity() override;
+        void initVertexIndices();
 
         std::vector<Point> vertexPoints;
+        std::vector<short> vertexIndices;
+        DrawType drawType = DrawType::TrinangleStrip;
         Point minPosition = Point::zero;
         Point maxPosition = Point::zero;
+        std::vector<Point> colliderPoints;
         
     private:
         template<class First, class... Rest>
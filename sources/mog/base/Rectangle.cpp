@@ -23,12 +23,8 @@ void Rectangle::init() {
     Polygon::init();
 }
 
-std::shared_ptr<Collider> Rectangle::getCollider() {
-    if (this->collider) return this->collider;
-    this->collider = std::shared_ptr<Collider>(new Collider(ColliderShape::Rect));
-    this->collider->aabb = this->getAABB();
-    this->collider->obb = this->getOBB();
-    return this->collider;
+void Rectangle::updateCollider(Collider &collider) {
+    Entity::updateCollider(collider);
 }
 
 std::shared_ptr<Rectangle> Rectangle::clone() {
@@ -47,3 +43,7 @@ std::shared_ptr<Dictionary> Rectangle::serialize() {
     dict->put(PROP_KEY_ENTITY_TYPE, Int::create((int)EntityType::Rectangle));
     return dict;
 }
+
+bool Rectangle::isInstanceable() {
+    return true;
+}
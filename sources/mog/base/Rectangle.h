@@ -12,7 +12,6 @@ namespace mog {
         static std::shared_ptr<Rectangle> create(const Size &size);
         static std::shared_ptr<Rectangle> create(float width, float height);
         std::shared_ptr<Rectangle> clone();
-        virtual std::shared_ptr<Collider> getCollider() override;
         virtual std::shared_ptr<Dictionary> serialize() override;
 
     protected:
@@ -20,6 +19,8 @@ namespace mog {
         
         virtual void init() override;
         virtual std::shared_ptr<Entity> cloneEntity() override;
+        virtual bool isInstanceable() override;
+        virtual void updateCollider(Collider &collider) override;
     };
 }
 
@@ -68,7 +68,7 @@ void RoundedRectangle::init() {
     
     this->textures[0] = Texture2D::createWithRGBA(data, texWidth, texHeight, Screen::getDensity());
     this->rect = Rect(Point::zero, this->size);
-    this->initRendererVertices(25, 40);
+    this->initRendererVertices(25, 96);
 
     this->dirtyFlag |= (DIRTY_ALL | DIRTY_SIZE | DIRTY_ANCHOR);
 }
@@ -106,21 +106,13 @@ void RoundedRectangle::bindVertices(const std::shared_ptr<Renderer> &renderer, i
     }
     
     if (indicesIdx) {
-        int startI = *indicesIdx;
-        if (startI > 0) {
-            renderer->indices[*indicesIdx] = renderer->indices[(*indicesIdx) - 1];
-            (*indicesIdx)++;
-            renderer->indices[(*indicesIdx)++] = startN;
-        }
-        int ii[40] = {
-            0, 5, 1, 6, 2, 7, 3, 8, 4, 9,
-            9, 14, 8, 13, 7, 12, 6, 11, 5, 10,
-            10, 15, 11, 16, 12, 17, 13, 18, 14, 19,
-            19, 24, 18, 23, 17, 22, 16, 21, 15, 20,
+        short roundedRectIndices[96] = {
+            0, 5, 1, 1, 5, 6, 1, 6, 2, 2, 6, 7, 2, 7, 3, 3, 7, 8, 3, 8, 4, 4, 8, 9,
+            5, 10, 6, 6, 10, 11, 6, 11, 7, 7, 11, 12, 7, 12, 8, 8, 12, 13, 8, 13, 9, 9, 13, 14,
+            10, 15, 11, 11, 15, 16, 11, 16, 12, 12, 16, 17, 12, 17, 13, 13, 17, 18, 13, 18, 14, 14, 18, 19,
+            15, 20, 16, 16, 20, 21, 16, 21, 17, 17, 21, 22, 17, 22, 18, 18, 22, 23, 18, 23, 19, 19, 23, 24,
         };
-        for (int i = 0; i < 40; i++) {
-            renderer->indices[(*indicesIdx)++] = ii[i] + startN;
-        }
+        this->bindIndices(renderer, indicesIdx, startN, roundedRectIndices, 96);
     }
 }
 
@@ -218,3 +210,7 @@ void RoundedRectangle::deserializeData(const std::shared_ptr<Dictionary> &dict,
     this->cornerRadius = this->getPropertyData<Float>(dict, PROP_KEY_CORNER_RADIUS, params)->getValue();
     this->cornerFlag = (unsigned char)this->getPropertyData<Int>(dict, PROP_KEY_CORNER_FLAG, params)->getValue();
 }
+
+bool RoundedRectangle::isInstanceable() {
+    return false;
+}
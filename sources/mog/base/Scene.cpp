@@ -30,7 +30,9 @@ void Scene::removeAll() {
 }
 
 void Scene::updateFrame(const std::shared_ptr<Engine> &engine, float delta, unsigned char parentDirtyFlag) {
-    this->onUpdate(delta);
+    if (!engine->isInterpolatingFrame()) {
+        this->onUpdate(delta);
+    }
     this->dirtyFlag |= parentDirtyFlag;
     this->rootGroup->updateFrame(engine, delta, this->matrix, this->dirtyFlag);
 }
@@ -40,6 +42,10 @@ void Scene::drawFrame(float delta, const std::map<unsigned int, TouchInput> &tou
     this->dirtyFlag = 0;
 }
 
+bool Scene::isDirty() {
+    return ((this->dirtyFlag & DIRTY_ALL) > 0 || this->rootGroup->isDirty());
+}
+
 std::shared_ptr<AppBase> Scene::getApp() {
     return this->app.lock();
 }
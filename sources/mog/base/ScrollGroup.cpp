@@ -3,6 +3,9 @@
 
 using namespace mog;
 
+static const Symbol U_POSITION("u_position");
+static const Symbol U_SIZE("u_size");
+
 static const GLchar *fragmentShaderSource = "\
 uniform sampler2D u_texture0;\
 uniform highp vec2 u_screenSize;\
@@ -70,7 +73,7 @@ void ScrollGroup::init() {
 }
 
 void ScrollGroup::updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, float *parentRendererMatrix, unsigned char parentDirtyFlag) {
-    if (!this->dragging && (abs(this->velocity.x) >= 0.00001f || abs(this->velocity.y) >= 0.00001f)) {
+    if (!engine->isInterpolatingFrame() && !this->dragging && (abs(this->velocity.x) >= 0.00001f || abs(this->velocity.y) >= 0.00001f)) {
         this->setScrollPosition(this->contentGroup->getPosition() + this->velocity);
         this->velocity *= 0.9f;
     }
@@ -82,8 +85,8 @@ void ScrollGroup::drawFrame(float delta, const std::map<unsigned int, TouchInput
     if ((this->dirtyFlag & DIRTY_VERTEX) == DIRTY_VERTEX) {
         auto pos = this->getAbsolutePosition();
         auto size = this->getAbsoluteSize();
-        this->renderer->getShader()->setUniformParameter("u_position", pos.x, pos.y);
-        this->renderer->getShader()->setUniformParameter("u_size", size.width, size.height);
+        this->renderer->getShader()->setUniformParameter(U_POSITION, pos.x, pos.y);
+        this->renderer->getShader()->setUniformParameter(U_SIZE, size.width, size.height);
     }
     Group::drawFrame(delta, touches);
 }
@@ -104,15 +107,15 @@ std::vector<std::shared_ptr<Entity>> ScrollGroup::getChildEntities() {
     return this->contentGroup->getChildEntities();
 }
 
-std::shared_ptr<Entity> ScrollGroup::findChildByName(std::string name, bool recursive) {
+std::shared_ptr<Entity> ScrollGroup::findChildByName(const Symbol &name, bool recursive) {
     return this->contentGroup->findChildByName(name, recursive);
 }
 
-std::shared_ptr<Entity> ScrollGroup::findFirstChildByTag(std::string tag, bool recursive) {
+std::shared_ptr<Entity> ScrollGroup::findFirstChildByTag(const Symbol &tag, bool recursive) {
     return this->contentGroup->findFirstChildByTag(tag, recursive);
 }
 
-std::vector<std::shared_ptr<Entity>> ScrollGroup::findChildrenByTag(std::string tag, bool recursive) {
+std::vector<std::shared_ptr<Entity>> ScrollGroup::findChildrenByTag(const Symbol &tag, bool recursive) {
     return this->contentGroup->findChildrenByTag(tag, recursive);
 }
 
@@ -20,9 +20,9 @@ namespace mog {
         virtual void remove(const std::shared_ptr<Entity> &entity) override;
         virtual void removeAll() override;
         std::vector<std::shared_ptr<Entity>> getChildEntities();
-        std::shared_ptr<Entity> findChildByName(std::string name, bool recursive = true);
-        std::shared_ptr<Entity> findFirstChildByTag(std::string tag, bool recursive = true);
-        std::vector<std::shared_ptr<Entity>> findChildrenByTag(std::string tag, bool recursive = true);
+        std::shared_ptr<Entity> findChildByName(const Symbol &name, bool recursive = true);
+        std::shared_ptr<Entity> findFirstChildByTag(const Symbol &tag, bool recursive = true);
+        std::vector<std::shared_ptr<Entity>> findChildrenByTag(const Symbol &tag, bool recursive = true);
         
         void setScrollPosition(const Point &position);
         std::shared_ptr<ScrollGroup> clone();
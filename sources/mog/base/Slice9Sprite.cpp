@@ -42,7 +42,7 @@ void Slice9Sprite::initWithTexture(const std::shared_ptr<Texture2D> &texture) {
     if (this->size == Size::zero) {
         this->size = this->rect.size;
     }
-    this->initRendererVertices(16, 28);
+    this->initRendererVertices(16, 54);
 }
 
 std::string Slice9Sprite::getFilename() {
@@ -114,20 +114,13 @@ void Slice9Sprite::bindVertices(const std::shared_ptr<Renderer> &renderer, int *
         }
     }
     
-    if (startN > 0) {
-        renderer->indices[*indicesIdx] = renderer->indices[(*indicesIdx) - 1];
-        (*indicesIdx)++;
-        renderer->indices[(*indicesIdx)++] = 0 + startN;
-    }
-    short sliceIndices[28] = {
-        0, 4, 1, 5, 2, 6, 3, 7,
-        7, 4,
-        4, 8, 5, 9, 6, 10, 7, 11,
-        11, 8,
-        8, 12, 9, 13, 10, 14, 11, 15,
-    };
-    for (int i = 0; i < 28; i++) {
-        renderer->indices[(*indicesIdx)++] = sliceIndices[i] + startN;
+    if (indicesIdx) {
+        short sliceIndices[54] = {
+            0, 4, 1, 1, 4, 5, 1, 5, 2, 2, 5, 6, 2, 6, 3, 3, 6, 7,
+            4, 8, 5, 5, 8, 9, 5, 9, 6, 6, 9, 10, 6, 10, 7, 7, 10, 11,
+            8, 12, 9, 9, 12, 13, 9, 13, 10, 10, 13, 14, 10, 14, 11, 11, 14, 15,
+        };
+        this->bindIndices(renderer, indicesIdx, startN, sliceIndices, 54);
     }
 }
 
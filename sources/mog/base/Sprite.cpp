@@ -107,7 +107,7 @@ void Sprite::init() {
         this->size = this->rect.size;
     }
 
-    this->initRendererVertices(4, 4);
+    this->initRendererVertices(4, 6);
     this->dirtyFlag |= (DIRTY_ALL | DIRTY_SIZE | DIRTY_ANCHOR);
 }
 
@@ -123,7 +123,7 @@ void Sprite::initWithFilePath(std::string filepath, const Rect &rect, Density de
     this->rect = _rect;
     this->size = this->rect.size;
     
-    this->initRendererVertices(4, 4);
+    this->initRendererVertices(4, 6);
 }
 
 void Sprite::initWithImage(const std::shared_ptr<ByteArray> &bytes) {
@@ -132,7 +132,7 @@ void Sprite::initWithImage(const std::shared_ptr<ByteArray> &bytes) {
     this->size.height = this->textures[0]->height / this->textures[0]->density.value;
     this->rect = Rect(Point::zero, this->size);
     
-    this->initRendererVertices(4, 4);
+    this->initRendererVertices(4, 6);
 }
 
 void Sprite::initWithRGBA(unsigned char *data, int width, int height) {
@@ -141,7 +141,7 @@ void Sprite::initWithRGBA(unsigned char *data, int width, int height) {
     this->size.height = this->textures[0]->height / this->textures[0]->density.value;
     this->rect = Rect(Point::zero, this->size);
     
-    this->initRendererVertices(4, 4);
+    this->initRendererVertices(4, 6);
 }
 
 void Sprite::initWithTexture(const std::shared_ptr<Texture2D> &texture, const Rect &rect) {
@@ -155,7 +155,7 @@ void Sprite::initWithTexture(const std::shared_ptr<Texture2D> &texture, const Re
     }
     this->rect = _rect;
     
-    this->initRendererVertices(4, 4);
+    this->initRendererVertices(4, 6);
 }
 
 void Sprite::bindVertexTexCoords(const std::shared_ptr<Renderer> &renderer, int *idx, int texIdx, float x, float y, float w, float h) {
@@ -197,3 +197,7 @@ void Sprite::deserializeData(const std::shared_ptr<Dictionary> &dict, const std:
     this->rect.size.width = this->getPropertyData<Float>(dict, PROP_KEY_RECT_WIDTH, params)->getValue();
     this->rect.size.height = this->getPropertyData<Float>(dict, PROP_KEY_RECT_HEIGHT, params)->getValue();
 }
+
+bool Sprite::isInstanceable() {
+    return true;
+}
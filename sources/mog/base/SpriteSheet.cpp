@@ -1,9 +1,300 @@
 #include "mog/base/SpriteSheet.h"
+#include "mog/core/Json.h"
+#include "mog/core/FileUtils.h"
+#include <stdio.h>
+#include <algorithm>
 
 using namespace mog;
 
+static std::unordered_map<std::string, std::weak_ptr<SpriteSheetDefinition>> gridDefinitions;
+
+static std::shared_ptr<Dictionary> getDictionary(const std::shared_ptr<Dictionary> &dict, std::string key) {
+    if (!dict->hasKey(key) || dict->getType(key) != DataType::Dictionary) return nullptr;
+    return dict->get<Dictionary>(key);
+}
+
+static LoopType getLoopType(const std::shared_ptr<Dictionary> &dict, std::string key) {
+    if (!dict->hasKey(key) || dict->getType(key) != DataType::String) return LoopType::None;
+    std::string name = dict->get<String>(key)->getValue();
+    if (name == "loop") return LoopType::Loop;
+    if (name == "pingpong") return LoopType::PingPong;
+    return LoopType::None;
+}
+
+
+#pragma - SpriteSheetDefinition
+
+std::shared_ptr<SpriteSheetDefinition> SpriteSheetDefinition::create(const std::shared_ptr<Texture2D> &texture, const Size &frameSize, unsigned int frameCount, unsigned int margin, const Rect &rect) {
+    // grid sheets with the same parameters share one definition
+    char key[256];
+    snprintf(key, sizeof(key), "%p:%f:%f:%u:%u:%f:%f:%f:%f", (void *)texture.get(), frameSize.width, frameSize.height, frameCount, margin,
+             rect.position.x, rect.position.y, rect.size.width, rect.size.height);
+    auto found = gridDefinitions.find(key);
+    if (found != gridDefinitions.end()) {
+        if (auto cached = found->second.lock()) return cached;
+    }
+
+    auto definition = std::shared_ptr<SpriteSheetDefinition>(new SpriteSheetDefinition());
+    definition->texture = texture;
+    definition->frameSize = frameSize;
+    definition->margin = margin;
+    definition->rect = rect;
+
+    float density = texture->density.value;
+    Size texSize = Size(texture->width, texture->height) / density;
+    if (definition->rect.size == Size::zero) {
+        definition->rect.size = texSize;
+    }
+    float _margin = (float)margin / density;
+    int cols = (frameSize.width > 0) ? (int)((definition->rect.size.width + _margin) / (frameSize.width + _margin)) : 0;
+    int rows = (frameSize.height > 0) ? (int)((definition->rect.size.height + _margin) / (frameSize.height + _margin)) : 0;
+    if (frameCount == 0 || frameCount > (unsigned int)(cols * rows)) {
+        frameCount = (unsigned int)(cols * rows);
+    }
+
+    for (unsigned int i = 0; i < std::max(frameCount, 1u); i++) {
+        int c = (cols > 0) ? (int)i % cols : 0;
+        int r = (cols > 0) ? (int)i / cols : 0;
+        SpriteSheetFrame frame;
+        frame.rect = Rect(definition->rect.position.x + c * (frameSize.width + _margin),
+                          definition->rect.position.y + r * (frameSize.height + _margin),
+                          frameSize.width, frameSize.height);
+        frame.uvRect[0] = frame.rect.position.x / texSize.width;
+        frame.uvRect[1] = frame.rect.position.y / texSize.height;
+        frame.uvRect[2] = frame.rect.size.width / texSize.width;
+        frame.uvRect[3] = frame.rect.size.height / texSize.height;
+        frame.sourceSize = frameSize;
+        definition->addFrame(frame);
+    }
+
+    // released definitions are dropped here, so the map only holds the live ones
+    for (auto it = gridDefinitions.begin(); it != gridDefinitions.end();) {
+        if (it->second.expired()) {
+            it = gridDefinitions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    gridDefinitions[key] = definition;
+    return definition;
+}
+
+std::shared_ptr<SpriteSheetDefinition> SpriteSheetDefinition::createWithJson(std::string filename, float timePerFrame) {
+    auto dict = Json::parse(FileUtils::readTextAsset(filename));
+    if (!dict) return nullptr;
+
+    auto meta = getDictionary(dict, "meta");
+    if (!meta || !meta->hasKey("image") || meta->getType("image") != DataType::String) {
+        LOGE("SpriteSheetDefinition: meta.image not found in %s", filename.c_str());
+        return nullptr;
+    }
+    std::string image = meta->get<String>("image")->getValue();
+    size_t pos = filename.find_last_of('/');
+    if (pos != std::string::npos) {
+        image = filename.substr(0, pos + 1) + image;
+    }
+    return SpriteSheetDefinition::parse(dict, Texture2D::createWithAsset(image), timePerFrame);
+}
+
+std::shared_ptr<SpriteSheetDefinition> SpriteSheetDefinition::parse(std::string jsonText, const std::shared_ptr<Texture2D> &texture, float timePerFrame) {
+    return SpriteSheetDefinition::parse(Json::parse(jsonText), texture, timePerFrame);
+}
+
+std::shared_ptr<SpriteSheetDefinition> SpriteSheetDefinition::parse(const std::shared_ptr<Dictionary> &dict, const std::shared_ptr<Texture2D> &texture, float timePerFrame) {
+    if (!dict || !texture || texture->width == 0 || texture->height == 0) return nullptr;
+
+    auto definition = std::shared_ptr<SpriteSheetDefinition>(new SpriteSheetDefinition());
+    definition->texture = texture;
+    float density = texture->density.value;
+    definition->rect = Rect(0, 0, texture->width / density, texture->height / density);
+
+    // both the hash and the array layouts of the common atlas format are accepted
+    std::vector<std::pair<std::string, std::shared_ptr<Dictionary>>> frameDicts;
+    if (dict->hasKey("frames") && dict->getType("frames") == DataType::Dictionary) {
+        auto frames = dict->get<Dictionary>("frames");
+        for (const auto &name : frames->getKeys()) {
+            if (auto frameDict = getDictionary(frames, name)) {
+                frameDicts.emplace_back(std::make_pair(name, frameDict));
+            }
+        }
+    } else if (dict->hasKey("frames") && dict->getType("frames") == DataType::List) {
+        auto frames = dict->get<List>("frames");
+        for (int i = 0; i < (int)frames->size(); i++) {
+            if (frames->atType(i) != DataType::Dictionary) continue;
+            auto frameDict = frames->at<Dictionary>(i);
+            std::string name = "";
+            if (frameDict->hasKey("filename") && frameDict->getType("filename") == DataType::String) {
+                name = frameDict->get<String>("filename")->getValue();
+            }
+            frameDicts.emplace_back(std::make_pair(name, frameDict));
+        }
+    }
+
+    for (const auto &pair : frameDicts) {
+        auto rectDict = getDictionary(pair.second, "frame");
+        if (!rectDict) continue;
+        float x = rectDict->getValue("x").getFloat(0);
+        float y = rectDict->getValue("y").getFloat(0);
+        float w = rectDict->getValue("w").getFloat(0);
+        float h = rectDict->getValue("h").getFloat(0);
+        if (pair.second->hasKey("rotated") && pair.second->getType("rotated") == DataType::Bool &&
+            pair.second->get<Bool>("rotated")->getValue()) {
+            LOGW("SpriteSheetDefinition: rotated frame is not supported. %s", pair.first.c_str());
+        }
+
+        SpriteSheetFrame frame;
+        frame.name = pair.first;
+        frame.rect = Rect(x / density, y / density, w / density, h / density);
+        frame.uvRect[0] = x / texture->width;
+        frame.uvRect[1] = y / texture->height;
+        frame.uvRect[2] = w / texture->width;
+        frame.uvRect[3] = h / texture->height;
+        frame.sourceSize = frame.rect.size;
+
+        auto sourceDict = getDictionary(pair.second, "sourceSize");
+        auto spriteSourceDict = getDictionary(pair.second, "spriteSourceSize");
+        if (sourceDict && spriteSourceDict) {
+            float sw = sourceDict->getValue("w").getFloat(w);
+            float sh = sourceDict->getValue("h").getFloat(h);
+            if (sw > 0 && sh > 0) {
+                frame.sourceSize = Size(sw / density, sh / density);
+                frame.quadRect[0] = spriteSourceDict->getValue("x").getFloat(0) / sw;
+                frame.quadRect[1] = spriteSourceDict->getValue("y").getFloat(0) / sh;
+                frame.quadRect[2] = w / sw;
+                frame.quadRect[3] = h / sh;
+            }
+        }
+        definition->addFrame(frame);
+    }
+    if (definition->frames.size() == 0) {
+        LOGW("SpriteSheetDefinition: no frames found.");
+        return nullptr;
+    }
+    definition->frameSize = definition->frames[0].sourceSize;
+
+    // "name": ["frame1", "frame2"] or "name": {"frames": [...], "timePerFrame": 0.1, "loop": "loop"}
+    if (auto animations = getDictionary(dict, "animations")) {
+        for (const auto &name : animations->getKeys()) {
+            std::shared_ptr<List> frameList;
+            float time = timePerFrame;
+            LoopType loopType = LoopType::None;
+            int loopCount = 0;
+            if (animations->getType(name) == DataType::List) {
+                frameList = animations->get<List>(name);
+            } else if (auto animDict = getDictionary(animations, name)) {
+                if (animDict->hasKey("frames") && animDict->getType("frames") == DataType::List) {
+                    frameList = animDict->get<List>("frames");
+                }
+                time = animDict->getValue("timePerFrame").getFloat(time);
+                loopType = getLoopType(animDict, "loop");
+                loopCount = animDict->getValue("loopCount").getInt(0);
+            }
+            if (!frameList) continue;
+
+            std::vector<unsigned int> frames;
+            for (int i = 0; i < (int)frameList->size(); i++) {
+                // Json parses integers as Long, so any numeric type is accepted as a frame id
+                const auto &value = frameList->valueAt(i);
+                int frameId = -1;
+                if (value.getType() == DataType::String) {
+                    frameId = definition->getFrameId(value.getString());
+                } else if (value.isNumber()) {
+                    frameId = value.getInt(-1);
+                }
+                if (frameId >= 0 && frameId < (int)definition->frames.size()) {
+                    frames.emplace_back((unsigned int)frameId);
+                }
+            }
+            definition->addAnimation(name, frames, time, loopType, loopCount);
+        }
+    }
+    return definition;
+}
+
+void SpriteSheetDefinition::addFrame(const SpriteSheetFrame &frame) {
+    if (frame.quadRect[0] != 0 || frame.quadRect[1] != 0 || frame.quadRect[2] != 1.0f || frame.quadRect[3] != 1.0f) {
+        this->trimmed = true;
+    }
+    if (frame.name.length() > 0) {
+        this->frameIds[frame.name] = (unsigned int)this->frames.size();
+    }
+    this->frames.emplace_back(frame);
+}
+
+int SpriteSheetDefinition::addAnimation(std::string name, const std::vector<unsigned int> &frames, float timePerFrame, LoopType loopType, int loopCount) {
+    return this->addAnimation(name, frames, std::vector<float>(frames.size(), timePerFrame), loopType, loopCount);
+}
+
+int SpriteSheetDefinition::addAnimation(std::string name, const std::vector<unsigned int> &frames, const std::vector<float> &timePerFrames, LoopType loopType, int loopCount) {
+    if (frames.size() == 0 || timePerFrames.size() == 0) return -1;
+    SpriteSheetAnimation animation;
+    animation.name = name;
+    animation.loopType = loopType;
+    animation.loopCount = loopCount;
+    for (int i = 0; i < (int)frames.size(); i++) {
+        animation.frames.emplace_back(frames[i] % this->frames.size());
+        animation.timePerFrames.emplace_back(timePerFrames[std::min(i, (int)timePerFrames.size() - 1)]);
+    }
+    int animationId = (int)this->animations.size();
+    this->animations.emplace_back(animation);
+    if (name.length() > 0) {
+        this->animationIds[name] = animationId;
+    }
+    return animationId;
+}
+
+std::shared_ptr<Texture2D> SpriteSheetDefinition::getTexture() const {
+    return this->texture;
+}
+
+Size SpriteSheetDefinition::getFrameSize() const {
+    return this->frameSize;
+}
+
+unsigned int SpriteSheetDefinition::getMargin() const {
+    return this->margin;
+}
+
+Rect SpriteSheetDefinition::getRect() const {
+    return this->rect;
+}
+
+unsigned int SpriteSheetDefinition::getFrameCount() const {
+    return (unsigned int)this->frames.size();
+}
+
+const SpriteSheetFrame &SpriteSheetDefinition::getFrame(unsigned int frame) const {
+    return this->frames[frame];
+}
+
+int SpriteSheetDefinition::getFrameId(std::string name) const {
+    auto it = this->frameIds.find(name);
+    return (it != this->frameIds.end()) ? (int)it->second : -1;
+}
+
+bool SpriteSheetDefinition::isTrimmed() const {
+    return this->trimmed;
+}
+
+int SpriteSheetDefinition::getAnimationCount() const {
+    return (int)this->animations.size();
+}
+
+const SpriteSheetAnimation &SpriteSheetDefinition::getAnimation(int animationId) const {
+    return this->animations[animationId];
+}
+
+int SpriteSheetDefinition::getAnimationId(std::string name) const {
+    auto it = this->animationIds.find(name);
+    return (it != this->animationIds.end()) ? it->second : -1;
+}
+
+
+#pragma - SpriteSheet
+
 std::shared_ptr<SpriteSheet> SpriteSheet::create(std::string filename, const Size &frameSize, unsigned int frameCount, unsigned int margin, const Rect &rect) {
     auto spriteSheet = std::shared_ptr<SpriteSheet>(new SpriteSheet());
+    spriteSheet->filename = filename;
     spriteSheet->frameSize = frameSize;
     spriteSheet->frameCount = frameCount;
     spriteSheet->margin = margin;
@@ -26,71 +317,61 @@ std::shared_ptr<SpriteSheet> SpriteSheet::createWithSprite(const std::shared_ptr
     return SpriteSheet::createWithTexture(sprite->getTexture(), frameSize, frameCount, margin, sprite->getRect());
 }
 
+std::shared_ptr<SpriteSheet> SpriteSheet::createWithDefinition(const std::shared_ptr<SpriteSheetDefinition> &definition) {
+    auto spriteSheet = std::shared_ptr<SpriteSheet>(new SpriteSheet());
+    spriteSheet->initWithDefinition(definition);
+    return spriteSheet;
+}
+
+std::shared_ptr<SpriteSheet> SpriteSheet::createWithAtlas(std::string filename, float timePerFrame) {
+    auto definition = SpriteSheetDefinition::createWithJson(filename, timePerFrame);
+    if (!definition) return nullptr;
+    return SpriteSheet::createWithDefinition(definition);
+}
+
 void SpriteSheet::init() {
     auto texture = Texture2D::createWithAsset(filename);
     return this->initWithTexture(texture);
 }
 
 void SpriteSheet::initWithTexture(const std::shared_ptr<Texture2D> &texture) {
-    this->textures[0] = texture;
-    if (this->rect.size == Size::zero) {
-        this->rect.size = Size(this->textures[0]->width / this->textures[0]->density.value,
-                          this->textures[0]->height / this->textures[0]->density.value);
-    }
+    this->initWithDefinition(SpriteSheetDefinition::create(texture, this->frameSize, this->frameCount, this->margin, this->rect));
+}
+
+void SpriteSheet::initWithDefinition(const std::shared_ptr<SpriteSheetDefinition> &definition) {
+    this->definition = definition;
+    this->textures[0] = definition->getTexture();
+    this->frameSize = definition->getFrameSize();
+    this->frameCount = definition->getFrameCount();
+    this->margin = definition->getMargin();
+    this->rect = definition->getRect();
     if (this->size == Size::zero) {
-        this->size = this->rect.size;
+        this->size = this->frameSize;
+    }
+    if (this->frame >= this->frameCount) {
+        this->frame = 0;
     }
 
-    this->initRendererVertices(4, 4);
-    this->initFrames(this->frameCount, this->margin);
+    this->initRendererVertices(4, 6);
+    this->dirtyFlag |= (DIRTY_VERTEX | DIRTY_TEX_COORDS);
 }
 
-Rect SpriteSheet::getRect() {
-    return this->rect;
+std::shared_ptr<SpriteSheetDefinition> SpriteSheet::getDefinition() {
+    return this->definition;
 }
 
-void SpriteSheet::initFrames(unsigned int frameCount, unsigned int margin) {
-    float _margin = (float)margin / this->textures[0]->density.value;
-    int cols = (this->rect.size.width + _margin) / (frameSize.width + _margin);
-    int rows = (this->rect.size.height + _margin) / (frameSize.height + _margin);
-    
-    if (frameCount == 0) {
-        frameCount = (unsigned int)(cols * rows);
-    }
-
-    this->frameCount = frameCount;
-    this->margin = margin;
-
-    this->framePoints.clear();
-    this->framePoints.reserve(frameCount);
-    
-    int r = 0;
-    int c = 0;
-    for (int i = 0; i < frameCount; i++) {
-        float x = c * (frameSize.width + _margin);
-        float y = r * (frameSize.height + _margin);
-        this->framePoints.emplace_back(Point(x, y));
-        
-        if (++c >= cols) {
-            if (++r >= rows) {
-                break;
-            };
-            c = 0;
-        }
-    }
-    if (frameCount == 0) {
-        this->framePoints.emplace_back(Point(0, 0));
-    }
-    
-    this->frameCount = (unsigned int)framePoints.size();
+Rect SpriteSheet::getRect() {
+    return this->rect;
 }
 
 void SpriteSheet::setFrameCount(unsigned int frameCount) {
-    this->initFrames(frameCount, this->margin);
+    this->frameCount = frameCount;
+    this->initWithTexture(this->textures[0]);
 }
 
 void SpriteSheet::setMargin(unsigned int margin) {
-    this->initFrames(this->frameCount, margin);
+    this->margin = margin;
+    this->initWithTexture(this->textures[0]);
 }
 
 void SpriteSheet::updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, unsigned char parentDirtyFlag) {
@@ -98,67 +379,104 @@ void SpriteSheet::updateFrame(const std::shared_ptr<Engine> &engine, float delta
     Entity::updateFrame(engine, delta, parentMatrix, parentDirtyFlag);
 }
 
+const SpriteSheetAnimation &SpriteSheet::getCurrentAnimation() {
+    if (this->animationId >= 0) {
+        return this->definition->getAnimation(this->animationId);
+    }
+    return *this->customAnimation;
+}
+
 void SpriteSheet::updateSpriteFrame(float delta) {
-    if (this->animating) {
-        this->tmpTime += delta;
-        while (this->tmpTime >= this->timePerFrames[this->nextFrame]) {
-            this->tmpTime -= this->timePerFrames[this->nextFrame];
-            this->selectFrame(this->nextFrame);
-            
-            int offset = 1;
-            int endFrame = this->endFrame;
-            if (this->loopType == LoopType::PingPong && this->currentLoopCount % 2 == 1) {
-                endFrame = this->startFrame;
-                offset = -1;
+    if (!this->animating) return;
+
+    const auto &animation = this->getCurrentAnimation();
+    int last = (int)animation.frames.size() - 1;
+    this->animationTime += delta;
+    while (this->animating && animation.timePerFrames[this->animationIndex] > 0 &&
+           this->animationTime >= animation.timePerFrames[this->animationIndex]) {
+        this->animationTime -= animation.timePerFrames[this->animationIndex];
+
+        bool reversed = (animation.loopType == LoopType::PingPong && this->currentLoopCount % 2 == 1);
+        if (this->animationIndex == (reversed ? 0 : last)) {
+            this->currentLoopCount++;
+            if (animation.loopType == LoopType::None || (animation.loopCount > 0 && this->currentLoopCount >= animation.loopCount)) {
+                this->stopAnimation();
+                break;
             }
-            if (this->nextFrame == endFrame) {
-                this->currentLoopCount++;
-                if (this->loopType == LoopType::None || (this->loopCount > 0 && this->currentLoopCount >= this->loopCount)) {
-                    this->stopAnimation();
-                } else if (this->loopType == LoopType::Loop) {
-                    this->nextFrame = 0;
-                } else if (this->loopType == LoopType::PingPong) {
-                    this->nextFrame -= offset;
-                }
-                
-            } else {
-                this->nextFrame += offset;
+            if (animation.loopType == LoopType::Loop) {
+                this->animationIndex = 0;
+            } else if (last > 0) {
+                this->animationIndex += reversed ? 1 : -1;
             }
+        } else {
+            this->animationIndex += reversed ? -1 : 1;
         }
+        this->selectFrame(animation.frames[this->animationIndex]);
     }
 }
 
 void SpriteSheet::selectFrame(unsigned int frame) {
-    LOGD("%d\n", frame);
     this->frame = frame % this->frameCount;
     this->dirtyFlag |= DIRTY_TEX_COORDS;
+    if (this->definition->isTrimmed()) {
+        this->dirtyFlag |= DIRTY_VERTEX;
+    }
 }
 
-void SpriteSheet::startAnimation(float timePerFrame, LoopType loopType, int loopCount, int startFrame, int endFrame) {
-    for (int i = 0; i < frameCount; i++) {
-        this->timePerFrames.emplace_back(timePerFrame);
+void SpriteSheet::selectFrame(std::string name) {
+    int frameId = this->definition->getFrameId(name);
+    if (frameId < 0) {
+        LOGW("SpriteSheet: frame not found. %s", name.c_str());
+        return;
     }
-    this->startAnimation(this->timePerFrames, loopType, startFrame, endFrame);
+    this->selectFrame((unsigned int)frameId);
+}
+
+void SpriteSheet::startAnimation(float timePerFrame, LoopType loopType, int loopCount, int startFrame, int endFrame) {
+    this->startAnimation(std::vector<float>(this->frameCount, timePerFrame), loopType, loopCount, startFrame, endFrame);
 }
 
 void SpriteSheet::startAnimation(const std::vector<float> &timePerFrames, LoopType loopType, int loopCount, int startFrame, int endFrame) {
-    this->timePerFrames = timePerFrames;
-    
-    this->startFrame = startFrame;
-    if (this->endFrame <= 0) this->endFrame = this->frameCount - 1;
-    if (this->endFrame <= this->startFrame) {
+    if (endFrame <= 0) endFrame = this->frameCount - 1;
+    if (endFrame <= startFrame || timePerFrames.size() == 0) {
+        return;
+    }
+
+    // timePerFrames is indexed by frame number, as before
+    auto animation = std::make_shared<SpriteSheetAnimation>();
+    animation->loopType = loopType;
+    animation->loopCount = loopCount;
+    for (int f = startFrame; f <= endFrame; f++) {
+        animation->frames.emplace_back(f % this->frameCount);
+        animation->timePerFrames.emplace_back(timePerFrames[std::min(f, (int)timePerFrames.size() - 1)]);
+    }
+    this->customAnimation = animation;
+    this->animationId = -1;
+    this->beginAnimation();
+}
+
+void SpriteSheet::playAnimation(std::string name) {
+    int animationId = this->definition->getAnimationId(name);
+    if (animationId < 0) {
+        LOGW("SpriteSheet: animation not found. %s", name.c_str());
         return;
     }
-    
-    this->loopType = loopType;
-    this->loopCount = loopCount;
-    this->startFrame = this->frame;
+    this->playAnimation(animationId);
+}
+
+void SpriteSheet::playAnimation(int animationId) {
+    if (animationId < 0 || animationId >= this->definition->getAnimationCount()) return;
+    this->animationId = animationId;
+    this->customAnimation = nullptr;
+    this->beginAnimation();
+}
+
+void SpriteSheet::beginAnimation() {
     this->animating = true;
-    
-    this->tmpTime = 0;
+    this->animationTime = 0;
+    this->animationIndex = 0;
     this->currentLoopCount = 0;
-    this->nextFrame = startFrame + 1;
-    this->selectFrame(startFrame);
+    this->selectFrame(this->getCurrentAnimation().frames[0]);
 }
 
 void SpriteSheet::stopAnimation() {
@@ -168,23 +486,57 @@ void SpriteSheet::stopAnimation() {
     }
 }
 
+bool SpriteSheet::isAnimating() {
+    return this->animating;
+}
+
+void SpriteSheet::getQuadRect(float *quadRect) {
+    const auto &frame = this->definition->getFrame(this->frame);
+    quadRect[0] = frame.quadRect[0] * this->transform->size.width;
+    quadRect[1] = frame.quadRect[1] * this->transform->size.height;
+    quadRect[2] = frame.quadRect[2] * this->transform->size.width;
+    quadRect[3] = frame.quadRect[3] * this->transform->size.height;
+}
+
+void SpriteSheet::bindVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform) {
+    if (!this->definition->isTrimmed()) {
+        Entity::bindVertices(renderer, verticesIdx, indicesIdx, bakeTransform);
+        return;
+    }
+    float q[4];
+    this->getQuadRect(q);
+    this->bindQuadVertices(renderer, verticesIdx, indicesIdx, bakeTransform, q[0], q[1], q[2], q[3]);
+}
+
+void SpriteSheet::bindInstance(const std::shared_ptr<Renderer> &renderer, int instanceIdx) {
+    Entity::bindInstance(renderer, instanceIdx);
+    if (!this->definition->isTrimmed() || !this->active) return;
+
+    float q[4];
+    this->getQuadRect(q);
+    float *m = this->renderer->matrix;
+    auto &instance = renderer->instances[instanceIdx];
+    instance.transform[0] = m[0] * q[2];
+    instance.transform[1] = m[1] * q[2];
+    instance.transform[2] = m[4] * q[3];
+    instance.transform[3] = m[5] * q[3];
+    instance.translate[0] = m[12] + m[0] * q[0] + m[4] * q[1];
+    instance.translate[1] = m[13] + m[1] * q[0] + m[5] * q[1];
+}
+
 void SpriteSheet::bindVertexTexCoords(const std::shared_ptr<Renderer> &renderer, int *idx, int texIdx, float x, float y, float w, float h) {
-    Size texSize = Size(this->textures[0]->width, this->textures[0]->height) / this->textures[0]->density.value;
-    x += this->rect.position.x / texSize.width;
-    y += this->rect.position.y / texSize.height;
-    
-    auto p = this->framePoints[this->frame];
-    x += (p.x / texSize.width) * w;
-    y += (p.y / texSize.height) * h;
-    w = (this->frameSize.width / texSize.width) * w;
-    h = (this->frameSize.height / texSize.height) * h;
-    
+    const float *uv = this->definition->getFrame(this->frame).uvRect;
+    x += uv[0] * w;
+    y += uv[1] * h;
+    w *= uv[2];
+    h *= uv[3];
+
     if (this->textures[0]->isFlip) {
         renderer->vertexTexCoords[texIdx][(*idx)++] = x;      renderer->vertexTexCoords[texIdx][(*idx)++] = y + h;
         renderer->vertexTexCoords[texIdx][(*idx)++] = x;      renderer->vertexTexCoords[texIdx][(*idx)++] = y;
         renderer->vertexTexCoords[texIdx][(*idx)++] = x + w;  renderer->vertexTexCoords[texIdx][(*idx)++] = y + h;
         renderer->vertexTexCoords[texIdx][(*idx)++] = x + w;  renderer->vertexTexCoords[texIdx][(*idx)++] = y;
-        
+
     } else {
         renderer->vertexTexCoords[texIdx][(*idx)++] = x;      renderer->vertexTexCoords[texIdx][(*idx)++] = y;
         renderer->vertexTexCoords[texIdx][(*idx)++] = x;      renderer->vertexTexCoords[texIdx][(*idx)++] = y + h;
@@ -219,7 +571,11 @@ std::shared_ptr<SpriteSheet> SpriteSheet::clone() {
 }
 
 std::shared_ptr<Entity> SpriteSheet::cloneEntity() {
-    auto spriteSheet = SpriteSheet::createWithTexture(this->textures[0], this->frameSize, this->frameCount, this->margin, this->rect);
+    auto spriteSheet = SpriteSheet::createWithDefinition(this->definition);
     spriteSheet->copyProperties(std::static_pointer_cast<Entity>(shared_from_this()));
     return spriteSheet;
 }
+
+bool SpriteSheet::isInstanceable() {
+    return true;
+}
@@ -1,21 +1,88 @@
 #ifndef SpriteSheet_h
 #define SpriteSheet_h
 
+#include <unordered_map>
 #include "mog/base/Sprite.h"
 #include "mog/core/Tween.h"
 
 namespace mog {
+    class SpriteSheetFrame {
+    public:
+        std::string name = "";
+        // in points of the texture
+        Rect rect = Rect::zero;
+        // x, y, width, height normalized to the texture
+        float uvRect[4] = {0, 0, 0, 0};
+        // placement of the trimmed rect inside the untrimmed frame, normalized to the frame size
+        float quadRect[4] = {0, 0, 1.0f, 1.0f};
+        Size sourceSize = Size::zero;
+    };
+
+    class SpriteSheetAnimation {
+    public:
+        std::string name = "";
+        std::vector<unsigned int> frames;
+        std::vector<float> timePerFrames;
+        LoopType loopType = LoopType::None;
+        int loopCount = 0;
+    };
+
+    class SpriteSheetDefinition {
+    public:
+        static std::shared_ptr<SpriteSheetDefinition> create(const std::shared_ptr<Texture2D> &texture, const Size &frameSize, unsigned int frameCount = 0, unsigned int margin = 0, const Rect &rect = Rect::zero);
+        static std::shared_ptr<SpriteSheetDefinition> createWithJson(std::string filename, float timePerFrame = 0.1f);
+        static std::shared_ptr<SpriteSheetDefinition> parse(std::string jsonText, const std::shared_ptr<Texture2D> &texture, float timePerFrame = 0.1f);
+        static std::shared_ptr<SpriteSheetDefinition> parse(const std::shared_ptr<Dictionary> &dict, const std::shared_ptr<Texture2D> &texture, float timePerFrame = 0.1f);
+
+        // animations are meant to be added while setting up, before the definition is shared
+        int addAnimation(std::string name, const std::vector<unsigned int> &frames, float timePerFrame, LoopType loopType = LoopType::None, int loopCount = 0);
+        int addAnimation(std::string name, const std::vector<unsigned int> &frames, const std::vector<float> &timePerFrames, LoopType loopType = LoopType::None, int loopCount = 0);
+
+        std::shared_ptr<Texture2D> getTexture() const;
+        Size getFrameSize() const;
+        unsigned int getMargin() const;
+        Rect getRect() const;
+        unsigned int getFrameCount() const;
+        const SpriteSheetFrame &getFrame(unsigned int frame) const;
+        int getFrameId(std::string name) const;
+        bool isTrimmed() const;
+        int getAnimationCount() const;
+        const SpriteSheetAnimation &getAnimation(int animationId) const;
+        int getAnimationId(std::string name) const;
+
+    protected:
+        SpriteSheetDefinition() {}
+
+        std::shared_ptr<Texture2D> texture;
+        Size frameSize = Size::zero;
+        unsigned int margin = 0;
+        Rect rect = Rect::zero;
+        bool trimmed = false;
+        std::vector<SpriteSheetFrame> frames;
+        std::vector<SpriteSheetAnimation> animations;
+        std::unordered_map<std::string, unsigned int> frameIds;
+        std::unordered_map<std::string, int> animationIds;
+
+        void addFrame(const SpriteSheetFrame &frame);
+    };
+
     class SpriteSheet : public Entity {
         friend class EntityCreator;
     public:
         static std::shared_ptr<SpriteSheet> create(std::string filename, const Size &frameSize, unsigned int frameCount = 0, unsigned int margin = 0, const Rect &rect = Rect::zero);
         static std::shared_ptr<SpriteSheet> createWithTexture(const std::shared_ptr<Texture2D> &texture, const Size &frameSize, unsigned int frameCount = 0, unsigned int margin = 0, const Rect &rect = Rect::zero);
         static std::shared_ptr<SpriteSheet> createWithSprite(const std::shared_ptr<Sprite> &sprite, const Size &frameSize, unsigned int frameCount = 0, unsigned int margin = 0);
+        static std::shared_ptr<SpriteSheet> createWithDefinition(const std::shared_ptr<SpriteSheetDefinition> &definition);
+        static std::shared_ptr<SpriteSheet> createWithAtlas(std::string filename, float timePerFrame = 0.1f);
         void selectFrame(unsigned int frame);
-        
+        void selectFrame(std::string name);
+
         virtual void updateFrame(const std::shared_ptr<Engine> &engine, float delta, float *parentMatrix, unsigned char parentDirtyFlag) override;
+        virtual void bindVertices(const std::shared_ptr<Renderer> &renderer, int *verticesIdx, int *indicesIdx, bool bakeTransform) override;
         virtual void bindVertexTexCoords(const std::shared_ptr<Renderer> &renderer, int *idx, int texIdx, float x, float y, float w, float h) override;
-        
+        virtual void bindInstance(const std::shared_ptr<Renderer> &renderer, int instanceIdx) override;
+
+        std::shared_ptr<SpriteSheetDefinition> getDefinition();
         unsigned int getCurrentFrame();
         unsigned int getFrameCount();
         unsigned int getMargin();
@@ -26,37 +93,42 @@ namespace mog {
 
         void startAnimation(float timePerFrame, LoopType loopType = LoopType::None, int loopCount = 0, int startFrame = 0, int endFrame = 0);
         void startAnimation(const std::vector<float> &timePerFrames, LoopType loopType = LoopType::None, int loopCount = 0, int startFrame = 0, int endFrame = 0);
+        void playAnimation(std::string name);
+        void playAnimation(int animationId);
         void stopAnimation();
+        bool isAnimating();
         void setOnFinishEvent(std::function<void(const std::shared_ptr<SpriteSheet> &spriteSheet)> onFinishEvent);
         std::shared_ptr<SpriteSheet> clone();
-        
+
     protected:
         SpriteSheet() {}
-        
+
         std::string filename = "";
-        unsigned int frame = 0;
-        unsigned int frameCount = 0;
         Size frameSize = Size::zero;
+        unsigned int frameCount = 0;
         unsigned int margin = 0;
         Rect rect = Rect::zero;
+        std::shared_ptr<SpriteSheetDefinition> definition;
+        unsigned int frame = 0;
 
-        std::vector<Point> framePoints;
-        std::vector<float> timePerFrames;
-        int startFrame = 0;
-        int endFrame = 0;
+        // -1 plays customAnimation, started with explicit timings
+        int animationId = -1;
+        std::shared_ptr<SpriteSheetAnimation> customAnimation;
         bool animating = false;
-        LoopType loopType = LoopType::None;
-        int loopCount = 0;
-        float tmpTime = 0;
+        float animationTime = 0;
+        int animationIndex = 0;
         int currentLoopCount = 0;
-        int nextFrame = 0;
         std::function<void(const std::shared_ptr<SpriteSheet> &spriteSheet)> onFinishEvent;
 
         void updateSpriteFrame(float delta);
+        const SpriteSheetAnimation &getCurrentAnimation();
+        void beginAnimation();
+        void getQuadRect(float *quadRect);
         virtual void init() override;
         void initWithTexture(const std::shared_ptr<Texture2D> &texture);
-        void initFrames(unsigned int frameCount, unsigned int margin);
+        void initWithDefinition(const std::shared_ptr<SpriteSheetDefinition> &definition);
         virtual std::shared_ptr<Entity> cloneEntity() override;
+        virtual bool isInstanceable() override;
     };
 }
 
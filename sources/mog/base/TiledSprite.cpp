@@ -71,8 +71,8 @@ void TiledSprite::bindVertex() {
         if (this->xCount != xCount || this->yCount != yCount) {
             this->xCount = xCount;
             this->yCount = yCount;
-            int vCount = this->xCount * this->yCount * 6 - 2;
-            this->initRendererVertices(vCount, vCount);
+            int tileCount = this->xCount * this->yCount;
+            this->initRendererVertices(tileCount * 4, tileCount * 6);
         }
 
         this->renderer->newVertexTexCoordsArr(0);
@@ -90,13 +90,7 @@ void TiledSprite::bindVertices(const std::shared_ptr<Renderer> &renderer, int *v
     }
     
     int startN = *verticesIdx / 2;
-    int ii = startN;
-    
-    if (startN > 0) {
-        renderer->indices[*indicesIdx] = renderer->indices[(*indicesIdx) - 1];
-        (*indicesIdx)++;
-        renderer->indices[(*indicesIdx)++] = 0 + startN;
-    }
+    short quadIndices[6] = {0, 1, 2, 2, 1, 3};
 
     float y0 = 0;
     float y1 = 0;
@@ -134,26 +128,14 @@ void TiledSprite::bindVertices(const std::shared_ptr<Renderer> &renderer, int *v
                 p3 = v1 * p3.x + v2 * p3.y + offset;
             }
             
-            if (yi > 0 || xi > 0) {
-                renderer->vertices[(*verticesIdx)] = renderer->vertices[(*verticesIdx)-2];
-                renderer->vertices[(*verticesIdx)+1] = renderer->vertices[(*verticesIdx)-1];
-                (*verticesIdx) += 2;
-
-                renderer->vertices[(*verticesIdx)++] = p0.x;    renderer->vertices[(*verticesIdx)++] = p0.y;
-                
-                renderer->indices[(*indicesIdx)++] = ii++;
-                renderer->indices[(*indicesIdx)++] = ii++;
-            }
-
             renderer->vertices[(*verticesIdx)++] = p0.x;    renderer->vertices[(*verticesIdx)++] = p0.y;
             renderer->vertices[(*verticesIdx)++] = p1.x;    renderer->vertices[(*verticesIdx)++] = p1.y;
             renderer->vertices[(*verticesIdx)++] = p2.x;    renderer->vertices[(*verticesIdx)++] = p2.y;
             renderer->vertices[(*verticesIdx)++] = p3.x;    renderer->vertices[(*verticesIdx)++] = p3.y;
             
-            renderer->indices[(*indicesIdx)++] = ii++;
-            renderer->indices[(*indicesIdx)++] = ii++;
-            renderer->indices[(*indicesIdx)++] = ii++;
-            renderer->indices[(*indicesIdx)++] = ii++;
+            if (indicesIdx) {
+                this->bindIndices(renderer, indicesIdx, startN + (yi * this->xCount + xi) * 4, quadIndices, 6);
+            }
         }
     }
 }
@@ -176,28 +158,12 @@ void TiledSprite::bindVertexTexCoords(const std::shared_ptr<Renderer> &renderer,
             if (ws > 1.0f) ws = 1.0f;
             
             if (this->textures[0]->isFlip) {
-                if (yi > 0 || xi > 0) {
-                    renderer->vertexTexCoords[texIdx][(*idx)] = renderer->vertexTexCoords[texIdx][(*idx)-2];
-                    renderer->vertexTexCoords[texIdx][(*idx)+1] = renderer->vertexTexCoords[texIdx][(*idx)-1];
-                    (*idx) += 2;
-                    
-                    renderer->vertexTexCoords[texIdx][(*idx)++] = _x;           renderer->vertexTexCoords[texIdx][(*idx)++] = _y + _h * hs;
-                }
-
                 renderer->vertexTexCoords[texIdx][(*idx)++] = _x;           renderer->vertexTexCoords[texIdx][(*idx)++] = _y + _h * hs;
                 renderer->vertexTexCoords[texIdx][(*idx)++] = _x;           renderer->vertexTexCoords[texIdx][(*idx)++] = _y;
                 renderer->vertexTexCoords[texIdx][(*idx)++] = _x + _w * ws; renderer->vertexTexCoords[texIdx][(*idx)++] = _y + _h * hs;
                 renderer->vertexTexCoords[texIdx][(*idx)++] = _x + _w * ws; renderer->vertexTexCoords[texIdx][(*idx)++] = _y;
                 
             } else {
-                if (yi > 0 || xi > 0) {
-                    renderer->vertexTexCoords[texIdx][(*idx)] = renderer->vertexTexCoords[texIdx][(*idx)-2];
-                    renderer->vertexTexCoords[texIdx][(*idx)+1] = renderer->vertexTexCoords[texIdx][(*idx)-1];
-                    (*idx) += 2;
-                    
-                    renderer->vertexTexCoords[texIdx][(*idx)++] = _x;           renderer->vertexTexCoords[texIdx][(*idx)++] = _y;
-                }
-
                 renderer->vertexTexCoords[texIdx][(*idx)++] = _x;           renderer->vertexTexCoords[texIdx][(*idx)++] = _y;
                 renderer->vertexTexCoords[texIdx][(*idx)++] = _x;           renderer->vertexTexCoords[texIdx][(*idx)++] = _y + _h * hs;
                 renderer->vertexTexCoords[texIdx][(*idx)++] = _x + _w * ws; renderer->vertexTexCoords[texIdx][(*idx)++] = _y;
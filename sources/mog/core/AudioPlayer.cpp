@@ -92,38 +92,40 @@ std::shared_ptr<AudioPlayer> AudioPlayer::create() {
     return audioPlayer;
 }
 
-std::shared_ptr<AudioChannel> AudioPlayer::createChannel(std::string key) {
+std::shared_ptr<AudioChannel> AudioPlayer::createChannel(const Symbol &key) {
     if (auto audioPlayer = instance.lock()) {
-        if (audioPlayer->channels[key]) {
-            return audioPlayer->channels[key];
+        auto &channel = audioPlayer->channels[key];
+        if (!channel) {
+            channel = AudioChannel::create(audioPlayer);
         }
-        auto channel = AudioChannel::create(audioPlayer);
-        audioPlayer->channels[key] = channel;
         return channel;
     }
     return nullptr;
 }
 
-std::shared_ptr<AudioChannel> AudioPlayer::getChannel(std::string key) {
+std::shared_ptr<AudioChannel> AudioPlayer::getChannel(const Symbol &key) {
     if (auto audioPlayer = instance.lock()) {
-        audioPlayer->channels[key];
+        auto it = audioPlayer->channels.find(key);
+        if (it != audioPlayer->channels.end()) {
+            return it->second;
+        }
     }
     return nullptr;
 }
 
-std::unordered_map<std::string, std::shared_ptr<AudioChannel>> AudioPlayer::getAllChannels() {
+std::unordered_map<Symbol, std::shared_ptr<AudioChannel>> AudioPlayer::getAllChannels() {
     if (auto audioPlayer = instance.lock()) {
         return audioPlayer->channels;
     }
-    return std::unordered_map<std::string, std::shared_ptr<AudioChannel>>();
+    return std::unordered_map<Symbol, std::shared_ptr<AudioChannel>>();
 }
 
-void AudioPlayer::removeChannel(std::string key) {
+void AudioPlayer::removeChannel(const Symbol &key) {
     if (auto audioPlayer = instance.lock()) {
-        auto channel = audioPlayer->channels[key];
-        if (channel) {
-            channel->close();
-            audioPlayer->channels.erase(key);
+        auto it = audioPlayer->channels.find(key);
+        if (it != audioPlayer->channels.end()) {
+            if (it->second) it->second->close();
+            audioPlayer->channels.erase(it);
         }
     }
 }
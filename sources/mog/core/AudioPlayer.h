@@ -6,6 +6,7 @@
 #include <vector>
 #include <functional>
 #include <memory>
+#include "mog/core/Symbol.h"
 
 namespace mog {
     
@@ -55,10 +56,10 @@ namespace mog {
         std::shared_ptr<AudioPlayerNative> audioPlayerNative;
         
         static std::shared_ptr<AudioPlayer> create();
-        static std::shared_ptr<AudioChannel> createChannel(std::string key);
-        static std::shared_ptr<AudioChannel> getChannel(std::string key);
-        static std::unordered_map<std::string, std::shared_ptr<AudioChannel>> getAllChannels();
-        static void removeChannel(std::string key);
+        static std::shared_ptr<AudioChannel> createChannel(const Symbol &key);
+        static std::shared_ptr<AudioChannel> getChannel(const Symbol &key);
+        static std::unordered_map<Symbol, std::shared_ptr<AudioChannel>> getAllChannels();
+        static void removeChannel(const Symbol &key);
 
         template<class First, class... Rest>
         static void preload(const First& first, const Rest&... rest) {
@@ -78,7 +79,7 @@ namespace mog {
 
         AudioPlayer() {}
 
-        std::unordered_map<std::string, std::shared_ptr<AudioChannel>> channels;
+        std::unordered_map<Symbol, std::shared_ptr<AudioChannel>> channels;
         std::vector<std::shared_ptr<AudioChannel>> poolOneShotChannels;
         std::vector<std::shared_ptr<AudioChannel>> resumeChannels;
     };
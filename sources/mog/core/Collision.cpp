@@ -1,7 +1,11 @@
 #include "mog/core/Collision.h"
 #include "mog/core/plain_objects.h"
 #include "mog/Constants.h"
+#include "mog/core/simd.h"
 #include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <float.h>
 
 using namespace mog;
 
@@ -41,6 +45,13 @@ const Vec2 Vec2::operator/(float v) const {
 }
 
 
+AABB::AABB() {
+    this->minX = 0;
+    this->minY = 0;
+    this->maxX = 0;
+    this->maxY = 0;
+}
+
 AABB::AABB(float minX, float minY, float maxX, float maxY) {
     this->minX = minX;
     this->minY = minY;
@@ -48,25 +59,34 @@ AABB::AABB(float minX, float minY, float maxX, float maxY) {
     this->maxY = maxY;
 }
 
+OBB::OBB() {
+    this->centerX = 0;
+    this->centerY = 0;
+}
+
 OBB::OBB(const Vec2 &vec1, const Vec2 &vec2, float centerX, float centerY) : vec1(vec1), vec2(vec2) {
     this->centerX = centerX;
     this->centerY = centerY;
 }
 
+CIRCLE::CIRCLE() {
+    this->center = Point::zero;
+    this->radius = 0;
+}
+
 CIRCLE::CIRCLE(float x, float y, float radius) {
     this->center = Point(x, y);
     this->radius = radius;
 }
 
+POLYGON::POLYGON() {
+}
+
 POLYGON::POLYGON(Point *points, int length) {
     this->points = points;
     this->length = length;
 }
 
-POLYGON::~POLYGON() {
-    mogfree(this->points);
-}
-
 Point POLYGON::getCentroid() {
     if (this->centroid.x != 0 || this->centroid.y != 0) {
         return this->centroid;
@@ -88,15 +108,14 @@ Point POLYGON::getCentroid() {
     return this->centroid;
 }
 
+POLYGONS::POLYGONS() {
+}
+
 POLYGONS::POLYGONS(POLYGON *polygons, int length) {
     this->polygons = polygons;
     this->length = length;
 }
 
-POLYGONS::~POLYGONS() {
-    mogfree(this->polygons);
-}
-
 Collider::Collider(ColliderShape shape) {
     this->shape = shape;
 }
@@ -104,82 +123,82 @@ Collider::Collider(ColliderShape shape) {
 Point Collider::getCentroid() {
     switch (this->shape) {
         case ColliderShape::Rect:
-            return Point(this->obb->centerX, this->obb->centerY);
+            return Point(this->obb.centerX, this->obb.centerY);
         case ColliderShape::Circle:
-            return this->circle->center;
+            return this->circle.center;
         case ColliderShape::Polygon:
-            return this->polygon->getCentroid();
+            return this->polygon.getCentroid();
         case ColliderShape::Polygons:
         default:
             return Point::zero;
     }
 }
 
-bool Collision::collides(const std::shared_ptr<Collider> &col1, const std::shared_ptr<Collider> &col2) {
-    if (!Collision::aabb_aabb(*col1->aabb.get(), *col2->aabb.get())) return false;
+bool Collision::collides(const Collider &col1, const Collider &col2) {
+    if (!Collision::aabb_aabb(col1.aabb, col2.aabb)) return false;
     
-    switch (col1->shape) {
+    switch (col1.shape) {
         case ColliderShape::Rect:
-            switch (col2->shape) {
+            switch (col2.shape) {
                 case ColliderShape::Rect:
-                    return Collision::obb_obb(*col1->obb.get(), *col2->obb.get());
+                    return Collision::obb_obb(col1.obb, col2.obb);
                 case ColliderShape::Circle:
-                    return Collision::obb_circle(*col1->obb.get(), *col2->circle.get());
+                    return Collision::obb_circle(col1.obb, col2.circle);
                 case ColliderShape::Polygon:
-                    return Collision::obb_polygon(*col1->obb.get(), *col2->polygon.get());
+                    return Collision::obb_polygon(col1.obb, col2.polygon);
                 case ColliderShape::Polygons:
-                    return Collision::obb_polygons(*col1->obb.get(), *col2->polygons.get());
+                    return Collision::obb_polygons(col1.obb, col2.polygons);
             }
         case ColliderShape::Circle:
-            switch (col2->shape) {
+            switch (col2.shape) {
                 case ColliderShape::Rect:
-                    return Collision::obb_circle(*col2->obb.get(), *col1->circle.get());
+                    return Collision::obb_circle(col2.obb, col1.circle);
                 case ColliderShape::Circle:
-                    return Collision::circle_circle(*col1->circle.get(), *col2->circle.get());
+                    return Collision::circle_circle(col1.circle, col2.circle);
                 case ColliderShape::Polygon:
-                    return Collision::circle_polygon(*col1->circle.get(), *col2->polygon.get());
+                    return Collision::circle_polygon(col1.circle, col2.polygon);
                 case ColliderShape::Polygons:
-                    return Collision::circle_polygons(*col1->circle.get(), *col2->polygons.get());
+                    return Collision::circle_polygons(col1.circle, col2.polygons);
             }
         case ColliderShape::Polygon:
-            switch (col2->shape) {
+            switch (col2.shape) {
                 case ColliderShape::Rect:
-                    return Collision::obb_polygon(*col2->obb.get(), *col1->polygon.get());
+                    return Collision::obb_polygon(col2.obb, col1.polygon);
                 case ColliderShape::Circle:
-                    return Collision::circle_polygon(*col2->circle.get(), *col1->polygon.get());
+                    return Collision::circle_polygon(col2.circle, col1.polygon);
                 case ColliderShape::Polygon:
-                    return Collision::polygon_polygon(*col1->polygon.get(), *col2->polygon.get());
+                    return Collision::polygon_polygon(col1.polygon, col2.polygon);
                 case ColliderShape::Polygons:
-                    return Collision::polygon_polygons(*col1->polygon.get(), *col2->polygons.get());
+                    return Collision::polygon_polygons(col1.polygon, col2.polygons);
             }
         case ColliderShape::Polygons:
-            switch (col2->shape) {
+            switch (col2.shape) {
                 case ColliderShape::Rect:
-                    return Collision::obb_polygons(*col2->obb.get(), *col1->polygons.get());
+                    return Collision::obb_polygons(col2.obb, col1.polygons);
                 case ColliderShape::Circle:
-                    return Collision::circle_polygons(*col2->circle.get(), *col1->polygons.get());
+                    return Collision::circle_polygons(col2.circle, col1.polygons);
                 case ColliderShape::Polygon:
-                    return Collision::polygon_polygons(*col2->polygon.get(), *col1->polygons.get());
+                    return Collision::polygon_polygons(col2.polygon, col1.polygons);
                 case ColliderShape::Polygons:
-                    return Collision::polygons_polygons(*col1->polygons.get(), *col2->polygons.get());
+                    return Collision::polygons_polygons(col1.polygons, col2.polygons);
             }
     }
     return false;
 }
 
-bool Collision::collides(const std::shared_ptr<Collider> &col, const Point &p) {
-    if (!Collision::aabb_point(*col->aabb.get(), p)) return false;
+bool Collision::collides(const Collider &col, const Point &p) {
+    if (!Collision::aabb_point(col.aabb, p)) return false;
     
-    switch (col->shape) {
+    switch (col.shape) {
         case ColliderShape::Rect:
-            if (fabs(col->obb->vec1.y) < 0.000001) return true;
-            return Collision::obb_point(*col->obb.get(), p);
+            if (fabs(col.obb.vec1.y) < 0.000001) return true;
+            return Collision::obb_point(col.obb, p);
         case ColliderShape::Circle:
-            return circle_point(*col->circle, p);
+            return circle_point(col.circle, p);
         case ColliderShape::Polygon:
-            return polygon_point(*col->polygon, p);
+            return polygon_point(col.polygon, p);
         case ColliderShape::Polygons:
-            return polygons_point(*col->polygons, p);
+            return polygons_point(col.polygons, p);
     }
     return false;
 }
@@ -223,7 +242,7 @@ bool Collision::obb_obb(const OBB &obb1, const OBB &obb2) {
     return true;
 }
 
-static POLYGON obb_to_polygon(const OBB &obb) {
+static POLYGON obb_to_polygon(const OBB &obb, Point *points) {
     float x1 = obb.centerX - obb.vec1.x * obb.vec1.vLen - obb.vec2.x * obb.vec2.vLen;
     float y1 = obb.centerY - obb.vec1.y * obb.vec1.vLen - obb.vec2.y * obb.vec2.vLen;
     float x2 = x1 + obb.vec1.x * obb.vec1.vLen * 2.0f;
@@ -232,7 +251,6 @@ static POLYGON obb_to_polygon(const OBB &obb) {
     float y3 = y2 + obb.vec2.y * obb.vec2.vLen * 2.0f;
     float x4 = x3 + obb.vec1.x * obb.vec1.vLen * -2.0f;
     float y4 = y3 + obb.vec1.y * obb.vec1.vLen * -2.0f;
-    Point *points = (Point *)mogmalloc(sizeof(Point) * 3);
     points[0] = Point(x1, y1);
     points[1] = Point(x2, y2);
     points[2] = Point(x3, y3);
@@ -241,12 +259,14 @@ static POLYGON obb_to_polygon(const OBB &obb) {
 }
 
 bool Collision::obb_circle(const OBB &obb, const CIRCLE &circle) {
-    POLYGON polygon1 = obb_to_polygon(obb);
+    Point points[4];
+    POLYGON polygon1 = obb_to_polygon(obb, points);
     return Collision::circle_polygon(circle, polygon1);
 }
 
 bool Collision::obb_polygon(const OBB &obb, const POLYGON &polygon) {
-    POLYGON polygon1 = obb_to_polygon(obb);
+    Point points[4];
+    POLYGON polygon1 = obb_to_polygon(obb, points);
     return Collision::polygon_polygon(polygon1, polygon);
 }
 
@@ -260,7 +280,8 @@ bool Collision::obb_polygons(const OBB &obb, const POLYGONS &polygons) {
 }
 
 bool Collision::obb_point(const OBB &obb, const Point &p) {
-    POLYGON polygon = obb_to_polygon(obb);
+    Point points[4];
+    POLYGON polygon = obb_to_polygon(obb, points);
     return polygon_point(polygon, p);
 }
 
@@ -438,3 +459,563 @@ bool Collision::polygons_point(const POLYGONS &polygons, const Point &p) {
     }
     return false;
 }
+
+
+void CircleBatch::add(const CIRCLE &circle) {
+    this->centerX.emplace_back(circle.center.x);
+    this->centerY.emplace_back(circle.center.y);
+    this->radius.emplace_back(circle.radius);
+}
+
+void CircleBatch::clear() {
+    this->centerX.clear();
+    this->centerY.clear();
+    this->radius.clear();
+}
+
+void CircleBatch::reserve(int size) {
+    this->centerX.reserve(size);
+    this->centerY.reserve(size);
+    this->radius.reserve(size);
+}
+
+int CircleBatch::size() const {
+    return (int)this->centerX.size();
+}
+
+void OBBBatch::add(const OBB &obb) {
+    this->centerX.emplace_back(obb.centerX);
+    this->centerY.emplace_back(obb.centerY);
+    this->axis1X.emplace_back(obb.vec1.x);
+    this->axis1Y.emplace_back(obb.vec1.y);
+    this->extent1.emplace_back(obb.vec1.vLen);
+    this->axis2X.emplace_back(obb.vec2.x);
+    this->axis2Y.emplace_back(obb.vec2.y);
+    this->extent2.emplace_back(obb.vec2.vLen);
+}
+
+void OBBBatch::clear() {
+    this->centerX.clear();
+    this->centerY.clear();
+    this->axis1X.clear();
+    this->axis1Y.clear();
+    this->extent1.clear();
+    this->axis2X.clear();
+    this->axis2Y.clear();
+    this->extent2.clear();
+}
+
+void OBBBatch::reserve(int size) {
+    this->centerX.reserve(size);
+    this->centerY.reserve(size);
+    this->axis1X.reserve(size);
+    this->axis1Y.reserve(size);
+    this->extent1.reserve(size);
+    this->axis2X.reserve(size);
+    this->axis2Y.reserve(size);
+    this->extent2.reserve(size);
+}
+
+int OBBBatch::size() const {
+    return (int)this->centerX.size();
+}
+
+static const int bitCount4[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+static int setHitBits(unsigned int *hitMask, int idx, int bits) {
+    hitMask[idx >> 5] |= ((unsigned int)bits << (idx & 31));
+    return bitCount4[bits & 0xF];
+}
+
+static int appendHitPairs(const unsigned int *hitMask, int size, int idx, std::vector<std::pair<int, int>> &pairs) {
+    int hits = 0;
+    for (int w = 0; w < Collision::getHitMaskLength(size); w++) {
+        unsigned int bits = hitMask[w];
+        while (bits) {
+            int b = 0;
+            while (((bits >> b) & 1) == 0) b++;
+            pairs.emplace_back(std::make_pair(idx, w * 32 + b));
+            bits &= bits - 1;
+            hits++;
+        }
+    }
+    return hits;
+}
+
+int Collision::getHitMaskLength(int size) {
+    return (size + 31) / 32;
+}
+
+bool Collision::isHit(const unsigned int *hitMask, int idx) {
+    return ((hitMask[idx >> 5] >> (idx & 31)) & 1) == 1;
+}
+
+int Collision::circle_circles(const CIRCLE &circle, const CircleBatch &circles, unsigned int *hitMask) {
+    using namespace simd;
+    int n = circles.size();
+    memset(hitMask, 0, sizeof(unsigned int) * getHitMaskLength(n));
+    const float *cx = circles.centerX.data();
+    const float *cy = circles.centerY.data();
+    const float *cr = circles.radius.data();
+    int hits = 0;
+    int i = 0;
+
+    f32x4 px = set4(circle.center.x);
+    f32x4 py = set4(circle.center.y);
+    f32x4 pr = set4(circle.radius);
+    for (; i + 4 <= n; i += 4) {
+        f32x4 dx = sub4(load4(cx + i), px);
+        f32x4 dy = sub4(load4(cy + i), py);
+        f32x4 r = add4(load4(cr + i), pr);
+        int bits = lessEqualMask4(add4(mul4(dx, dx), mul4(dy, dy)), mul4(r, r));
+        hits += setHitBits(hitMask, i, bits);
+    }
+    for (; i < n; i++) {
+        float dx = cx[i] - circle.center.x;
+        float dy = cy[i] - circle.center.y;
+        float r = cr[i] + circle.radius;
+        if (dx * dx + dy * dy <= r * r) {
+            hits += setHitBits(hitMask, i, 1);
+        }
+    }
+    return hits;
+}
+
+int Collision::obb_circles(const OBB &obb, const CircleBatch &circles, unsigned int *hitMask) {
+    using namespace simd;
+    int n = circles.size();
+    memset(hitMask, 0, sizeof(unsigned int) * getHitMaskLength(n));
+    const float *cx = circles.centerX.data();
+    const float *cy = circles.centerY.data();
+    const float *cr = circles.radius.data();
+    int hits = 0;
+    int i = 0;
+
+    // the circle center is moved into the box frame and clamped to the box extents
+    f32x4 ox = set4(obb.centerX);
+    f32x4 oy = set4(obb.centerY);
+    f32x4 ux = set4(obb.vec1.x);
+    f32x4 uy = set4(obb.vec1.y);
+    f32x4 vx = set4(obb.vec2.x);
+    f32x4 vy = set4(obb.vec2.y);
+    f32x4 e1 = set4(obb.vec1.vLen);
+    f32x4 e2 = set4(obb.vec2.vLen);
+    f32x4 ne1 = set4(-obb.vec1.vLen);
+    f32x4 ne2 = set4(-obb.vec2.vLen);
+    for (; i + 4 <= n; i += 4) {
+        f32x4 dx = sub4(load4(cx + i), ox);
+        f32x4 dy = sub4(load4(cy + i), oy);
+        f32x4 lx = add4(mul4(dx, ux), mul4(dy, uy));
+        f32x4 ly = add4(mul4(dx, vx), mul4(dy, vy));
+        f32x4 qx = sub4(lx, min4(max4(lx, ne1), e1));
+        f32x4 qy = sub4(ly, min4(max4(ly, ne2), e2));
+        f32x4 r = load4(cr + i);
+        int bits = lessEqualMask4(add4(mul4(qx, qx), mul4(qy, qy)), mul4(r, r));
+        hits += setHitBits(hitMask, i, bits);
+    }
+    for (; i < n; i++) {
+        float dx = cx[i] - obb.centerX;
+        float dy = cy[i] - obb.centerY;
+        float lx = dx * obb.vec1.x + dy * obb.vec1.y;
+        float ly = dx * obb.vec2.x + dy * obb.vec2.y;
+        float qx = lx - fmin(fmax(lx, -obb.vec1.vLen), obb.vec1.vLen);
+        float qy = ly - fmin(fmax(ly, -obb.vec2.vLen), obb.vec2.vLen);
+        if (qx * qx + qy * qy <= cr[i] * cr[i]) {
+            hits += setHitBits(hitMask, i, 1);
+        }
+    }
+    return hits;
+}
+
+int Collision::obb_obbs(const OBB &obb, const OBBBatch &obbs, unsigned int *hitMask) {
+    using namespace simd;
+    int n = obbs.size();
+    memset(hitMask, 0, sizeof(unsigned int) * getHitMaskLength(n));
+    const float *cx = obbs.centerX.data();
+    const float *cy = obbs.centerY.data();
+    const float *bux = obbs.axis1X.data();
+    const float *buy = obbs.axis1Y.data();
+    const float *be1 = obbs.extent1.data();
+    const float *bvx = obbs.axis2X.data();
+    const float *bvy = obbs.axis2Y.data();
+    const float *be2 = obbs.extent2.data();
+    float aux = obb.vec1.x, auy = obb.vec1.y, ae1 = obb.vec1.vLen;
+    float avx = obb.vec2.x, avy = obb.vec2.y, ae2 = obb.vec2.vLen;
+    int hits = 0;
+    int i = 0;
+
+    // separating axis test on the two axes of each box; the boxes overlap when no axis separates them
+    f32x4 ox = set4(obb.centerX);
+    f32x4 oy = set4(obb.centerY);
+    f32x4 ux = set4(aux), uy = set4(auy), e1 = set4(ae1);
+    f32x4 vx = set4(avx), vy = set4(avy), e2 = set4(ae2);
+    for (; i + 4 <= n; i += 4) {
+        f32x4 dx = sub4(load4(cx + i), ox);
+        f32x4 dy = sub4(load4(cy + i), oy);
+        f32x4 px = load4(bux + i), py = load4(buy + i), pe = load4(be1 + i);
+        f32x4 qx = load4(bvx + i), qy = load4(bvy + i), qe = load4(be2 + i);
+
+        f32x4 uu = abs4(add4(mul4(ux, px), mul4(uy, py)));
+        f32x4 uv = abs4(add4(mul4(ux, qx), mul4(uy, qy)));
+        f32x4 vu = abs4(add4(mul4(vx, px), mul4(vy, py)));
+        f32x4 vv = abs4(add4(mul4(vx, qx), mul4(vy, qy)));
+
+        f32x4 l1 = abs4(add4(mul4(dx, ux), mul4(dy, uy)));
+        f32x4 r1 = add4(e1, add4(mul4(pe, uu), mul4(qe, uv)));
+        f32x4 l2 = abs4(add4(mul4(dx, vx), mul4(dy, vy)));
+        f32x4 r2 = add4(e2, add4(mul4(pe, vu), mul4(qe, vv)));
+        f32x4 l3 = abs4(add4(mul4(dx, px), mul4(dy, py)));
+        f32x4 r3 = add4(pe, add4(mul4(e1, uu), mul4(e2, vu)));
+        f32x4 l4 = abs4(add4(mul4(dx, qx), mul4(dy, qy)));
+        f32x4 r4 = add4(qe, add4(mul4(e1, uv), mul4(e2, vv)));
+
+        int bits = lessMask4(l1, r1) & lessMask4(l2, r2) & lessMask4(l3, r3) & lessMask4(l4, r4);
+        hits += setHitBits(hitMask, i, bits);
+    }
+    for (; i < n; i++) {
+        float dx = cx[i] - obb.centerX;
+        float dy = cy[i] - obb.centerY;
+        float uu = fabs(aux * bux[i] + auy * buy[i]);
+        float uv = fabs(aux * bvx[i] + auy * bvy[i]);
+        float vu = fabs(avx * bux[i] + avy * buy[i]);
+        float vv = fabs(avx * bvx[i] + avy * bvy[i]);
+        if (fabs(dx * aux + dy * auy) >= ae1 + be1[i] * uu + be2[i] * uv) continue;
+        if (fabs(dx * avx + dy * avy) >= ae2 + be1[i] * vu + be2[i] * vv) continue;
+        if (fabs(dx * bux[i] + dy * buy[i]) >= be1[i] + ae1 * uu + ae2 * vu) continue;
+        if (fabs(dx * bvx[i] + dy * bvy[i]) >= be2[i] + ae1 * uv + ae2 * vv) continue;
+        hits += setHitBits(hitMask, i, 1);
+    }
+    return hits;
+}
+
+int Collision::circles_circles(const CircleBatch &circles1, const CircleBatch &circles2, std::vector<std::pair<int, int>> &pairs) {
+    std::vector<unsigned int> hitMask(getHitMaskLength(circles2.size()));
+    int hits = 0;
+    for (int i = 0; i < circles1.size(); i++) {
+        CIRCLE circle(circles1.centerX[i], circles1.centerY[i], circles1.radius[i]);
+        if (Collision::circle_circles(circle, circles2, hitMask.data()) > 0) {
+            hits += appendHitPairs(hitMask.data(), circles2.size(), i, pairs);
+        }
+    }
+    return hits;
+}
+
+int Collision::obbs_circles(const OBBBatch &obbs, const CircleBatch &circles, std::vector<std::pair<int, int>> &pairs) {
+    std::vector<unsigned int> hitMask(getHitMaskLength(circles.size()));
+    int hits = 0;
+    for (int i = 0; i < obbs.size(); i++) {
+        OBB obb(Vec2(obbs.axis1X[i], obbs.axis1Y[i], obbs.extent1[i]),
+                Vec2(obbs.axis2X[i], obbs.axis2Y[i], obbs.extent2[i]),
+                obbs.centerX[i], obbs.centerY[i]);
+        if (Collision::obb_circles(obb, circles, hitMask.data()) > 0) {
+            hits += appendHitPairs(hitMask.data(), circles.size(), i, pairs);
+        }
+    }
+    return hits;
+}
+
+int Collision::obbs_obbs(const OBBBatch &obbs1, const OBBBatch &obbs2, std::vector<std::pair<int, int>> &pairs) {
+    std::vector<unsigned int> hitMask(getHitMaskLength(obbs2.size()));
+    int hits = 0;
+    for (int i = 0; i < obbs1.size(); i++) {
+        OBB obb(Vec2(obbs1.axis1X[i], obbs1.axis1Y[i], obbs1.extent1[i]),
+                Vec2(obbs1.axis2X[i], obbs1.axis2Y[i], obbs1.extent2[i]),
+                obbs1.centerX[i], obbs1.centerY[i]);
+        if (Collision::obb_obbs(obb, obbs2, hitMask.data()) > 0) {
+            hits += appendHitPairs(hitMask.data(), obbs2.size(), i, pairs);
+        }
+    }
+    return hits;
+}
+
+
+static bool normalizeDirection(const Point &direction, Point *dir) {
+    float len = sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (len < 0.000001f) return false;
+    *dir = Point(direction.x / len, direction.y / len);
+    return true;
+}
+
+static void setRaycastHit(RaycastHit *hit, float distance, const Point &origin, const Point &dir, const Point &normal) {
+    if (!hit) return;
+    hit->distance = distance;
+    hit->point = origin + dir * distance;
+    hit->normal = normal;
+}
+
+static float getPolygonOrientation(const Point *points, int length) {
+    float area = 0;
+    for (int i = 0; i < length; i++) {
+        const Point &p1 = points[i];
+        const Point &p2 = points[(i + 1) % length];
+        area += p1.x * p2.y - p2.x * p1.y;
+    }
+    return (area < 0) ? -1.0f : 1.0f;
+}
+
+static Point getOutwardNormal(const Point &p1, const Point &p2, float orientation) {
+    Point e = p2 - p1;
+    return Point::normalize(Point(e.y * orientation, -e.x * orientation));
+}
+
+static bool rayCircle(const Point &center, float radius, const Point &origin, const Point &dir, float maxDistance, RaycastHit *hit) {
+    Point m = origin - center;
+    float c = Point::dot(m, m) - radius * radius;
+    if (c <= 0) {
+        setRaycastHit(hit, 0, origin, dir, dir * -1.0f);
+        return true;
+    }
+    float b = Point::dot(m, dir);
+    if (b > 0) return false;
+    float disc = b * b - c;
+    if (disc < 0) return false;
+    float t = -b - sqrt(disc);
+    if (t > maxDistance) return false;
+    t = fmax(t, 0);
+    setRaycastHit(hit, t, origin, dir, (origin + dir * t - center) / radius);
+    return true;
+}
+
+// Cyrus-Beck clipping against a convex polygon
+static bool rayConvex(const Point *points, int length, const Point &origin, const Point &dir, float maxDistance, RaycastHit *hit) {
+    if (length < 3) return false;
+    float orientation = getPolygonOrientation(points, length);
+    float tEnter = -FLT_MAX;
+    float tExit = maxDistance;
+    Point enterNormal = Point::zero;
+    for (int i = 0; i < length; i++) {
+        const Point &p1 = points[i];
+        const Point &p2 = points[(i + 1) % length];
+        Point n = getOutwardNormal(p1, p2, orientation);
+        float num = Point::dot(n, p1 - origin);
+        float den = Point::dot(n, dir);
+        if (fabs(den) < 0.000001f) {
+            if (num < 0) return false;
+            continue;
+        }
+        float t = num / den;
+        if (den < 0) {
+            if (t > tEnter) {
+                tEnter = t;
+                enterNormal = n;
+            }
+        } else {
+            tExit = fmin(tExit, t);
+        }
+        if (tEnter > tExit) return false;
+    }
+    if (tExit < 0) return false;
+    if (tEnter < 0) {
+        setRaycastHit(hit, 0, origin, dir, dir * -1.0f);
+    } else {
+        setRaycastHit(hit, tEnter, origin, dir, enterNormal);
+    }
+    return true;
+}
+
+static bool raySegment(const Point &p1, const Point &p2, const Point &origin, const Point &dir, float maxDistance, float *t) {
+    Point e = p2 - p1;
+    float denom = Point::cross(dir, e);
+    if (fabs(denom) < 0.000001f) return false;
+    Point w = p1 - origin;
+    float tt = Point::cross(w, e) / denom;
+    float u = Point::cross(w, dir) / denom;
+    if (tt < 0 || tt > maxDistance || u < 0 || u > 1.0f) return false;
+    *t = tt;
+    return true;
+}
+
+// ray against a convex polygon inflated by radius (a moving circle against the polygon)
+static bool rayRoundedConvex(const Point *points, int length, float radius, const Point &origin, const Point &dir, float maxDistance, RaycastHit *hit) {
+    if (radius <= 0) return rayConvex(points, length, origin, dir, maxDistance, hit);
+    if (Collision::circle_polygon(CIRCLE(origin.x, origin.y, radius), POLYGON(const_cast<Point *>(points), length))) {
+        setRaycastHit(hit, 0, origin, dir, dir * -1.0f);
+        return true;
+    }
+    float orientation = getPolygonOrientation(points, length);
+    bool found = false;
+    float best = maxDistance;
+    Point bestNormal = Point::zero;
+    for (int i = 0; i < length; i++) {
+        const Point &p1 = points[i];
+        const Point &p2 = points[(i + 1) % length];
+        Point n = getOutwardNormal(p1, p2, orientation);
+        float t;
+        if (Point::dot(n, dir) < 0 && raySegment(p1 + n * radius, p2 + n * radius, origin, dir, best, &t)) {
+            best = t;
+            bestNormal = n;
+            found = true;
+        }
+        RaycastHit circleHit;
+        if (rayCircle(p1, radius, origin, dir, best, &circleHit) && circleHit.distance <= best) {
+            best = circleHit.distance;
+            bestNormal = circleHit.normal;
+            found = true;
+        }
+    }
+    if (!found) return false;
+    setRaycastHit(hit, best, origin, dir, bestNormal);
+    return true;
+}
+
+static Point *obbToPoints(const OBB &obb, Point *points) {
+    obb_to_polygon(obb, points);
+    return points;
+}
+
+static Point *aabbToPoints(const AABB &aabb, Point *points) {
+    points[0] = Point(aabb.minX, aabb.minY);
+    points[1] = Point(aabb.maxX, aabb.minY);
+    points[2] = Point(aabb.maxX, aabb.maxY);
+    points[3] = Point(aabb.minX, aabb.maxY);
+    return points;
+}
+
+static void getConvexHull(std::vector<Point> &points, std::vector<Point> &hull) {
+    std::sort(points.begin(), points.end(), [](const Point &p1, const Point &p2) {
+        return (p1.x < p2.x) || (p1.x == p2.x && p1.y < p2.y);
+    });
+    int n = (int)points.size();
+    hull.resize(n * 2);
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        while (k >= 2 && Point::cross(hull[k - 1] - hull[k - 2], points[i] - hull[k - 2]) <= 0) k--;
+        hull[k++] = points[i];
+    }
+    for (int i = n - 2, lower = k + 1; i >= 0; i--) {
+        while (k >= lower && Point::cross(hull[k - 1] - hull[k - 2], points[i] - hull[k - 2]) <= 0) k--;
+        hull[k++] = points[i];
+    }
+    hull.resize(std::max(k - 1, 0));
+}
+
+// a moving box hits a convex polygon when its center enters the polygon grown by the box (Minkowski sum)
+static bool sweepOBBConvex(const OBB &obb, const Point *points, int length, const Point &dir, float maxDistance, RaycastHit *hit) {
+    Point corners[4];
+    obbToPoints(obb, corners);
+    Point center = Point(obb.centerX, obb.centerY);
+    std::vector<Point> sums;
+    sums.reserve(length * 4);
+    for (int i = 0; i < length; i++) {
+        for (int j = 0; j < 4; j++) {
+            sums.emplace_back(points[i] - (corners[j] - center));
+        }
+    }
+    std::vector<Point> hull;
+    getConvexHull(sums, hull);
+    return rayConvex(hull.data(), (int)hull.size(), center, dir, maxDistance, hit);
+}
+
+bool Collision::ray_aabb(const AABB &aabb, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit) {
+    Point dir;
+    if (!normalizeDirection(direction, &dir)) return false;
+    Point points[4];
+    return rayConvex(aabbToPoints(aabb, points), 4, origin, dir, maxDistance, hit);
+}
+
+bool Collision::ray_obb(const OBB &obb, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit) {
+    Point dir;
+    if (!normalizeDirection(direction, &dir)) return false;
+    Point points[4];
+    return rayConvex(obbToPoints(obb, points), 4, origin, dir, maxDistance, hit);
+}
+
+bool Collision::ray_circle(const CIRCLE &circle, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit) {
+    Point dir;
+    if (!normalizeDirection(direction, &dir)) return false;
+    return rayCircle(circle.center, circle.radius, origin, dir, maxDistance, hit);
+}
+
+bool Collision::ray_polygon(const POLYGON &polygon, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit) {
+    Point dir;
+    if (!normalizeDirection(direction, &dir)) return false;
+    return rayConvex(polygon.points, polygon.length, origin, dir, maxDistance, hit);
+}
+
+bool Collision::ray_polygons(const POLYGONS &polygons, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit) {
+    bool found = false;
+    RaycastHit polygonHit;
+    for (int i = 0; i < polygons.length; i++) {
+        if (Collision::ray_polygon(polygons.polygons[i], origin, direction, maxDistance, &polygonHit)) {
+            maxDistance = polygonHit.distance;
+            if (hit) *hit = polygonHit;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool Collision::raycast(const Collider &col, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit) {
+    switch (col.shape) {
+        case ColliderShape::Rect:
+            return Collision::ray_obb(col.obb, origin, direction, maxDistance, hit);
+        case ColliderShape::Circle:
+            return Collision::ray_circle(col.circle, origin, direction, maxDistance, hit);
+        case ColliderShape::Polygon:
+            return Collision::ray_polygon(col.polygon, origin, direction, maxDistance, hit);
+        case ColliderShape::Polygons:
+            return Collision::ray_polygons(col.polygons, origin, direction, maxDistance, hit);
+    }
+    return false;
+}
+
+bool Collision::sweep(const Collider &col, const CIRCLE &circle, const Point &direction, float maxDistance, RaycastHit *hit) {
+    Point dir;
+    if (!normalizeDirection(direction, &dir)) return false;
+    Point points[4];
+    switch (col.shape) {
+        case ColliderShape::Rect:
+            return rayRoundedConvex(obbToPoints(col.obb, points), 4, circle.radius, circle.center, dir, maxDistance, hit);
+        case ColliderShape::Circle:
+            return rayCircle(col.circle.center, col.circle.radius + circle.radius, circle.center, dir, maxDistance, hit);
+        case ColliderShape::Polygon:
+            return rayRoundedConvex(col.polygon.points, col.polygon.length, circle.radius, circle.center, dir, maxDistance, hit);
+        case ColliderShape::Polygons: {
+            bool found = false;
+            RaycastHit polygonHit;
+            for (int i = 0; i < col.polygons.length; i++) {
+                const auto &polygon = col.polygons.polygons[i];
+                if (rayRoundedConvex(polygon.points, polygon.length, circle.radius, circle.center, dir, maxDistance, &polygonHit)) {
+                    maxDistance = polygonHit.distance;
+                    if (hit) *hit = polygonHit;
+                    found = true;
+                }
+            }
+            return found;
+        }
+    }
+    return false;
+}
+
+bool Collision::sweep(const Collider &col, const OBB &obb, const Point &direction, float maxDistance, RaycastHit *hit) {
+    Point dir;
+    if (!normalizeDirection(direction, &dir)) return false;
+    Point points[4];
+    switch (col.shape) {
+        case ColliderShape::Rect:
+            return sweepOBBConvex(obb, obbToPoints(col.obb, points), 4, dir, maxDistance, hit);
+        case ColliderShape::Circle: {
+            // the circle moving backwards against the box gives the same time of contact
+            RaycastHit circleHit;
+            if (!rayRoundedConvex(obbToPoints(obb, points), 4, col.circle.radius, col.circle.center, dir * -1.0f, maxDistance, &circleHit)) return false;
+            setRaycastHit(hit, circleHit.distance, Point(obb.centerX, obb.centerY), dir, circleHit.normal * -1.0f);
+            return true;
+        }
+        case ColliderShape::Polygon:
+            return sweepOBBConvex(obb, col.polygon.points, col.polygon.length, dir, maxDistance, hit);
+        case ColliderShape::Polygons: {
+            bool found = false;
+            RaycastHit polygonHit;
+            for (int i = 0; i < col.polygons.length; i++) {
+                const auto &polygon = col.polygons.polygons[i];
+                if (sweepOBBConvex(obb, polygon.points, polygon.length, dir, maxDistance, &polygonHit)) {
+                    maxDistance = polygonHit.distance;
+                    if (hit) *hit = polygonHit;
+                    found = true;
+                }
+            }
+            return found;
+        }
+    }
+    return false;
+}
@@ -5,6 +5,7 @@
 #include "mog/core/Transform.h"
 #include <memory>
 #include <array>
+#include <vector>
 
 namespace mog {
     class Entity;
@@ -38,6 +39,7 @@ namespace mog {
         float minY;
         float maxY;
         
+        AABB();
         AABB(float minX, float minY, float maxX, float maxY);
     };
     
@@ -49,6 +51,7 @@ namespace mog {
         float centerX;
         float centerY;
         
+        OBB();
         OBB(const Vec2 &vec1, const Vec2 &vec2, float centerX, float centerY);
     };
     
@@ -57,8 +60,8 @@ namespace mog {
     public:
         Point *points = nullptr;
         int length = 0;
+        POLYGON();
         POLYGON(Point *points, int length);
-        ~POLYGON();
         Point getCentroid();
         
     private:
@@ -71,8 +74,8 @@ namespace mog {
         POLYGON *polygons = nullptr;
         int length = 0;
         Point centroid;
+        POLYGONS();
         POLYGONS(POLYGON *polygons, int length);
-        ~POLYGONS();
     };
 
     
@@ -81,20 +84,62 @@ namespace mog {
         Point center;
         float radius;
         
+        CIRCLE();
         CIRCLE(float x, float y, float radius);
     };
     
     
+    class CircleBatch {
+    public:
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> radius;
+
+        void add(const CIRCLE &circle);
+        void clear();
+        void reserve(int size);
+        int size() const;
+    };
+
+
+    class OBBBatch {
+    public:
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> axis1X;
+        std::vector<float> axis1Y;
+        std::vector<float> extent1;
+        std::vector<float> axis2X;
+        std::vector<float> axis2Y;
+        std::vector<float> extent2;
+
+        void add(const OBB &obb);
+        void clear();
+        void reserve(int size);
+        int size() const;
+    };
+
+
+    class RaycastHit {
+    public:
+        float distance = 0;
+        // ray: the hit point; sweep: the center of the moving shape at the time of contact
+        Point point = Point::zero;
+        Point normal = Point::zero;
+        std::shared_ptr<Entity> entity;
+    };
+
+
     class Collider {
     public:
         ColliderShape shape;
-        std::shared_ptr<AABB> aabb;
-        std::shared_ptr<OBB> obb;
-        std::shared_ptr<CIRCLE> circle;
-        std::shared_ptr<POLYGON> polygon;
-        std::shared_ptr<POLYGONS> polygons;
+        AABB aabb;
+        OBB obb;
+        CIRCLE circle;
+        POLYGON polygon;
+        POLYGONS polygons;
 
-        Collider(ColliderShape shape);
+        Collider(ColliderShape shape = ColliderShape::Rect);
         
         Point getCentroid();
         float getRotation();
@@ -103,8 +148,8 @@ namespace mog {
     
     class Collision {
     public:
-        static bool collides(const std::shared_ptr<Collider> &col1, const std::shared_ptr<Collider> &col2);
-        static bool collides(const std::shared_ptr<Collider> &col1, const Point &p);
+        static bool collides(const Collider &col1, const Collider &col2);
+        static bool collides(const Collider &col, const Point &p);
         
         static bool aabb_aabb(const AABB &aabb1, const AABB &aabb2);
         static bool aabb_point(const AABB &aabb, const Point &p);
@@ -126,6 +171,27 @@ namespace mog {
         
         static bool polygons_polygons(const POLYGONS &polygons1, const POLYGONS &polygons2);
         static bool polygons_point(const POLYGONS &polygons, const Point &p);
+
+        // batch tests write one bit per shape to hitMask (getHitMaskLength(n) words) and return the hit count
+        static int getHitMaskLength(int size);
+        static bool isHit(const unsigned int *hitMask, int idx);
+        static int circle_circles(const CIRCLE &circle, const CircleBatch &circles, unsigned int *hitMask);
+        static int obb_circles(const OBB &obb, const CircleBatch &circles, unsigned int *hitMask);
+        static int obb_obbs(const OBB &obb, const OBBBatch &obbs, unsigned int *hitMask);
+        static int circles_circles(const CircleBatch &circles1, const CircleBatch &circles2, std::vector<std::pair<int, int>> &pairs);
+        static int obbs_circles(const OBBBatch &obbs, const CircleBatch &circles, std::vector<std::pair<int, int>> &pairs);
+        static int obbs_obbs(const OBBBatch &obbs1, const OBBBatch &obbs2, std::vector<std::pair<int, int>> &pairs);
+
+        // a ray starting inside a shape hits it at distance 0
+        static bool raycast(const Collider &col, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit);
+        static bool sweep(const Collider &col, const CIRCLE &circle, const Point &direction, float maxDistance, RaycastHit *hit);
+        static bool sweep(const Collider &col, const OBB &obb, const Point &direction, float maxDistance, RaycastHit *hit);
+
+        static bool ray_aabb(const AABB &aabb, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit);
+        static bool ray_obb(const OBB &obb, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit);
+        static bool ray_circle(const CIRCLE &circle, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit);
+        static bool ray_polygon(const POLYGON &polygon, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit);
+        static bool ray_polygons(const POLYGONS &polygons, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit);
     };
 }
 
@@ -0,0 +1,491 @@
+#include "mog/core/CollisionWorld.h"
+#include "mog/base/Entity.h"
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+
+#define COLLISION_LARGE_PROXY_CELLS 64
+
+using namespace mog;
+
+std::shared_ptr<CollisionWorld> CollisionWorld::create(float cellSize) {
+    auto world = std::shared_ptr<CollisionWorld>(new CollisionWorld());
+    if (cellSize <= 0) cellSize = 128.0f;
+    world->cellSize = cellSize;
+    world->invCellSize = 1.0f / cellSize;
+    return world;
+}
+
+void CollisionWorld::add(const std::shared_ptr<Entity> &entity, unsigned int layer, unsigned int mask) {
+    auto it = this->proxyIds.find(entity.get());
+    if (it != this->proxyIds.end()) {
+        if (!this->proxies[it->second].entity.expired()) {
+            this->setLayer(entity, layer, mask);
+            return;
+        }
+        this->releaseProxy(it->second);
+    }
+    int proxyId;
+    if (this->freeProxyIds.size() > 0) {
+        proxyId = this->freeProxyIds.back();
+        this->freeProxyIds.pop_back();
+    } else {
+        proxyId = (int)this->proxies.size();
+        this->proxies.emplace_back(Proxy());
+    }
+    auto &proxy = this->proxies[proxyId];
+    proxy.entity = entity;
+    proxy.entityPtr = entity.get();
+    proxy.valid = false;
+    proxy.layer = layer;
+    proxy.mask = mask;
+    proxy.queryId = 0;
+    this->proxyIds[entity.get()] = proxyId;
+    this->updateProxy(proxyId);
+}
+
+void CollisionWorld::remove(const std::shared_ptr<Entity> &entity) {
+    auto it = this->proxyIds.find(entity.get());
+    if (it == this->proxyIds.end()) return;
+    this->releaseProxy(it->second);
+}
+
+void CollisionWorld::removeAll() {
+    this->proxies.clear();
+    this->freeProxyIds.clear();
+    this->proxyIds.clear();
+    this->cells.clear();
+    this->largeProxyIds.clear();
+    this->cellBounds = CellRange();
+    this->cellBoundsDirty = false;
+}
+
+bool CollisionWorld::contains(const std::shared_ptr<Entity> &entity) {
+    return (this->proxyIds.count(entity.get()) > 0);
+}
+
+void CollisionWorld::setLayer(const std::shared_ptr<Entity> &entity, unsigned int layer, unsigned int mask) {
+    auto it = this->proxyIds.find(entity.get());
+    if (it == this->proxyIds.end()) return;
+    this->proxies[it->second].layer = layer;
+    this->proxies[it->second].mask = mask;
+}
+
+unsigned int CollisionWorld::getLayer(const std::shared_ptr<Entity> &entity) {
+    auto it = this->proxyIds.find(entity.get());
+    if (it == this->proxyIds.end()) return 0;
+    return this->proxies[it->second].layer;
+}
+
+unsigned int CollisionWorld::getMask(const std::shared_ptr<Entity> &entity) {
+    auto it = this->proxyIds.find(entity.get());
+    if (it == this->proxyIds.end()) return 0;
+    return this->proxies[it->second].mask;
+}
+
+int CollisionWorld::getCount() {
+    return (int)this->proxyIds.size();
+}
+
+float CollisionWorld::getCellSize() {
+    return this->cellSize;
+}
+
+void CollisionWorld::update() {
+    for (int i = 0; i < (int)this->proxies.size(); i++) {
+        if (!this->proxies[i].valid) continue;
+        this->updateProxy(i);
+    }
+    this->updateCellBounds();
+}
+
+std::vector<std::pair<std::shared_ptr<Entity>, std::shared_ptr<Entity>>> CollisionWorld::queryPairs() {
+    this->update();
+    std::vector<std::pair<std::shared_ptr<Entity>, std::shared_ptr<Entity>>> pairs;
+
+    for (const auto &pair : this->cells) {
+        const auto &ids = pair.second;
+        if (ids.size() < 2) continue;
+        int cx = (int)(pair.first >> 32);
+        int cy = (int)(pair.first & 0xFFFFFFFF);
+
+        for (int i = 0; i < (int)ids.size(); i++) {
+            const auto &p1 = this->proxies[ids[i]];
+            for (int j = i + 1; j < (int)ids.size(); j++) {
+                const auto &p2 = this->proxies[ids[j]];
+                // a pair sharing several cells is only tested in the first one they share
+                if (std::max(p1.cells.minX, p2.cells.minX) != cx || std::max(p1.cells.minY, p2.cells.minY) != cy) continue;
+                if (!canCollide(p1, p2)) continue;
+                if (!Collision::aabb_aabb(p1.aabb, p2.aabb)) continue;
+                auto e1 = p1.entity.lock();
+                auto e2 = p2.entity.lock();
+                if (!e1->isActive() || !e2->isActive()) continue;
+                if (!Collision::collides(e1->getCollider(), e2->getCollider())) continue;
+                pairs.emplace_back(std::make_pair(e1, e2));
+            }
+        }
+    }
+
+    for (int i = 0; i < (int)this->largeProxyIds.size(); i++) {
+        int largeId = this->largeProxyIds[i];
+        const auto &p1 = this->proxies[largeId];
+        for (int j = 0; j < (int)this->proxies.size(); j++) {
+            const auto &p2 = this->proxies[j];
+            if (j == largeId || !p2.valid) continue;
+            if (p2.large && j < largeId) continue;
+            if (!canCollide(p1, p2)) continue;
+            if (!Collision::aabb_aabb(p1.aabb, p2.aabb)) continue;
+            auto e1 = p1.entity.lock();
+            auto e2 = p2.entity.lock();
+            if (!e1->isActive() || !e2->isActive()) continue;
+            if (!Collision::collides(e1->getCollider(), e2->getCollider())) continue;
+            pairs.emplace_back(std::make_pair(e1, e2));
+        }
+    }
+    return pairs;
+}
+
+std::vector<std::shared_ptr<Entity>> CollisionWorld::queryRect(const Rect &rect, unsigned int mask) {
+    this->update();
+    std::vector<std::shared_ptr<Entity>> entities;
+
+    float x = rect.position.x;
+    float y = rect.position.y;
+    float w = rect.size.width;
+    float h = rect.size.height;
+    Collider collider(ColliderShape::Rect);
+    collider.aabb = AABB(x, y, x + w, y + h);
+    collider.obb = OBB(Vec2(1.0f, 0, w * 0.5f), Vec2(0, 1.0f, h * 0.5f), x + w * 0.5f, y + h * 0.5f);
+
+    unsigned int queryId = this->nextQueryId();
+    auto test = [&](int proxyId) {
+        auto &proxy = this->proxies[proxyId];
+        if (proxy.queryId == queryId) return;
+        proxy.queryId = queryId;
+        if ((proxy.layer & mask) == 0) return;
+        if (!Collision::aabb_aabb(proxy.aabb, collider.aabb)) return;
+        auto entity = proxy.entity.lock();
+        if (!entity->isActive()) return;
+        if (!Collision::collides(entity->getCollider(), collider)) return;
+        entities.emplace_back(entity);
+    };
+
+    auto range = this->getCellRange(collider.aabb);
+    for (int cy = range.minY; cy <= range.maxY; cy++) {
+        for (int cx = range.minX; cx <= range.maxX; cx++) {
+            auto it = this->cells.find(getCellKey(cx, cy));
+            if (it == this->cells.end()) continue;
+            for (int proxyId : it->second) {
+                test(proxyId);
+            }
+        }
+    }
+    for (int proxyId : this->largeProxyIds) {
+        test(proxyId);
+    }
+    return entities;
+}
+
+std::vector<std::shared_ptr<Entity>> CollisionWorld::queryPoint(const Point &point, unsigned int mask) {
+    this->update();
+    std::vector<std::shared_ptr<Entity>> entities;
+
+    auto test = [&](int proxyId) {
+        const auto &proxy = this->proxies[proxyId];
+        if ((proxy.layer & mask) == 0) return;
+        if (!Collision::aabb_point(proxy.aabb, point)) return;
+        auto entity = proxy.entity.lock();
+        if (!entity->isActive()) return;
+        if (!Collision::collides(entity->getCollider(), point)) return;
+        entities.emplace_back(entity);
+    };
+
+    int cx = (int)floor(point.x * this->invCellSize);
+    int cy = (int)floor(point.y * this->invCellSize);
+    auto it = this->cells.find(getCellKey(cx, cy));
+    if (it != this->cells.end()) {
+        for (int proxyId : it->second) {
+            test(proxyId);
+        }
+    }
+    for (int proxyId : this->largeProxyIds) {
+        test(proxyId);
+    }
+    return entities;
+}
+
+bool CollisionWorld::raycast(const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit, unsigned int mask) {
+    this->update();
+    float len = Point::length(direction);
+    if (len < 0.000001f) return false;
+    Point dir = direction / len;
+    unsigned int queryId = this->nextQueryId();
+    bool found = false;
+    float best = maxDistance;
+
+    for (int proxyId : this->largeProxyIds) {
+        if (this->testRaycast(proxyId, queryId, mask, origin, dir, best, hit)) {
+            best = hit->distance;
+            found = true;
+        }
+    }
+    if (this->cellBounds.maxX < this->cellBounds.minX) return found;
+
+    // clip the ray to the occupied cells, then walk the cells it crosses in order
+    AABB bounds(this->cellBounds.minX * this->cellSize, this->cellBounds.minY * this->cellSize,
+                (this->cellBounds.maxX + 1) * this->cellSize, (this->cellBounds.maxY + 1) * this->cellSize);
+    RaycastHit boundsHit;
+    if (!Collision::ray_aabb(bounds, origin, dir, best, &boundsHit)) return found;
+    float t = boundsHit.distance;
+    Point start = origin + dir * t;
+    int cx = std::min(std::max((int)floor(start.x * this->invCellSize), this->cellBounds.minX), this->cellBounds.maxX);
+    int cy = std::min(std::max((int)floor(start.y * this->invCellSize), this->cellBounds.minY), this->cellBounds.maxY);
+    int stepX = (dir.x > 0) ? 1 : -1;
+    int stepY = (dir.y > 0) ? 1 : -1;
+    float tDeltaX = (dir.x != 0) ? this->cellSize / fabs(dir.x) : FLT_MAX;
+    float tDeltaY = (dir.y != 0) ? this->cellSize / fabs(dir.y) : FLT_MAX;
+    float tMaxX = (dir.x != 0) ? (((cx + (stepX > 0 ? 1 : 0)) * this->cellSize - origin.x) / dir.x) : FLT_MAX;
+    float tMaxY = (dir.y != 0) ? (((cy + (stepY > 0 ? 1 : 0)) * this->cellSize - origin.y) / dir.y) : FLT_MAX;
+
+    while (cx >= this->cellBounds.minX && cx <= this->cellBounds.maxX &&
+           cy >= this->cellBounds.minY && cy <= this->cellBounds.maxY) {
+        auto it = this->cells.find(getCellKey(cx, cy));
+        if (it != this->cells.end()) {
+            for (int proxyId : it->second) {
+                if (this->testRaycast(proxyId, queryId, mask, origin, dir, best, hit)) {
+                    best = hit->distance;
+                    found = true;
+                }
+            }
+        }
+        float tNext = std::min(tMaxX, tMaxY);
+        if (tNext > best) break;
+        if (tMaxX < tMaxY) {
+            cx += stepX;
+            tMaxX += tDeltaX;
+        } else {
+            cy += stepY;
+            tMaxY += tDeltaY;
+        }
+    }
+    return found;
+}
+
+bool CollisionWorld::sweep(const CIRCLE &circle, const Point &direction, float maxDistance, RaycastHit *hit, unsigned int mask) {
+    AABB aabb(circle.center.x - circle.radius, circle.center.y - circle.radius,
+              circle.center.x + circle.radius, circle.center.y + circle.radius);
+    return this->sweepShape(circle, aabb, direction, maxDistance, hit, mask);
+}
+
+bool CollisionWorld::sweep(const OBB &obb, const Point &direction, float maxDistance, RaycastHit *hit, unsigned int mask) {
+    float hw = fabs(obb.vec1.x) * obb.vec1.vLen + fabs(obb.vec2.x) * obb.vec2.vLen;
+    float hh = fabs(obb.vec1.y) * obb.vec1.vLen + fabs(obb.vec2.y) * obb.vec2.vLen;
+    AABB aabb(obb.centerX - hw, obb.centerY - hh, obb.centerX + hw, obb.centerY + hh);
+    return this->sweepShape(obb, aabb, direction, maxDistance, hit, mask);
+}
+
+template <class T>
+bool CollisionWorld::sweepShape(const T &shape, const AABB &aabb, const Point &direction, float maxDistance, RaycastHit *hit, unsigned int mask) {
+    this->update();
+    float len = Point::length(direction);
+    if (len < 0.000001f) return false;
+    Point dir = direction / len;
+    unsigned int queryId = this->nextQueryId();
+    bool found = false;
+    float best = maxDistance;
+
+    auto test = [&](int proxyId) {
+        auto &proxy = this->proxies[proxyId];
+        if (proxy.queryId == queryId) return;
+        proxy.queryId = queryId;
+        if ((proxy.layer & mask) == 0) return;
+        auto entity = proxy.entity.lock();
+        if (!entity->isActive()) return;
+        RaycastHit shapeHit;
+        if (!Collision::sweep(entity->getCollider(), shape, dir, best, &shapeHit)) return;
+        best = shapeHit.distance;
+        shapeHit.entity = entity;
+        if (hit) *hit = shapeHit;
+        found = true;
+    };
+
+    for (int proxyId : this->largeProxyIds) {
+        test(proxyId);
+    }
+    if (this->cellBounds.maxX < this->cellBounds.minX) return found;
+
+    // cells covered by the swept bounds, limited to the occupied cells
+    float travel = std::min(best, (float)((this->cellBounds.maxX - this->cellBounds.minX + this->cellBounds.maxY - this->cellBounds.minY + 2) * this->cellSize));
+    Point end = dir * travel;
+    AABB swept(aabb.minX + std::min(end.x, 0.0f), aabb.minY + std::min(end.y, 0.0f),
+               aabb.maxX + std::max(end.x, 0.0f), aabb.maxY + std::max(end.y, 0.0f));
+    auto range = this->getCellRange(swept);
+    range.minX = std::max(range.minX, this->cellBounds.minX);
+    range.minY = std::max(range.minY, this->cellBounds.minY);
+    range.maxX = std::min(range.maxX, this->cellBounds.maxX);
+    range.maxY = std::min(range.maxY, this->cellBounds.maxY);
+    for (int cy = range.minY; cy <= range.maxY; cy++) {
+        for (int cx = range.minX; cx <= range.maxX; cx++) {
+            auto it = this->cells.find(getCellKey(cx, cy));
+            if (it == this->cells.end()) continue;
+            for (int proxyId : it->second) {
+                test(proxyId);
+            }
+        }
+    }
+    return found;
+}
+
+bool CollisionWorld::testRaycast(int proxyId, unsigned int queryId, unsigned int mask, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit) {
+    auto &proxy = this->proxies[proxyId];
+    if (proxy.queryId == queryId) return false;
+    proxy.queryId = queryId;
+    if ((proxy.layer & mask) == 0) return false;
+    if (!Collision::ray_aabb(proxy.aabb, origin, direction, maxDistance, nullptr)) return false;
+    auto entity = proxy.entity.lock();
+    if (!entity->isActive()) return false;
+    RaycastHit shapeHit;
+    if (!Collision::raycast(entity->getCollider(), origin, direction, maxDistance, &shapeHit)) return false;
+    shapeHit.entity = entity;
+    if (hit) *hit = shapeHit;
+    return true;
+}
+
+CollisionWorld::CellRange CollisionWorld::getCellRange(const AABB &aabb) {
+    CellRange range;
+    range.minX = (int)floor(aabb.minX * this->invCellSize);
+    range.minY = (int)floor(aabb.minY * this->invCellSize);
+    range.maxX = (int)floor(aabb.maxX * this->invCellSize);
+    range.maxY = (int)floor(aabb.maxY * this->invCellSize);
+    return range;
+}
+
+void CollisionWorld::insertProxy(int proxyId) {
+    auto &proxy = this->proxies[proxyId];
+    long long cellsNum = (long long)(proxy.cells.maxX - proxy.cells.minX + 1) * (proxy.cells.maxY - proxy.cells.minY + 1);
+    proxy.large = (cellsNum > COLLISION_LARGE_PROXY_CELLS);
+    if (proxy.large) {
+        this->largeProxyIds.emplace_back(proxyId);
+        return;
+    }
+    for (int cy = proxy.cells.minY; cy <= proxy.cells.maxY; cy++) {
+        for (int cx = proxy.cells.minX; cx <= proxy.cells.maxX; cx++) {
+            this->cells[getCellKey(cx, cy)].emplace_back(proxyId);
+        }
+    }
+    if (this->cellBounds.maxX < this->cellBounds.minX) {
+        this->cellBounds = proxy.cells;
+    } else {
+        this->cellBounds.minX = std::min(this->cellBounds.minX, proxy.cells.minX);
+        this->cellBounds.minY = std::min(this->cellBounds.minY, proxy.cells.minY);
+        this->cellBounds.maxX = std::max(this->cellBounds.maxX, proxy.cells.maxX);
+        this->cellBounds.maxY = std::max(this->cellBounds.maxY, proxy.cells.maxY);
+    }
+}
+
+void CollisionWorld::removeProxy(int proxyId) {
+    auto &proxy = this->proxies[proxyId];
+    if (!proxy.valid) return;
+    if (proxy.large) {
+        auto it = std::find(this->largeProxyIds.begin(), this->largeProxyIds.end(), proxyId);
+        if (it != this->largeProxyIds.end()) {
+            *it = this->largeProxyIds.back();
+            this->largeProxyIds.pop_back();
+        }
+        return;
+    }
+    for (int cy = proxy.cells.minY; cy <= proxy.cells.maxY; cy++) {
+        for (int cx = proxy.cells.minX; cx <= proxy.cells.maxX; cx++) {
+            auto cellIt = this->cells.find(getCellKey(cx, cy));
+            if (cellIt == this->cells.end()) continue;
+            auto &ids = cellIt->second;
+            auto it = std::find(ids.begin(), ids.end(), proxyId);
+            if (it != ids.end()) {
+                *it = ids.back();
+                ids.pop_back();
+            }
+            if (ids.size() == 0) {
+                this->cells.erase(cellIt);
+            }
+        }
+    }
+    // the bounds only shrink when a proxy on their edge is removed
+    if (proxy.cells.minX == this->cellBounds.minX || proxy.cells.minY == this->cellBounds.minY ||
+        proxy.cells.maxX == this->cellBounds.maxX || proxy.cells.maxY == this->cellBounds.maxY) {
+        this->cellBoundsDirty = true;
+    }
+}
+
+void CollisionWorld::updateCellBounds() {
+    if (!this->cellBoundsDirty) return;
+    this->cellBoundsDirty = false;
+    this->cellBounds = CellRange();
+    bool first = true;
+    for (const auto &pair : this->cells) {
+        int cx = (int)(pair.first >> 32);
+        int cy = (int)(pair.first & 0xFFFFFFFF);
+        if (first) {
+            this->cellBounds.minX = this->cellBounds.maxX = cx;
+            this->cellBounds.minY = this->cellBounds.maxY = cy;
+            first = false;
+        } else {
+            this->cellBounds.minX = std::min(this->cellBounds.minX, cx);
+            this->cellBounds.minY = std::min(this->cellBounds.minY, cy);
+            this->cellBounds.maxX = std::max(this->cellBounds.maxX, cx);
+            this->cellBounds.maxY = std::max(this->cellBounds.maxY, cy);
+        }
+    }
+}
+
+void CollisionWorld::releaseProxy(int proxyId) {
+    this->removeProxy(proxyId);
+    auto &proxy = this->proxies[proxyId];
+    this->proxyIds.erase(proxy.entityPtr);
+    proxy.entity.reset();
+    proxy.entityPtr = nullptr;
+    proxy.valid = false;
+    this->freeProxyIds.emplace_back(proxyId);
+}
+
+bool CollisionWorld::updateProxy(int proxyId) {
+    auto entity = this->proxies[proxyId].entity.lock();
+    if (!entity) {
+        this->releaseProxy(proxyId);
+        return false;
+    }
+    const auto &collider = entity->getCollider();
+    auto &proxy = this->proxies[proxyId];
+    if (proxy.valid && proxy.colliderVersion == entity->getColliderVersion()) return true;
+
+    // the collider version only changes when the entity has moved, so unchanged proxies are skipped
+    auto range = this->getCellRange(collider.aabb);
+    if (!proxy.valid || range != proxy.cells) {
+        this->removeProxy(proxyId);
+        proxy.cells = range;
+        proxy.aabb = collider.aabb;
+        proxy.valid = true;
+        this->insertProxy(proxyId);
+    } else {
+        proxy.aabb = collider.aabb;
+    }
+    proxy.colliderVersion = entity->getColliderVersion();
+    return true;
+}
+
+unsigned int CollisionWorld::nextQueryId() {
+    if (++this->queryIdCounter == 0) {
+        for (auto &proxy : this->proxies) {
+            proxy.queryId = 0;
+        }
+        this->queryIdCounter = 1;
+    }
+    return this->queryIdCounter;
+}
+
+unsigned long long CollisionWorld::getCellKey(int x, int y) {
+    return ((unsigned long long)(unsigned int)x << 32) | (unsigned long long)(unsigned int)y;
+}
+
+bool CollisionWorld::canCollide(const Proxy &p1, const Proxy &p2) {
+    return ((p1.layer & p2.mask) != 0 && (p2.layer & p1.mask) != 0);
+}
@@ -0,0 +1,93 @@
+#ifndef CollisionWorld_h
+#define CollisionWorld_h
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "mog/core/plain_objects.h"
+#include "mog/core/Collision.h"
+
+#define COLLISION_LAYER_ALL 0xFFFFFFFF
+
+namespace mog {
+    class Entity;
+
+    class CollisionWorld {
+    public:
+        static std::shared_ptr<CollisionWorld> create(float cellSize = 128.0f);
+
+        void add(const std::shared_ptr<Entity> &entity, unsigned int layer = 1, unsigned int mask = COLLISION_LAYER_ALL);
+        void remove(const std::shared_ptr<Entity> &entity);
+        void removeAll();
+        bool contains(const std::shared_ptr<Entity> &entity);
+        void setLayer(const std::shared_ptr<Entity> &entity, unsigned int layer, unsigned int mask = COLLISION_LAYER_ALL);
+        unsigned int getLayer(const std::shared_ptr<Entity> &entity);
+        unsigned int getMask(const std::shared_ptr<Entity> &entity);
+        int getCount();
+        float getCellSize();
+
+        void update();
+        std::vector<std::pair<std::shared_ptr<Entity>, std::shared_ptr<Entity>>> queryPairs();
+        std::vector<std::shared_ptr<Entity>> queryRect(const Rect &rect, unsigned int mask = COLLISION_LAYER_ALL);
+        std::vector<std::shared_ptr<Entity>> queryPoint(const Point &point, unsigned int mask = COLLISION_LAYER_ALL);
+        bool raycast(const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit, unsigned int mask = COLLISION_LAYER_ALL);
+        bool sweep(const CIRCLE &circle, const Point &direction, float maxDistance, RaycastHit *hit, unsigned int mask = COLLISION_LAYER_ALL);
+        bool sweep(const OBB &obb, const Point &direction, float maxDistance, RaycastHit *hit, unsigned int mask = COLLISION_LAYER_ALL);
+
+    private:
+        struct CellRange {
+            int minX = 0;
+            int minY = 0;
+            int maxX = -1;
+            int maxY = -1;
+
+            bool operator==(const CellRange &other) const {
+                return (this->minX == other.minX && this->minY == other.minY &&
+                        this->maxX == other.maxX && this->maxY == other.maxY);
+            }
+            bool operator!=(const CellRange &other) const {
+                return !(*this == other);
+            }
+        };
+
+        struct Proxy {
+            std::weak_ptr<Entity> entity;
+            Entity *entityPtr = nullptr;
+            unsigned int colliderVersion = 0;
+            bool valid = false;
+            AABB aabb = AABB(0, 0, 0, 0);
+            CellRange cells;
+            unsigned int layer = 1;
+            unsigned int mask = COLLISION_LAYER_ALL;
+            bool large = false;
+            unsigned int queryId = 0;
+        };
+
+        float cellSize = 128.0f;
+        float invCellSize = 1.0f / 128.0f;
+        unsigned int queryIdCounter = 0;
+        std::vector<Proxy> proxies;
+        std::vector<int> freeProxyIds;
+        std::unordered_map<Entity *, int> proxyIds;
+        std::unordered_map<unsigned long long, std::vector<int>> cells;
+        std::vector<int> largeProxyIds;
+        CellRange cellBounds;
+        bool cellBoundsDirty = false;
+
+        CollisionWorld() {}
+        CellRange getCellRange(const AABB &aabb);
+        void insertProxy(int proxyId);
+        void removeProxy(int proxyId);
+        void releaseProxy(int proxyId);
+        void updateCellBounds();
+        bool updateProxy(int proxyId);
+        bool testRaycast(int proxyId, unsigned int queryId, unsigned int mask, const Point &origin, const Point &direction, float maxDistance, RaycastHit *hit);
+        template <class T>
+        bool sweepShape(const T &shape, const AABB &aabb, const Point &direction, float maxDistance, RaycastHit *hit, unsigned int mask);
+        unsigned int nextQueryId();
+        static unsigned long long getCellKey(int x, int y);
+        static bool canCollide(const Proxy &p1, const Proxy &p2);
+    };
+}
+
+#endif /* CollisionWorld_h */
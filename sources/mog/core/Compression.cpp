@@ -0,0 +1,586 @@
+#include "mog/Constants.h"
+#include "mog/core/Compression.h"
+#include <string.h>
+#include <algorithm>
+
+#define LZ4_FRAME_MAGIC 0x184D2204
+#define LZ4_SKIPPABLE_MAGIC 0x184D2A50
+#define LZ4_SKIPPABLE_MASK 0xFFFFFFF0
+#define LZ4_BLOCK_SIZE (64 * 1024)
+#define LZ4_BLOCK_SIZE_ID 4
+#define LZ4_UNCOMPRESSED_FLAG 0x80000000
+#define LZ4_MAX_DISTANCE 65535
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MF_LIMIT 12
+#define LZ4_HASH_LOG 12
+#define LZ4_SKIP_TRIGGER 6
+#define LZ4_FRAME_HEADER_MAX_SIZE 19
+
+#define XXH_PRIME32_1 2654435761U
+#define XXH_PRIME32_2 2246822519U
+#define XXH_PRIME32_3 3266489917U
+#define XXH_PRIME32_4 668265263U
+#define XXH_PRIME32_5 374761393U
+
+using namespace mog;
+
+static inline unsigned int readU32(const void *p) {
+    unsigned int v;
+    memcpy(&v, p, sizeof(unsigned int));
+    return v;
+}
+
+static inline unsigned int readLE32(const unsigned char *p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static inline void writeLE32(unsigned char *p, unsigned int v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static inline unsigned int rotl32(unsigned int x, int r) {
+    return (x << r) | (x >> (32 - r));
+}
+
+static inline unsigned int xxh32Round(unsigned int acc, unsigned int input) {
+    acc += input * XXH_PRIME32_2;
+    acc = rotl32(acc, 13);
+    return acc * XXH_PRIME32_1;
+}
+
+static unsigned int blockMaxSizeOf(int id) {
+    switch (id) {
+        case 4: return 64 * 1024;
+        case 5: return 256 * 1024;
+        case 6: return 1024 * 1024;
+        case 7: return 4 * 1024 * 1024;
+        default: return 0;
+    }
+}
+
+// parses FLG / BD of a frame descriptor, returns the descriptor size including the header checksum or 0 when invalid
+static unsigned int parseFrameDescriptor(const unsigned char *p, size_t length) {
+    if (length < 3) return 0;
+    unsigned char flg = p[0];
+    unsigned char bd = p[1];
+    if ((flg >> 6) != 1 || (flg & 0x02) != 0 || (flg & 0x01) != 0) return 0;
+    if ((bd & 0x8F) != 0 || blockMaxSizeOf((bd >> 4) & 0x07) == 0) return 0;
+    unsigned int size = 2 + ((flg & 0x08) ? 8 : 0);
+    if (length < size + 1) return 0;
+    unsigned char hc = (unsigned char)((Compression::xxh32(p, size) >> 8) & 0xFF);
+    if (p[size] != hc) return 0;
+    return size + 1;
+}
+
+
+#pragma - Compression
+
+bool Compression::isCompressed(const void *data, size_t length) {
+    const unsigned char *p = (const unsigned char *)data;
+    if (p == nullptr || length < 7 || readLE32(p) != LZ4_FRAME_MAGIC) return false;
+    return parseFrameDescriptor(p + 4, length - 4) > 0;
+}
+
+bool Compression::isCompressed(const std::shared_ptr<ByteArray> &bytes) {
+    if (!bytes) return false;
+    unsigned char *value = nullptr;
+    unsigned int length = 0;
+    bytes->getValue(&value, &length);
+    return Compression::isCompressed(value, length);
+}
+
+std::shared_ptr<ByteArray> Compression::compress(const std::shared_ptr<ByteArray> &bytes) {
+    unsigned char *value = nullptr;
+    unsigned int length = 0;
+    if (bytes) bytes->getValue(&value, &length);
+    ByteArrayBuilder builder(Compression::compressBound(length > LZ4_BLOCK_SIZE ? LZ4_BLOCK_SIZE : length) + LZ4_FRAME_HEADER_MAX_SIZE);
+    std::ostream out(&builder);
+    CompressStreamBuffer compressor(out, length);
+    if (length > 0 && compressor.sputn((const char *)value, length) != (std::streamsize)length) return nullptr;
+    if (!compressor.finish()) return nullptr;
+    return builder.toByteArray();
+}
+
+std::shared_ptr<ByteArray> Compression::decompress(const std::shared_ptr<ByteArray> &bytes) {
+    if (!bytes) return nullptr;
+    ByteArrayStreamBuffer buffer(bytes);
+    std::istream in(&buffer);
+    DecompressStreamBuffer decompressor(in);
+    long long contentSize = decompressor.getContentSize();
+    if (contentSize > 0xffffffffLL) return nullptr;
+    // the content size is not trusted before the blocks are decoded, lz4 expands at most 255 times
+    long long capacity = (long long)bytes->getLength() * (contentSize >= 0 ? 255 : 2);
+    if (contentSize >= 0 && contentSize < capacity) capacity = contentSize;
+    ByteArrayBuilder builder((unsigned int)std::min<long long>(capacity, 0xffffffffLL));
+    std::vector<char> chunk(LZ4_BLOCK_SIZE);
+    while (true) {
+        std::streamsize n = decompressor.sgetn(chunk.data(), chunk.size());
+        if (n <= 0) break;
+        if (builder.sputn(chunk.data(), n) != n) return nullptr;
+    }
+    if (decompressor.hasError()) return nullptr;
+    return builder.toByteArray();
+}
+
+int Compression::compressBound(int length) {
+    return length + length / 255 + 16;
+}
+
+int Compression::compressBlock(const unsigned char *src, int srcLength, unsigned char *dst, int dstCapacity) {
+    unsigned int table[1 << LZ4_HASH_LOG];
+    memset(table, 0, sizeof(table));
+
+    const unsigned char *ip = src;
+    const unsigned char *anchor = src;
+    const unsigned char *iend = src + srcLength;
+    unsigned char *op = dst;
+    unsigned char *oend = dst + dstCapacity;
+
+    if (srcLength >= LZ4_MF_LIMIT + 1) {
+        const unsigned char *mflimit = iend - LZ4_MF_LIMIT;
+        const unsigned char *matchlimit = iend - LZ4_LAST_LITERALS;
+        ip++;
+        while (true) {
+            // find a match, skipping faster through incompressible data
+            const unsigned char *ref = nullptr;
+            unsigned int searchCount = 1 << LZ4_SKIP_TRIGGER;
+            bool found = false;
+            while (ip <= mflimit) {
+                unsigned int h = (readU32(ip) * XXH_PRIME32_1) >> (32 - LZ4_HASH_LOG);
+                ref = src + table[h];
+                table[h] = (unsigned int)(ip - src);
+                if (ref < ip && ip - ref <= LZ4_MAX_DISTANCE && readU32(ref) == readU32(ip)) {
+                    found = true;
+                    break;
+                }
+                ip += searchCount++ >> LZ4_SKIP_TRIGGER;
+            }
+            if (!found) break;
+
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+            const unsigned char *matchEnd = ip + LZ4_MIN_MATCH;
+            const unsigned char *refEnd = ref + LZ4_MIN_MATCH;
+            while (matchEnd < matchlimit && *matchEnd == *refEnd) {
+                matchEnd++;
+                refEnd++;
+            }
+
+            size_t literalLength = ip - anchor;
+            size_t matchLength = matchEnd - ip - LZ4_MIN_MATCH;
+            if ((size_t)(oend - op) < 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1) return 0;
+
+            unsigned char *token = op++;
+            if (literalLength >= 15) {
+                *token = 15 << 4;
+                size_t len = literalLength - 15;
+                for (; len >= 255; len -= 255) *op++ = 255;
+                *op++ = (unsigned char)len;
+            } else {
+                *token = (unsigned char)(literalLength << 4);
+            }
+            memcpy(op, anchor, literalLength);
+            op += literalLength;
+
+            unsigned int offset = (unsigned int)(ip - ref);
+            *op++ = (unsigned char)offset;
+            *op++ = (unsigned char)(offset >> 8);
+
+            if (matchLength >= 15) {
+                *token |= 15;
+                size_t len = matchLength - 15;
+                for (; len >= 255; len -= 255) *op++ = 255;
+                *op++ = (unsigned char)len;
+            } else {
+                *token |= (unsigned char)matchLength;
+            }
+
+            ip = matchEnd;
+            anchor = ip;
+            if (ip > mflimit) break;
+            table[(readU32(ip - 2) * XXH_PRIME32_1) >> (32 - LZ4_HASH_LOG)] = (unsigned int)(ip - 2 - src);
+        }
+    }
+
+    size_t literalLength = iend - anchor;
+    if ((size_t)(oend - op) < 1 + literalLength / 255 + 1 + literalLength) return 0;
+    if (literalLength >= 15) {
+        *op++ = 15 << 4;
+        size_t len = literalLength - 15;
+        for (; len >= 255; len -= 255) *op++ = 255;
+        *op++ = (unsigned char)len;
+    } else {
+        *op++ = (unsigned char)(literalLength << 4);
+    }
+    memcpy(op, anchor, literalLength);
+    op += literalLength;
+    return (int)(op - dst);
+}
+
+int Compression::decompressBlock(const unsigned char *src, int srcLength, unsigned char *dst, int dstCapacity, int prefixLength) {
+    const unsigned char *ip = src;
+    const unsigned char *iend = src + srcLength;
+    unsigned char *op = dst;
+    unsigned char *oend = dst + dstCapacity;
+    const unsigned char *lowest = dst - prefixLength;
+
+    while (ip < iend) {
+        unsigned int token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            unsigned int b;
+            do {
+                if (ip >= iend) return -1;
+                b = *ip++;
+                literalLength += b;
+            } while (b == 255);
+        }
+        if (literalLength > (size_t)(iend - ip) || literalLength > (size_t)(oend - op)) return -1;
+        memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == iend) break;
+
+        if (iend - ip < 2) return -1;
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - lowest)) return -1;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15) {
+            unsigned int b;
+            do {
+                if (ip >= iend) return -1;
+                b = *ip++;
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += LZ4_MIN_MATCH;
+        if (matchLength > (size_t)(oend - op)) return -1;
+
+        const unsigned char *match = op - offset;
+        if (offset >= matchLength) {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            // overlapping copy repeats the last offset bytes
+            for (size_t i = 0; i < matchLength; i++) *op++ = *match++;
+        }
+    }
+    return (int)(op - dst);
+}
+
+unsigned int Compression::xxh32(const void *data, size_t length, unsigned int seed) {
+    XXH32State state(seed);
+    state.update(data, length);
+    return state.digest();
+}
+
+
+#pragma - XXH32State
+
+XXH32State::XXH32State(unsigned int seed) {
+    this->seed = seed;
+    this->v[0] = seed + XXH_PRIME32_1 + XXH_PRIME32_2;
+    this->v[1] = seed + XXH_PRIME32_2;
+    this->v[2] = seed;
+    this->v[3] = seed - XXH_PRIME32_1;
+}
+
+void XXH32State::update(const void *data, size_t length) {
+    const unsigned char *p = (const unsigned char *)data;
+    const unsigned char *end = p + length;
+    this->totalLength += length;
+
+    if (this->memSize + length < 16) {
+        if (length > 0) memcpy(this->mem + this->memSize, p, length);
+        this->memSize += (unsigned int)length;
+        return;
+    }
+    if (this->memSize > 0) {
+        unsigned int fill = 16 - this->memSize;
+        memcpy(this->mem + this->memSize, p, fill);
+        for (int i = 0; i < 4; i++) {
+            this->v[i] = xxh32Round(this->v[i], readLE32(this->mem + i * 4));
+        }
+        p += fill;
+        this->memSize = 0;
+    }
+    while (end - p >= 16) {
+        for (int i = 0; i < 4; i++) {
+            this->v[i] = xxh32Round(this->v[i], readLE32(p + i * 4));
+        }
+        p += 16;
+    }
+    if (p < end) {
+        memcpy(this->mem, p, end - p);
+        this->memSize = (unsigned int)(end - p);
+    }
+}
+
+unsigned int XXH32State::digest() const {
+    unsigned int h;
+    if (this->totalLength >= 16) {
+        h = rotl32(this->v[0], 1) + rotl32(this->v[1], 7) + rotl32(this->v[2], 12) + rotl32(this->v[3], 18);
+    } else {
+        h = this->seed + XXH_PRIME32_5;
+    }
+    h += (unsigned int)this->totalLength;
+
+    const unsigned char *p = this->mem;
+    const unsigned char *end = p + this->memSize;
+    while (end - p >= 4) {
+        h += readLE32(p) * XXH_PRIME32_3;
+        h = rotl32(h, 17) * XXH_PRIME32_4;
+        p += 4;
+    }
+    while (p < end) {
+        h += (*p) * XXH_PRIME32_5;
+        h = rotl32(h, 11) * XXH_PRIME32_1;
+        p++;
+    }
+    h ^= h >> 15;
+    h *= XXH_PRIME32_2;
+    h ^= h >> 13;
+    h *= XXH_PRIME32_3;
+    h ^= h >> 16;
+    return h;
+}
+
+
+#pragma - CompressStreamBuffer
+
+CompressStreamBuffer::CompressStreamBuffer(std::ostream &sink, long long contentSize) : sink(sink) {
+    this->contentSize = contentSize;
+    this->block.resize(LZ4_BLOCK_SIZE);
+    this->compressed.resize(Compression::compressBound(LZ4_BLOCK_SIZE));
+    this->setp(this->block.data(), this->block.data() + this->block.size());
+}
+
+bool CompressStreamBuffer::writeHeader() {
+    if (this->headerWritten) return true;
+    this->headerWritten = true;
+    unsigned char header[LZ4_FRAME_HEADER_MAX_SIZE];
+    writeLE32(header, LZ4_FRAME_MAGIC);
+    // version 01, independent blocks, content checksum
+    header[4] = 0x40 | 0x20 | 0x04;
+    header[5] = LZ4_BLOCK_SIZE_ID << 4;
+    unsigned int size = 6;
+    if (this->contentSize >= 0) {
+        header[4] |= 0x08;
+        unsigned long long contentSize = (unsigned long long)this->contentSize;
+        for (int i = 0; i < 8; i++) {
+            header[size++] = (unsigned char)(contentSize >> (i * 8));
+        }
+    }
+    header[size] = (unsigned char)((Compression::xxh32(header + 4, size - 4) >> 8) & 0xFF);
+    size++;
+    this->sink.write((const char *)header, size);
+    return !this->sink.fail();
+}
+
+bool CompressStreamBuffer::writeBlock() {
+    int length = (int)(this->pptr() - this->pbase());
+    this->setp(this->block.data(), this->block.data() + this->block.size());
+    if (!this->writeHeader()) return false;
+    if (length == 0) return true;
+
+    this->checksum.update(this->block.data(), length);
+    int compressedLength = Compression::compressBlock((const unsigned char *)this->block.data(), length,
+                                                      (unsigned char *)this->compressed.data(), (int)this->compressed.size());
+    unsigned char blockHeader[4];
+    if (compressedLength > 0 && compressedLength < length) {
+        writeLE32(blockHeader, (unsigned int)compressedLength);
+        this->sink.write((const char *)blockHeader, 4);
+        this->sink.write(this->compressed.data(), compressedLength);
+    } else {
+        writeLE32(blockHeader, (unsigned int)length | LZ4_UNCOMPRESSED_FLAG);
+        this->sink.write((const char *)blockHeader, 4);
+        this->sink.write(this->block.data(), length);
+    }
+    return !this->sink.fail();
+}
+
+CompressStreamBuffer::int_type CompressStreamBuffer::overflow(int_type c) {
+    if (this->finished) return traits_type::eof();
+    if (!this->writeBlock()) return traits_type::eof();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *this->pptr() = traits_type::to_char_type(c);
+        this->pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int CompressStreamBuffer::sync() {
+    return 0;
+}
+
+bool CompressStreamBuffer::finish() {
+    if (this->finished) return true;
+    bool ret = this->writeBlock();
+    this->finished = true;
+    this->setp(nullptr, nullptr);
+    unsigned char trailer[8];
+    writeLE32(trailer, 0);
+    writeLE32(trailer + 4, this->checksum.digest());
+    this->sink.write((const char *)trailer, 8);
+    return ret && !this->sink.fail();
+}
+
+
+#pragma - DecompressStreamBuffer
+
+DecompressStreamBuffer::DecompressStreamBuffer(std::istream &source) {
+    this->source = source.rdbuf();
+    this->setg(nullptr, nullptr, nullptr);
+}
+
+bool DecompressStreamBuffer::hasError() const {
+    return this->error;
+}
+
+long long DecompressStreamBuffer::getContentSize() {
+    if (!this->inFrame && this->frameCount == 0 && !this->finished) {
+        this->readFrameHeader();
+    }
+    return this->contentSize;
+}
+
+bool DecompressStreamBuffer::fail(const char *message) {
+    LOGE("DecompressStreamBuffer: %s", message);
+    this->error = true;
+    this->finished = true;
+    this->setg(nullptr, nullptr, nullptr);
+    return false;
+}
+
+bool DecompressStreamBuffer::readFrameHeader() {
+    while (true) {
+        unsigned char header[LZ4_FRAME_HEADER_MAX_SIZE];
+        std::streamsize n = this->source->sgetn((char *)header, 4);
+        if (n == 0 && this->frameCount > 0) {
+            this->finished = true;
+            return false;
+        }
+        if (n != 4) return this->fail("unexpected end of data");
+
+        unsigned int magic = readLE32(header);
+        if ((magic & LZ4_SKIPPABLE_MASK) == LZ4_SKIPPABLE_MAGIC) {
+            if (this->source->sgetn((char *)header, 4) != 4) return this->fail("unexpected end of data");
+            unsigned int size = readLE32(header);
+            char skip[256];
+            while (size > 0) {
+                std::streamsize len = size < sizeof(skip) ? size : sizeof(skip);
+                if (this->source->sgetn(skip, len) != len) return this->fail("unexpected end of data");
+                size -= (unsigned int)len;
+            }
+            continue;
+        }
+        if (magic != LZ4_FRAME_MAGIC) return this->fail("not a lz4 frame");
+
+        if (this->source->sgetn((char *)header + 4, 2) != 2) return this->fail("unexpected end of data");
+        unsigned int descriptorLength = 2 + ((header[4] & 0x08) ? 8 : 0) + 1;
+        if (this->source->sgetn((char *)header + 6, descriptorLength - 2) != descriptorLength - 2) return this->fail("unexpected end of data");
+        if (parseFrameDescriptor(header + 4, descriptorLength) != descriptorLength) return this->fail("invalid frame header");
+
+        unsigned char flg = header[4];
+        this->blockIndependent = (flg & 0x20) != 0;
+        this->blockChecksum = (flg & 0x10) != 0;
+        this->contentChecksum = (flg & 0x04) != 0;
+        this->contentSize = -1;
+        if (flg & 0x08) {
+            unsigned long long size = 0;
+            for (int i = 0; i < 8; i++) {
+                size |= (unsigned long long)header[6 + i] << (i * 8);
+            }
+            this->contentSize = (long long)size;
+        }
+        this->blockMaxSize = blockMaxSizeOf((header[5] >> 4) & 0x07);
+        if (this->window.size() < LZ4_MAX_DISTANCE + 1 + this->blockMaxSize) {
+            this->window.resize(LZ4_MAX_DISTANCE + 1 + this->blockMaxSize);
+        }
+        if (this->compressed.size() < this->blockMaxSize) {
+            this->compressed.resize(this->blockMaxSize);
+        }
+        this->historyLength = 0;
+        this->decodedSize = 0;
+        this->checksum = XXH32State();
+        this->frameCount++;
+        this->inFrame = true;
+        return true;
+    }
+}
+
+bool DecompressStreamBuffer::readBlock() {
+    unsigned char blockHeader[4];
+    if (this->source->sgetn((char *)blockHeader, 4) != 4) return this->fail("unexpected end of data");
+    unsigned int blockSize = readLE32(blockHeader);
+
+    if (blockSize == 0) {
+        if (this->contentChecksum) {
+            if (this->source->sgetn((char *)blockHeader, 4) != 4) return this->fail("unexpected end of data");
+            if (readLE32(blockHeader) != this->checksum.digest()) return this->fail("content checksum mismatch");
+        }
+        if (this->contentSize >= 0 && (unsigned long long)this->contentSize != this->decodedSize) {
+            return this->fail("content size mismatch");
+        }
+        this->inFrame = false;
+        return true;
+    }
+
+    bool uncompressed = (blockSize & LZ4_UNCOMPRESSED_FLAG) != 0;
+    blockSize &= ~LZ4_UNCOMPRESSED_FLAG;
+    if (blockSize > this->blockMaxSize) return this->fail("invalid block size");
+    if (this->source->sgetn(this->compressed.data(), blockSize) != (std::streamsize)blockSize) return this->fail("unexpected end of data");
+    if (this->blockChecksum) {
+        unsigned char blockChecksum[4];
+        if (this->source->sgetn((char *)blockChecksum, 4) != 4) return this->fail("unexpected end of data");
+        if (readLE32(blockChecksum) != Compression::xxh32(this->compressed.data(), blockSize)) return this->fail("block checksum mismatch");
+    }
+
+    // linked blocks may refer to the last 64KB of output
+    unsigned int prefixLength = 0;
+    if (!this->blockIndependent) {
+        prefixLength = this->historyLength;
+        if (prefixLength > LZ4_MAX_DISTANCE) {
+            memmove(this->window.data(), this->window.data() + prefixLength - LZ4_MAX_DISTANCE, LZ4_MAX_DISTANCE);
+            prefixLength = LZ4_MAX_DISTANCE;
+        }
+    }
+    char *out = this->window.data() + prefixLength;
+    int length;
+    if (uncompressed) {
+        memcpy(out, this->compressed.data(), blockSize);
+        length = (int)blockSize;
+    } else {
+        length = Compression::decompressBlock((const unsigned char *)this->compressed.data(), (int)blockSize,
+                                              (unsigned char *)out, (int)this->blockMaxSize, (int)prefixLength);
+        if (length < 0) return this->fail("corrupted block");
+    }
+    if (this->contentChecksum) {
+        this->checksum.update(out, length);
+    }
+    this->decodedSize += length;
+    this->historyLength = prefixLength + length;
+    this->setg(out, out, out + length);
+    return true;
+}
+
+DecompressStreamBuffer::int_type DecompressStreamBuffer::underflow() {
+    while (this->gptr() == this->egptr()) {
+        if (this->finished) return traits_type::eof();
+        if (!this->inFrame) {
+            if (!this->readFrameHeader()) return traits_type::eof();
+            continue;
+        }
+        if (!this->readBlock()) return traits_type::eof();
+    }
+    return traits_type::to_int_type(*this->gptr());
+}
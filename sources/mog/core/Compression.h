@@ -0,0 +1,107 @@
+#ifndef Compression_h
+#define Compression_h
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "mog/core/Data.h"
+
+namespace mog {
+    // LZ4 frame format, readable and writable by the lz4 command line tool.
+    // frames are written with independent 64KB blocks and a content checksum.
+    class Compression {
+    public:
+        static bool isCompressed(const void *data, size_t length);
+        static bool isCompressed(const std::shared_ptr<ByteArray> &bytes);
+        static std::shared_ptr<ByteArray> compress(const std::shared_ptr<ByteArray> &bytes);
+        // returns nullptr when the frame is corrupted
+        static std::shared_ptr<ByteArray> decompress(const std::shared_ptr<ByteArray> &bytes);
+
+        // LZ4 block format. returns 0 when dst is too small
+        static int compressBound(int length);
+        static int compressBlock(const unsigned char *src, int srcLength, unsigned char *dst, int dstCapacity);
+        // matches may refer up to prefixLength bytes before dst. returns -1 when corrupted
+        static int decompressBlock(const unsigned char *src, int srcLength, unsigned char *dst, int dstCapacity, int prefixLength = 0);
+
+        static unsigned int xxh32(const void *data, size_t length, unsigned int seed = 0);
+    };
+
+
+    class XXH32State {
+    public:
+        XXH32State(unsigned int seed = 0);
+        void update(const void *data, size_t length);
+        unsigned int digest() const;
+
+    private:
+        unsigned int seed;
+        unsigned int v[4];
+        unsigned long long totalLength = 0;
+        unsigned char mem[16];
+        unsigned int memSize = 0;
+    };
+
+
+    // compresses everything written to it into a frame on sink. call finish() to complete the frame.
+    class CompressStreamBuffer : public std::streambuf {
+    public:
+        // contentSize is stored in the frame header when known
+        CompressStreamBuffer(std::ostream &sink, long long contentSize = -1);
+
+        bool finish();
+
+    protected:
+        virtual int_type overflow(int_type c) override;
+        virtual int sync() override;
+
+    private:
+        std::ostream &sink;
+        long long contentSize = -1;
+        std::vector<char> block;
+        std::vector<char> compressed;
+        XXH32State checksum;
+        bool headerWritten = false;
+        bool finished = false;
+
+        bool writeHeader();
+        bool writeBlock();
+    };
+
+
+    // decompresses frames read from source as they are consumed, keeping at most one block and its history in memory
+    class DecompressStreamBuffer : public std::streambuf {
+    public:
+        DecompressStreamBuffer(std::istream &source);
+
+        bool hasError() const;
+        // -1 when the frame header has no content size
+        long long getContentSize();
+
+    protected:
+        virtual int_type underflow() override;
+
+    private:
+        std::streambuf *source;
+        std::vector<char> window;
+        std::vector<char> compressed;
+        unsigned int blockMaxSize = 0;
+        unsigned int historyLength = 0;
+        bool blockIndependent = true;
+        bool blockChecksum = false;
+        bool contentChecksum = false;
+        long long contentSize = -1;
+        unsigned long long decodedSize = 0;
+        XXH32State checksum;
+        int frameCount = 0;
+        bool inFrame = false;
+        bool finished = false;
+        bool error = false;
+
+        bool readFrameHeader();
+        bool readBlock();
+        bool fail(const char *message);
+    };
+}
+
+#endif /* Compression_h */
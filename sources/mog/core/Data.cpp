@@ -5,6 +5,8 @@
 #include <string.h>
 #include <algorithm>
 
+#define DICTIONARY_MIN_SLOTS 8
+
 using namespace mog;
 
 #pragma - Data
@@ -14,13 +16,20 @@ void *enabler;
 #pragma - Null
 
 std::shared_ptr<Null> Null::create() {
-    return std::shared_ptr<Null>(new Null());
+    auto null = std::shared_ptr<Null>(new Null());
+    null->type = DataType::Void;
+    return null;
 }
 
 void Null::write(std::ostream &out) {
+    out.write((char *)&this->type, sizeof(char));
 }
 
 void Null::read(std::istream &in) {
+    in.read((char *)&this->type, sizeof(char));
+    if (this->type != DataType::Void) {
+        throw std::ios_base::failure("data type is not match. type=Void");
+    }
 }
 
 
@@ -171,25 +180,36 @@ void Bool::read(std::istream &in) {
 
 #pragma - ByteArray
 
-std::shared_ptr<ByteArray> ByteArray::create(unsigned char *value, unsigned int length, bool copy) {
-    return std::shared_ptr<ByteArray>(new ByteArray(value, length, copy));
+static std::shared_ptr<void> allocateStorage(unsigned char *value) {
+    if (value == nullptr) return nullptr;
+    return std::shared_ptr<void>(value, [](void *p) { mogfree(p); });
 }
 
-ByteArray::ByteArray(unsigned char *value, unsigned int length, bool copy) {
-    this->type = DataType::ByteArray;
-    if (copy) {
-        this->value = (unsigned char *)mogmalloc(sizeof(unsigned char) * length);
-        memcpy(this->value, value, length);
-    } else {
-        this->value = value;
+std::shared_ptr<ByteArray> ByteArray::create(unsigned char *value, unsigned int length, bool copy) {
+    if (copy && value != nullptr) {
+        unsigned char *copied = (unsigned char *)mogmalloc(sizeof(unsigned char) * length);
+        memcpy(copied, value, length);
+        value = copied;
     }
-    this->length = length;
+    return std::shared_ptr<ByteArray>(new ByteArray(allocateStorage(value), value, length));
 }
 
-ByteArray::~ByteArray() {
-    if (this->value != nullptr) {
-        mogfree(this->value);
-    }
+std::shared_ptr<ByteArray> ByteArray::createWithDeleter(unsigned char *value, unsigned int length, std::function<void(unsigned char *value)> deleter) {
+    auto storage = std::shared_ptr<void>(value, [deleter](void *p) {
+        if (deleter) deleter((unsigned char *)p);
+    });
+    return std::shared_ptr<ByteArray>(new ByteArray(storage, value, length));
+}
+
+std::shared_ptr<ByteArray> ByteArray::createWithOwner(const std::shared_ptr<void> &owner, unsigned char *value, unsigned int length) {
+    return std::shared_ptr<ByteArray>(new ByteArray(owner, value, length));
+}
+
+ByteArray::ByteArray(const std::shared_ptr<void> &storage, unsigned char *value, unsigned int length) {
+    this->type = DataType::ByteArray;
+    this->storage = storage;
+    this->value = value;
+    this->length = value ? length : 0;
 }
 
 void ByteArray::getValue(unsigned char **value, unsigned int *length) {
@@ -215,6 +235,12 @@ unsigned char *ByteArray::getBytes(bool copy) {
     }
 }
 
+std::shared_ptr<ByteArray> ByteArray::slice(unsigned int offset, unsigned int length) {
+    if (offset > this->length) offset = this->length;
+    if (length > this->length - offset) length = this->length - offset;
+    return std::shared_ptr<ByteArray>(new ByteArray(this->storage, this->value ? this->value + offset : nullptr, length));
+}
+
 void ByteArray::write(std::ostream &out) {
     out.write((char *)&this->type, sizeof(char));
     out.write((char *)&this->length, sizeof(unsigned int));
@@ -227,6 +253,8 @@ void ByteArray::read(std::istream &in) {
         throw std::ios_base::failure("data type is not match. type=ByteArray");
     }
     in.read((char *)&this->length, sizeof(unsigned int));
+    this->value = (unsigned char *)mogmalloc(sizeof(unsigned char) * this->length);
+    this->storage = allocateStorage(this->value);
     in.read((char *)this->value, this->length * sizeof(char));
 }
 
@@ -239,6 +267,93 @@ std::string ByteArray::toString() const {
 }
 
 
+#pragma - ByteArrayStreamBuffer
+
+ByteArrayStreamBuffer::ByteArrayStreamBuffer(const std::shared_ptr<ByteArray> &bytes) {
+    this->bytes = bytes;
+    unsigned char *value = nullptr;
+    unsigned int length = 0;
+    if (bytes) bytes->getValue(&value, &length);
+    this->setg((char *)value, (char *)value, (char *)value + length);
+}
+
+ByteArrayStreamBuffer::pos_type ByteArrayStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+    if ((which & std::ios_base::in) == 0) return pos_type(off_type(-1));
+    off_type base = 0;
+    if (dir == std::ios_base::cur) {
+        base = this->gptr() - this->eback();
+    } else if (dir == std::ios_base::end) {
+        base = this->egptr() - this->eback();
+    }
+    off_type pos = base + off;
+    if (pos < 0 || pos > this->egptr() - this->eback()) return pos_type(off_type(-1));
+    this->setg(this->eback(), this->eback() + pos, this->egptr());
+    return pos_type(pos);
+}
+
+ByteArrayStreamBuffer::pos_type ByteArrayStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which) {
+    return this->seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+
+#pragma - ByteArrayBuilder
+
+ByteArrayBuilder::ByteArrayBuilder(unsigned int capacity) {
+    this->reserve(capacity > 0 ? capacity : 1);
+}
+
+ByteArrayBuilder::~ByteArrayBuilder() {
+    if (this->buffer) {
+        mogfree(this->buffer);
+    }
+}
+
+unsigned int ByteArrayBuilder::getLength() const {
+    return (unsigned int)(this->pptr() - this->pbase());
+}
+
+std::shared_ptr<ByteArray> ByteArrayBuilder::toByteArray() {
+    unsigned int length = this->getLength();
+    auto bytes = ByteArray::create((unsigned char *)this->buffer, length);
+    this->buffer = nullptr;
+    this->capacity = 0;
+    this->setp(nullptr, nullptr);
+    return bytes;
+}
+
+bool ByteArrayBuilder::reserve(size_t size) {
+    if (size <= this->capacity) return true;
+    if (size > UINT_MAX) return false;
+    size_t capacity = this->capacity > 0 ? this->capacity : 256;
+    while (capacity < size) capacity = capacity > UINT_MAX / 2 ? UINT_MAX : capacity * 2;
+    if (capacity > UINT_MAX) capacity = UINT_MAX;
+    size_t length = this->buffer ? this->pptr() - this->pbase() : 0;
+    char *buffer = (char *)mogrealloc(this->buffer, capacity);
+    if (buffer == nullptr) return false;
+    this->buffer = buffer;
+    this->capacity = (unsigned int)capacity;
+    this->setp(buffer, buffer + capacity);
+    this->pbump((int)length);
+    return true;
+}
+
+ByteArrayBuilder::int_type ByteArrayBuilder::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    if (!this->reserve((size_t)this->getLength() + 1)) return traits_type::eof();
+    *this->pptr() = traits_type::to_char_type(c);
+    this->pbump(1);
+    return c;
+}
+
+std::streamsize ByteArrayBuilder::xsputn(const char *s, std::streamsize n) {
+    if (n <= 0) return 0;
+    if (!this->reserve((size_t)this->getLength() + (size_t)n)) return 0;
+    memcpy(this->pptr(), s, (size_t)n);
+    this->pbump((int)n);
+    return n;
+}
+
+
 #pragma - String
 
 std::shared_ptr<String> String::create(std::string value) {
@@ -287,10 +402,378 @@ void String::read(std::istream &in) {
 }
 
 std::shared_ptr<ByteArray> String::toByteArray() {
-    unsigned char *byteArr = new unsigned char[this->value.size()];
-    const char *str = this->value.c_str();
-    memcpy(byteArr, str, this->value.size());
-    return ByteArray::create(byteArr, (unsigned int)this->value.size());
+    return ByteArray::createWithOwner(shared_from_this(), (unsigned char *)&this->value[0], (unsigned int)this->value.size());
+}
+
+
+#pragma - DataValue
+
+DataValue::DataValue(int value) {
+    this->type = DataType::Int;
+    this->value.i = value;
+}
+
+DataValue::DataValue(long long value) {
+    this->type = DataType::Long;
+    this->value.l = value;
+}
+
+DataValue::DataValue(float value) {
+    this->type = DataType::Float;
+    this->value.f = value;
+}
+
+DataValue::DataValue(double value) {
+    this->type = DataType::Double;
+    this->value.d = value;
+}
+
+DataValue::DataValue(bool value) {
+    this->type = DataType::Bool;
+    this->value.b = value;
+}
+
+DataValue::DataValue(const std::string &value) {
+    if (value.length() <= inlineStringSize) {
+        this->setString(value.data(), value.length());
+    } else {
+        this->type = DataType::String;
+        this->boxed = true;
+        new (&this->value.data) std::shared_ptr<Data>(String::create(value));
+    }
+}
+
+DataValue::DataValue(const std::shared_ptr<Data> &data) {
+    if (!data) return;
+
+    switch (data->type) {
+        case DataType::Void:
+            return;
+        case DataType::Int:
+            this->type = DataType::Int;
+            this->value.i = std::static_pointer_cast<Int>(data)->getValue();
+            return;
+        case DataType::Long:
+            this->type = DataType::Long;
+            this->value.l = std::static_pointer_cast<Long>(data)->getValue();
+            return;
+        case DataType::Float:
+            this->type = DataType::Float;
+            this->value.f = std::static_pointer_cast<Float>(data)->getValue();
+            return;
+        case DataType::Double:
+            this->type = DataType::Double;
+            this->value.d = std::static_pointer_cast<Double>(data)->getValue();
+            return;
+        case DataType::Bool:
+            this->type = DataType::Bool;
+            this->value.b = std::static_pointer_cast<Bool>(data)->getValue();
+            return;
+        case DataType::String: {
+            auto str = std::static_pointer_cast<String>(data);
+            if (str->value.length() <= inlineStringSize) {
+                this->setString(str->value.data(), str->value.length());
+                return;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    this->type = data->type;
+    this->boxed = true;
+    new (&this->value.data) std::shared_ptr<Data>(data);
+}
+
+DataValue::DataValue(const DataValue &value) {
+    this->copyFrom(value);
+}
+
+DataValue::DataValue(DataValue &&value) {
+    this->moveFrom(value);
+}
+
+DataValue &DataValue::operator=(const DataValue &value) {
+    if (this != &value) {
+        this->release();
+        this->copyFrom(value);
+    }
+    return *this;
+}
+
+DataValue &DataValue::operator=(DataValue &&value) {
+    if (this != &value) {
+        this->release();
+        this->moveFrom(value);
+    }
+    return *this;
+}
+
+DataValue::~DataValue() {
+    this->release();
+}
+
+void DataValue::setString(const char *str, size_t length) {
+    this->type = DataType::String;
+    this->length = (unsigned char)length;
+    memcpy(this->value.str, str, length);
+}
+
+// only the active member is copied
+void DataValue::copyFrom(const DataValue &value) {
+    this->type = value.type;
+    this->boxed = value.boxed;
+    this->length = value.length;
+    if (value.boxed) {
+        new (&this->value.data) std::shared_ptr<Data>(value.value.data);
+        return;
+    }
+    switch (value.type) {
+        case DataType::Int:
+            this->value.i = value.value.i;
+            break;
+        case DataType::Long:
+            this->value.l = value.value.l;
+            break;
+        case DataType::Float:
+            this->value.f = value.value.f;
+            break;
+        case DataType::Double:
+            this->value.d = value.value.d;
+            break;
+        case DataType::Bool:
+            this->value.b = value.value.b;
+            break;
+        case DataType::String:
+            memcpy(this->value.str, value.value.str, value.length);
+            break;
+        default:
+            break;
+    }
+}
+
+void DataValue::moveFrom(DataValue &value) {
+    if (!value.boxed) {
+        this->copyFrom(value);
+        return;
+    }
+    this->type = value.type;
+    this->boxed = true;
+    this->length = value.length;
+    new (&this->value.data) std::shared_ptr<Data>(std::move(value.value.data));
+}
+
+void DataValue::release() {
+    if (this->boxed) {
+        this->value.data.~shared_ptr<Data>();
+        this->boxed = false;
+    }
+    this->type = DataType::Void;
+}
+
+bool DataValue::isNumber() const {
+    switch (this->type) {
+        case DataType::Int:
+        case DataType::Long:
+        case DataType::Float:
+        case DataType::Double:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int DataValue::getInt(int defaultValue) const {
+    switch (this->type) {
+        case DataType::Int:
+            return this->value.i;
+        case DataType::Long:
+            return (int)this->value.l;
+        case DataType::Float:
+            return (int)this->value.f;
+        case DataType::Double:
+            return (int)this->value.d;
+        default:
+            return defaultValue;
+    }
+}
+
+long long DataValue::getLong(long long defaultValue) const {
+    switch (this->type) {
+        case DataType::Int:
+            return this->value.i;
+        case DataType::Long:
+            return this->value.l;
+        case DataType::Float:
+            return (long long)this->value.f;
+        case DataType::Double:
+            return (long long)this->value.d;
+        default:
+            return defaultValue;
+    }
+}
+
+float DataValue::getFloat(float defaultValue) const {
+    switch (this->type) {
+        case DataType::Int:
+            return (float)this->value.i;
+        case DataType::Long:
+            return (float)this->value.l;
+        case DataType::Float:
+            return this->value.f;
+        case DataType::Double:
+            return (float)this->value.d;
+        default:
+            return defaultValue;
+    }
+}
+
+double DataValue::getDouble(double defaultValue) const {
+    switch (this->type) {
+        case DataType::Int:
+            return (double)this->value.i;
+        case DataType::Long:
+            return (double)this->value.l;
+        case DataType::Float:
+            return (double)this->value.f;
+        case DataType::Double:
+            return this->value.d;
+        default:
+            return defaultValue;
+    }
+}
+
+bool DataValue::getBool() const {
+    return this->type == DataType::Bool && this->value.b;
+}
+
+std::string DataValue::getString() const {
+    if (this->type != DataType::String) return "";
+    if (this->boxed) {
+        return std::static_pointer_cast<String>(this->value.data)->value;
+    }
+    return std::string(this->value.str, this->length);
+}
+
+std::shared_ptr<Data> DataValue::toData() const {
+    if (this->boxed) return this->value.data;
+
+    switch (this->type) {
+        case DataType::Int:
+            return Int::create(this->value.i);
+        case DataType::Long:
+            return Long::create(this->value.l);
+        case DataType::Float:
+            return Float::create(this->value.f);
+        case DataType::Double:
+            return Double::create(this->value.d);
+        case DataType::Bool:
+            return Bool::create(this->value.b);
+        case DataType::String:
+            return String::create(std::string(this->value.str, this->length));
+        default:
+            return Null::create();
+    }
+}
+
+// same layout as the write of each Data class
+void DataValue::write(std::ostream &out) const {
+    if (this->boxed) {
+        this->value.data->write(out);
+        return;
+    }
+    out.write((char *)&this->type, sizeof(char));
+    switch (this->type) {
+        case DataType::Int:
+            out.write((char *)&this->value.i, sizeof(int));
+            break;
+        case DataType::Long:
+            out.write((char *)&this->value.l, sizeof(long long));
+            break;
+        case DataType::Float:
+            out.write((char *)&this->value.f, sizeof(float));
+            break;
+        case DataType::Double:
+            out.write((char *)&this->value.d, sizeof(double));
+            break;
+        case DataType::Bool:
+            out.write((char *)&this->value.b, sizeof(bool));
+            break;
+        case DataType::String: {
+            unsigned int size = this->length;
+            out.write((char *)&size, sizeof(unsigned int));
+            out.write(this->value.str, size);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+DataValue DataValue::read(std::istream &in) {
+    DataType type = (DataType)in.peek();
+    DataValue value;
+    switch (type) {
+        case DataType::Void:
+            in.get();
+            return value;
+        case DataType::Int:
+            in.get();
+            value.type = type;
+            in.read((char *)&value.value.i, sizeof(int));
+            return value;
+        case DataType::Long:
+            in.get();
+            value.type = type;
+            in.read((char *)&value.value.l, sizeof(long long));
+            return value;
+        case DataType::Float:
+            in.get();
+            value.type = type;
+            in.read((char *)&value.value.f, sizeof(float));
+            return value;
+        case DataType::Double:
+            in.get();
+            value.type = type;
+            in.read((char *)&value.value.d, sizeof(double));
+            return value;
+        case DataType::Bool:
+            in.get();
+            value.type = type;
+            in.read((char *)&value.value.b, sizeof(bool));
+            return value;
+        case DataType::String: {
+            in.get();
+            unsigned int size;
+            in.read((char *)&size, sizeof(unsigned int));
+            if (size <= inlineStringSize) {
+                value.type = type;
+                value.length = (unsigned char)size;
+                in.read(value.value.str, size);
+                return value;
+            }
+            std::string str(size, '\0');
+            in.read(&str[0], size);
+            return DataValue(str);
+        }
+        case DataType::ByteArray: {
+            auto data = ByteArray::create(nullptr, 0);
+            data->read(in);
+            return DataValue(data);
+        }
+        case DataType::List: {
+            auto data = List::create();
+            data->read(in);
+            return DataValue(data);
+        }
+        case DataType::Dictionary: {
+            auto data = Dictionary::create();
+            data->read(in);
+            return DataValue(data);
+        }
+        default:
+            throw std::ios_base::failure("unsupported data type.");
+    }
 }
 
 
@@ -320,20 +803,34 @@ void List::append(const std::shared_ptr<Data> &data) {
     this->datum.emplace_back(data);
 }
 
+void List::append(const DataValue &value) {
+    this->datum.emplace_back(value);
+}
+
 void List::set(int idx, const std::shared_ptr<Data> &data) {
-    this->datum[idx] = data;
+    this->datum[idx] = DataValue(data);
+}
+
+void List::set(int idx, const DataValue &value) {
+    this->datum[idx] = value;
+}
+
+const DataValue &List::valueAt(int idx) const {
+    static const DataValue empty;
+    if (idx < 0 || idx >= (int)this->datum.size()) return empty;
+    return this->datum[idx];
 }
 
 DataType List::atType(int idx) const {
-    return this->datum.at(idx)->type;
+    return this->datum.at(idx).getType();
 }
 
 void List::write(std::ostream &out) {
     out.write((char *)&this->type, sizeof(char));
     unsigned int size = (unsigned int)this->datum.size();
     out.write((char *)&size, sizeof(unsigned int));
-    for (auto &d : this->datum) {
-        d->write(out);
+    for (auto &value : this->datum) {
+        value.write(out);
     }
 }
 
@@ -344,55 +841,8 @@ void List::read(std::istream &in) {
     }
     unsigned int dataSize;
     in.read((char *)&dataSize, sizeof(unsigned int));
-    for (int i = 0; i < dataSize; i++) {
-        auto pos = in.tellg();
-        DataType type;
-        in.read((char *)&type, sizeof(char));
-        in.seekg(pos);
-        
-        std::shared_ptr<Data> data = nullptr;
-        switch (type) {
-            case DataType::Int: {
-                data = Int::create(0);
-                break;
-            }
-            case DataType::Long: {
-                data = Long::create(0);
-                break;
-            }
-            case DataType::Float: {
-                data = Float::create(0.0f);
-                break;
-            }
-            case DataType::Double: {
-                data = Double::create(0.0);
-                break;
-            }
-            case DataType::Bool: {
-                data = Bool::create(false);
-                break;
-            }
-            case DataType::String: {
-                data = String::create("");
-                break;
-            }
-            case DataType::ByteArray: {
-                data = ByteArray::create(nullptr, 0);
-                break;
-            }
-            case DataType::List: {
-                data = List::create();
-                break;
-            }
-            case DataType::Dictionary: {
-                data = Dictionary::create();
-                break;
-            }
-            default:
-                break;
-        }
-        data->read(in);
-        this->append(data);
+    for (unsigned int i = 0; i < dataSize; i++) {
+        this->datum.emplace_back(DataValue::read(in));
     }
 }
 
@@ -407,53 +857,160 @@ Dictionary::Dictionary() {
     this->type = DataType::Dictionary;
 }
 
-void Dictionary::remove(std::string key) {
-    this->datum.erase(key);
+const Dictionary::Entry *Dictionary::find(const Symbol &key) const {
+    if (this->slots.empty()) return nullptr;
+    size_t mask = this->slots.size() - 1;
+    size_t i = key.hash() & mask;
+    while (this->slots[i] >= 0) {
+        const Entry &entry = this->entries[this->slots[i]];
+        if (entry.key == key) return &entry;
+        i = (i + 1) & mask;
+    }
+    return nullptr;
+}
+
+const Dictionary::Entry *Dictionary::find(const char *key, size_t length) const {
+    if (this->slots.empty()) return nullptr;
+    size_t hash = Symbol::hash(key, length);
+    size_t mask = this->slots.size() - 1;
+    size_t i = hash & mask;
+    while (this->slots[i] >= 0) {
+        const Entry &entry = this->entries[this->slots[i]];
+        if (entry.key.hash() == hash && entry.key.str().length() == length &&
+            memcmp(entry.key.str().data(), key, length) == 0) {
+            return &entry;
+        }
+        i = (i + 1) & mask;
+    }
+    return nullptr;
+}
+
+void Dictionary::rebuildSlots(size_t capacity) {
+    size_t size = DICTIONARY_MIN_SLOTS;
+    while (size < capacity * 2) size <<= 1;
+    this->slots.assign(size, -1);
+    size_t mask = size - 1;
+    for (int idx = 0; idx < (int)this->entries.size(); idx++) {
+        size_t i = this->entries[idx].key.hash() & mask;
+        while (this->slots[i] >= 0) {
+            i = (i + 1) & mask;
+        }
+        this->slots[i] = idx;
+    }
+}
+
+void Dictionary::remove(const std::string &key) {
+    auto entry = this->find(key.c_str(), key.length());
+    if (!entry) return;
+    this->entries.erase(this->entries.begin() + (entry - this->entries.data()));
+    this->rebuildSlots(this->entries.size());
 }
 
 void Dictionary::clear() {
-    this->datum.clear();
+    this->entries.clear();
+    this->slots.clear();
 }
 
 unsigned int Dictionary::size() const {
-    return (unsigned int)this->datum.size();
+    return (unsigned int)this->entries.size();
+}
+
+void Dictionary::put(const Symbol &key, const std::shared_ptr<Data> &data) {
+    this->put(key, DataValue(data));
 }
 
-void Dictionary::put(std::string key, const std::shared_ptr<Data> &data) {
-    this->datum[key] = data;
+void Dictionary::put(const Symbol &key, const DataValue &value) {
+    auto entry = this->find(key);
+    if (entry) {
+        const_cast<Entry *>(entry)->value = value;
+        return;
+    }
+    this->entries.push_back({key, value});
+    if (this->entries.size() * 2 > this->slots.size()) {
+        this->rebuildSlots(this->entries.size());
+        return;
+    }
+    size_t mask = this->slots.size() - 1;
+    size_t i = key.hash() & mask;
+    while (this->slots[i] >= 0) {
+        i = (i + 1) & mask;
+    }
+    this->slots[i] = (int)this->entries.size() - 1;
 }
 
-std::vector<std::string> Dictionary::getKeys() const {
+std::vector<std::string> Dictionary::getKeys(bool sorted) const {
     std::vector<std::string> keys;
-    keys.reserve(this->datum.size());
-    for (auto &pair : this->datum) {
-        keys.emplace_back(pair.first);
+    keys.reserve(this->entries.size());
+    for (auto &entry : this->entries) {
+        keys.emplace_back(entry.key.str());
+    }
+    if (sorted) {
+        std::sort(keys.begin(), keys.end());
     }
     return keys;
 }
 
 std::pair<std::string, std::shared_ptr<Data>> Dictionary::getKeyValue(int idx) {
-    auto itr = this->datum.begin();
-    for (int i = 0; i < idx; i++) itr++;
-    return std::pair<std::string, std::shared_ptr<Data>>(itr->first, itr->second);
+    const auto &entry = this->entries[idx];
+    return std::pair<std::string, std::shared_ptr<Data>>(entry.key.str(), entry.value.toData());
+}
+
+static const DataValue &getEmptyValue() {
+    static const DataValue empty;
+    return empty;
+}
+
+const DataValue &Dictionary::getValue(const Symbol &key) const {
+    auto entry = this->find(key);
+    return entry ? entry->value : getEmptyValue();
 }
 
-bool Dictionary::hasKey(std::string key) {
-    return this->datum.count(key) > 0;
+const DataValue &Dictionary::getValue(const std::string &key) const {
+    auto entry = this->find(key.c_str(), key.length());
+    return entry ? entry->value : getEmptyValue();
 }
 
-DataType Dictionary::getType(std::string key) const {
-    return this->datum.at(key)->type;
+const DataValue &Dictionary::getValue(const char *key) const {
+    auto entry = this->find(key, strlen(key));
+    return entry ? entry->value : getEmptyValue();
+}
+
+bool Dictionary::hasKey(const Symbol &key) const {
+    return this->find(key) != nullptr;
+}
+
+bool Dictionary::hasKey(const std::string &key) const {
+    return this->find(key.c_str(), key.length()) != nullptr;
+}
+
+bool Dictionary::hasKey(const char *key) const {
+    return this->find(key, strlen(key)) != nullptr;
+}
+
+DataType Dictionary::getType(const Symbol &key) const {
+    auto entry = this->find(key);
+    if (!entry) throw std::out_of_range("Dictionary::getType");
+    return entry->value.getType();
+}
+
+DataType Dictionary::getType(const std::string &key) const {
+    auto entry = this->find(key.c_str(), key.length());
+    if (!entry) throw std::out_of_range("Dictionary::getType");
+    return entry->value.getType();
+}
+
+DataType Dictionary::getType(const char *key) const {
+    return this->getType(std::string(key));
 }
 
 void Dictionary::write(std::ostream &out) {
     out.write((char *)&this->type, sizeof(char));
-    unsigned int size = (unsigned int)this->datum.size();
+    unsigned int size = (unsigned int)this->entries.size();
     out.write((char *)&size, sizeof(unsigned int));
-    for (auto &kv : this->datum) {
-        auto key = String::create(kv.first);
+    for (auto &entry : this->entries) {
+        auto key = String::create(entry.key.str());
         key->write(out);
-        kv.second->write(out);
+        entry.value.write(out);
     }
 }
 
@@ -464,58 +1021,9 @@ void Dictionary::read(std::istream &in) {
     }
     unsigned int dataSize;
     in.read((char *)&dataSize, sizeof(unsigned int));
-    for (int i = 0; i < dataSize; i++) {
+    for (unsigned int i = 0; i < dataSize; i++) {
         auto keyStr = String::create("");
         keyStr->read(in);
-        std::string key = keyStr->getValue();
-        
-        auto pos = in.tellg();
-        DataType type;
-        in.read((char *)&type, sizeof(char));
-        in.seekg(pos);
-
-        std::shared_ptr<Data> data = nullptr;
-        switch (type) {
-            case DataType::Int: {
-                data = Int::create(0);
-                break;
-            }
-            case DataType::Long: {
-                data = Long::create(0);
-                break;
-            }
-            case DataType::Float: {
-                data = Float::create(0.0f);
-                break;
-            }
-            case DataType::Double: {
-                data = Double::create(0.0);
-                break;
-            }
-            case DataType::Bool: {
-                data = Bool::create(false);
-                break;
-            }
-            case DataType::String: {
-                data = String::create("");
-                break;
-            }
-            case DataType::ByteArray: {
-                data = ByteArray::create(nullptr, 0);
-                break;
-            }
-            case DataType::List: {
-                data = List::create();
-                break;
-            }
-            case DataType::Dictionary: {
-                data = Dictionary::create();
-                break;
-            }
-            default:
-                break;
-        }
-        data->read(in);
-        this->put(key, data);
+        this->put(keyStr->getValue(), DataValue::read(in));
     }
 }
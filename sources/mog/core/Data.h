@@ -8,7 +8,11 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <functional>
+#include <climits>
+#include <string.h>
 #include "mog_functions.h"
+#include "mog/core/Symbol.h"
 
 extern void *enabler;
 
@@ -41,9 +45,19 @@ namespace mog {
         }
     };
     
+    template <class T>
+    inline bool isDataType(DataType type) {
+        return type == T::dataType;
+    }
+    template <>
+    inline bool isDataType<Data>(DataType type) {
+        return true;
+    }
+
 
     class Null : public Data {
     public:
+        static constexpr DataType dataType = DataType::Void;
         static std::shared_ptr<Null> create();
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
@@ -52,7 +66,9 @@ namespace mog {
     
     class Int : public Data {
         friend class DataStore;
+        friend class Json;
     public:
+        static constexpr DataType dataType = DataType::Int;
         static std::shared_ptr<Int> create(int value);
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
@@ -68,7 +84,9 @@ namespace mog {
     
     class Long : public Data {
         friend class DataStore;
+        friend class Json;
     public:
+        static constexpr DataType dataType = DataType::Long;
         static std::shared_ptr<Long> create(long long value);
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
@@ -84,7 +102,9 @@ namespace mog {
     
     class Float : public Data {
         friend class DataStore;
+        friend class Json;
     public:
+        static constexpr DataType dataType = DataType::Float;
         static std::shared_ptr<Float> create(float value);
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
@@ -100,7 +120,9 @@ namespace mog {
     
     class Double : public Data {
         friend class DataStore;
+        friend class Json;
     public:
+        static constexpr DataType dataType = DataType::Double;
         static std::shared_ptr<Double> create(double value);
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
@@ -116,7 +138,9 @@ namespace mog {
     
     class Bool : public Data {
         friend class DataStore;
+        friend class Json;
     public:
+        static constexpr DataType dataType = DataType::Bool;
         static std::shared_ptr<Bool> create(bool value);
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
@@ -132,34 +156,83 @@ namespace mog {
     
     class ByteArray : public Data {
         friend class DataStore;
+        friend class Json;
     public:
+        static constexpr DataType dataType = DataType::ByteArray;
+        // without copy, takes ownership of a buffer allocated with mogmalloc
         static std::shared_ptr<ByteArray> create(unsigned char *value, unsigned int length, bool copy = false);
+        // takes ownership of externally allocated memory, deleter is called when the last view is released
+        static std::shared_ptr<ByteArray> createWithDeleter(unsigned char *value, unsigned int length, std::function<void(unsigned char *value)> deleter);
+        // view into memory kept alive by owner
+        static std::shared_ptr<ByteArray> createWithOwner(const std::shared_ptr<void> &owner, unsigned char *value, unsigned int length);
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
         std::string toString();
         std::string toString() const;
-        ~ByteArray();
 
         void getValue(unsigned char **value, unsigned int *length);
         unsigned int getLength();
         unsigned char getByte(int idx);
         unsigned char *getBytes(bool copy = false);
+        // shares the backing storage, out of range is clamped
+        std::shared_ptr<ByteArray> slice(unsigned int offset, unsigned int length = UINT_MAX);
 
     private:
         ByteArray() {}
-        ByteArray(unsigned char *value, unsigned int length, bool copy = false);
+        ByteArray(const std::shared_ptr<void> &storage, unsigned char *value, unsigned int length);
+        std::shared_ptr<void> storage;
         unsigned char *value = nullptr;
         unsigned int length = 0;
     };
 
+
+    // reads a ByteArray in place as a std::istream source
+    class ByteArrayStreamBuffer : public std::streambuf {
+    public:
+        ByteArrayStreamBuffer(const std::shared_ptr<ByteArray> &bytes);
+
+    protected:
+        virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in) override;
+        virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in) override;
+
+    private:
+        std::shared_ptr<ByteArray> bytes;
+    };
+
+
+    // std::ostream sink whose buffer is handed off to a ByteArray without copying
+    class ByteArrayBuilder : public std::streambuf {
+    public:
+        ByteArrayBuilder(unsigned int capacity = 256);
+        ~ByteArrayBuilder();
+
+        unsigned int getLength() const;
+        // the builder is empty afterwards
+        std::shared_ptr<ByteArray> toByteArray();
+
+    protected:
+        virtual int_type overflow(int_type c) override;
+        virtual std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+    private:
+        char *buffer = nullptr;
+        unsigned int capacity = 0;
+
+        bool reserve(size_t size);
+    };
+
     
     class String : public Data {
         friend class DataStore;
+        friend class Json;
+        friend class DataValue;
     public:
+        static constexpr DataType dataType = DataType::String;
         static std::shared_ptr<String> create(std::string value);
         static std::shared_ptr<String> create(const std::shared_ptr<ByteArray> &bytes);
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
+        // shares this string's memory, the bytes must not be modified
         std::shared_ptr<ByteArray> toByteArray();
 
         std::string getValue();
@@ -172,31 +245,107 @@ namespace mog {
     };
     
     
+    // a value held in place by List and Dictionary.
+    // scalars and short strings are stored inline, other values are boxed in their Data object.
+    class DataValue {
+        friend class JsonWriter;
+        friend class DataPackWriter;
+    public:
+        static constexpr size_t inlineStringSize = 16;
+
+        DataValue() {}
+        DataValue(int value);
+        DataValue(long long value);
+        DataValue(float value);
+        DataValue(double value);
+        DataValue(bool value);
+        DataValue(const std::string &value);
+        DataValue(const std::shared_ptr<Data> &data);
+        DataValue(const DataValue &value);
+        DataValue(DataValue &&value);
+        DataValue &operator=(const DataValue &value);
+        DataValue &operator=(DataValue &&value);
+        ~DataValue();
+
+        DataType getType() const {
+            return this->type;
+        }
+        bool isBoxed() const {
+            return this->boxed;
+        }
+
+        bool isNumber() const;
+        // numeric getters convert between Int, Long, Float and Double, other types return defaultValue
+        int getInt(int defaultValue = 0) const;
+        long long getLong(long long defaultValue = 0) const;
+        float getFloat(float defaultValue = 0) const;
+        double getDouble(double defaultValue = 0) const;
+        bool getBool() const;
+        std::string getString() const;
+
+        // inline values are boxed into a new Data
+        std::shared_ptr<Data> toData() const;
+
+        template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
+        std::shared_ptr<T> as() const {
+            if (!isDataType<T>(this->type)) return nullptr;
+            return std::static_pointer_cast<T>(this->toData());
+        }
+
+        void write(std::ostream &out) const;
+        static DataValue read(std::istream &in);
+
+    private:
+        DataType type = DataType::Void;
+        bool boxed = false;
+        unsigned char length = 0;
+        union Value {
+            int i;
+            long long l;
+            float f;
+            double d;
+            bool b;
+            char str[inlineStringSize];
+            std::shared_ptr<Data> data;
+
+            Value() {}
+            ~Value() {}
+        } value;
+
+        void setString(const char *str, size_t length);
+        void copyFrom(const DataValue &value);
+        void moveFrom(DataValue &value);
+        void release();
+    };
+
+
     class List : public Data {
         friend class DataStore;
+        friend class Json;
+        friend class JsonWriter;
+        friend class DataPackWriter;
     public:
+        static constexpr DataType dataType = DataType::List;
         static std::shared_ptr<List> create();
         void append(const std::shared_ptr<Data> &data);
+        void append(const DataValue &value);
         void set(int idx, const std::shared_ptr<Data> &data);
+        void set(int idx, const DataValue &value);
         
+        // scalars are boxed on access, use valueAt to read them without allocation
         template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
         std::shared_ptr<T> at(int idx) const {
-            if (idx < this->datum.size()) {
-                auto d = this->datum[idx];
+            if (idx < 0 || idx >= (int)this->datum.size()) return nullptr;
+            const auto &value = this->datum[idx];
+            if (!isDataType<T>(value.getType())) {
 #ifdef MOG_DEBUG
-                auto dr = d.get();
-                const std::type_info &t1 = typeid(*dr);
-                const std::type_info &t2 = typeid(T);
-                if (t1 != t2) {
-                    LOGE("Type Error : %s, %s\n", t1.name(), t2.name());
-                    return nullptr;
-                }
+                LOGE("Type Error : %d, %s\n", (int)value.getType(), typeid(T).name());
 #endif
-                return std::static_pointer_cast<T>(d);
-            } else {
                 return nullptr;
             }
+            return std::static_pointer_cast<T>(value.toData());
         }
+        const DataValue &valueAt(int idx) const;
         
         void remove(int idx);
         void clear();
@@ -209,52 +358,82 @@ namespace mog {
     private:
         List();
         
-        std::vector<std::shared_ptr<Data>> datum;
+        std::vector<DataValue> datum;
     };
     
     
     class Dictionary : public Data {
         friend class DataStore;
+        friend class Json;
+        friend class JsonWriter;
+        friend class DataPackWriter;
     public:
+        static constexpr DataType dataType = DataType::Dictionary;
         static std::shared_ptr<Dictionary> create();
 
-        void put(std::string key, const std::shared_ptr<Data> &data);
+        void put(const Symbol &key, const std::shared_ptr<Data> &data);
+        void put(const Symbol &key, const DataValue &value);
         
         template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
-        std::shared_ptr<T> get(std::string key) const {
-            if (this->datum.count(key) > 0) {
-                auto d = this->datum.at(key);
-#ifdef MOG_DEBUG
-                auto dr = d.get();
-                const std::type_info &t1 = typeid(*dr);
-                const std::type_info &t2 = typeid(T);
-                if (t1 != t2) {
-                    LOGE("Type Error : %s, %s\n", t1.name(), t2.name());
-                    return nullptr;
-                }
-#endif
-                return std::static_pointer_cast<T>(d);
-                
-            } else {
-                return nullptr;
-            }
+        std::shared_ptr<T> get(const Symbol &key) const {
+            return this->cast<T>(this->find(key));
+        }
+        template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
+        std::shared_ptr<T> get(const std::string &key) const {
+            return this->cast<T>(this->find(key.c_str(), key.length()));
         }
-        DataType getType(std::string key) const;
+        template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
+        std::shared_ptr<T> get(const char *key) const {
+            return this->cast<T>(this->find(key, strlen(key)));
+        }
+        // scalars are boxed by get, use getValue to read them without allocation
+        const DataValue &getValue(const Symbol &key) const;
+        const DataValue &getValue(const std::string &key) const;
+        const DataValue &getValue(const char *key) const;
+        DataType getType(const Symbol &key) const;
+        DataType getType(const std::string &key) const;
+        DataType getType(const char *key) const;
         
-        void remove(std::string key);
+        void remove(const std::string &key);
         void clear();
         unsigned int size() const;
-        std::vector<std::string> getKeys() const;
+        // keys in insertion order, or sorted
+        std::vector<std::string> getKeys(bool sorted = false) const;
         std::pair<std::string, std::shared_ptr<Data>> getKeyValue(int idx);
-        bool hasKey(std::string key);
+        bool hasKey(const Symbol &key) const;
+        bool hasKey(const std::string &key) const;
+        bool hasKey(const char *key) const;
         
         virtual void write(std::ostream &out) override;
         virtual void read(std::istream &in) override;
         
     private:
+        struct Entry {
+            Symbol key;
+            DataValue value;
+        };
+
         Dictionary();
         
-        std::map<std::string, std::shared_ptr<Data>> datum;
+        // entries in insertion order, slots is an open addressing index into it
+        std::vector<Entry> entries;
+        std::vector<int> slots;
+
+        const Entry *find(const Symbol &key) const;
+        const Entry *find(const char *key, size_t length) const;
+        void rebuildSlots(size_t capacity);
+
+        template <class T>
+        std::shared_ptr<T> cast(const Entry *entry) const {
+            if (!entry) return nullptr;
+            if (!isDataType<T>(entry->value.getType())) {
+#ifdef MOG_DEBUG
+                LOGE("Type Error : %s, %d, %s\n", entry->key.str().c_str(), (int)entry->value.getType(), typeid(T).name());
+#endif
+                return nullptr;
+            }
+            return std::static_pointer_cast<T>(entry->value.toData());
+        }
     };
 }
 
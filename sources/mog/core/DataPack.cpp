@@ -0,0 +1,525 @@
+#include "mog/core/DataPack.h"
+#include "mog/core/FileUtils.h"
+#include "mog/Constants.h"
+#include <algorithm>
+#include <unordered_map>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ little endian, offsets are from the beginning of the buffer.
+
+ header   : "MOGP" | u16 version | u16 reserved | u32 length | slot root
+ slot     : u8 type | u8[3] reserved | u32 payload
+            Int, Float, Bool are stored in the payload, other types store the offset of their node.
+ Long     : i64 (8 byte aligned)
+ Double   : f64 (8 byte aligned)
+ String   : u32 length | bytes | '\0'
+ ByteArray: u32 length | bytes
+ List     : u32 count | slot[count]
+ Dictionary: u32 count | (u32 key offset | slot)[count], sorted by key bytes
+            keys are String nodes, shared between dictionaries.
+ container nodes always come after their parent, so offsets can not form a cycle.
+ */
+
+#define DATA_PACK_VERSION 1
+#define DATA_PACK_HEADER_SIZE 20
+#define DATA_PACK_ROOT_OFFSET 12
+#define DATA_PACK_SLOT_SIZE 8
+#define DATA_PACK_ENTRY_SIZE 12
+#define DATA_PACK_MAX_DEPTH 512
+
+using namespace mog;
+
+static const unsigned char dataPackMagic[4] = {'M', 'O', 'G', 'P'};
+
+static inline unsigned int readU32(const unsigned char *p) {
+    unsigned int v;
+    memcpy(&v, p, sizeof(unsigned int));
+    return v;
+}
+
+static inline bool isInRange(unsigned int length, unsigned int offset, unsigned long long size) {
+    return (unsigned long long)offset + size <= (unsigned long long)length;
+}
+
+static inline bool isContainer(DataType type) {
+    return type == DataType::List || type == DataType::Dictionary;
+}
+
+static inline int compareKey(const char *key1, unsigned int length1, const char *key2, unsigned int length2) {
+    int c = memcmp(key1, key2, std::min(length1, length2));
+    if (c != 0) return c;
+    if (length1 == length2) return 0;
+    return (length1 < length2) ? -1 : 1;
+}
+
+
+#pragma - DataView
+
+DataView::DataView(const unsigned char *buffer, unsigned int length, unsigned int slotOffset, unsigned int parentOffset) {
+    if (!isInRange(length, slotOffset, DATA_PACK_SLOT_SIZE)) return;
+    auto type = (DataType)buffer[slotOffset];
+    if (type < DataType::Void || type > DataType::Dictionary) return;
+    unsigned int payload = readU32(buffer + slotOffset + 4);
+    if (isContainer(type) && payload <= parentOffset) return;
+
+    this->buffer = buffer;
+    this->length = length;
+    this->type = type;
+    this->payload = payload;
+}
+
+DataType DataView::getType() const {
+    return this->type;
+}
+
+bool DataView::isValid() const {
+    return this->buffer != nullptr;
+}
+
+bool DataView::isNull() const {
+    return this->type == DataType::Void;
+}
+
+int DataView::getInt() const {
+    switch (this->type) {
+        case DataType::Int:
+            return (int)this->payload;
+        case DataType::Long:
+            return (int)this->getLong();
+        case DataType::Float:
+        case DataType::Double:
+            return (int)this->getDouble();
+        default:
+            return 0;
+    }
+}
+
+long long DataView::getLong() const {
+    switch (this->type) {
+        case DataType::Int:
+            return (long long)(int)this->payload;
+        case DataType::Long: {
+            if (!isInRange(this->length, this->payload, sizeof(long long))) return 0;
+            long long v;
+            memcpy(&v, this->buffer + this->payload, sizeof(long long));
+            return v;
+        }
+        case DataType::Float:
+        case DataType::Double:
+            return (long long)this->getDouble();
+        default:
+            return 0;
+    }
+}
+
+float DataView::getFloat() const {
+    if (this->type == DataType::Float) {
+        float v;
+        memcpy(&v, &this->payload, sizeof(float));
+        return v;
+    }
+    return (float)this->getDouble();
+}
+
+double DataView::getDouble() const {
+    switch (this->type) {
+        case DataType::Int:
+        case DataType::Long:
+            return (double)this->getLong();
+        case DataType::Float:
+            return (double)this->getFloat();
+        case DataType::Double: {
+            if (!isInRange(this->length, this->payload, sizeof(double))) return 0;
+            double v;
+            memcpy(&v, this->buffer + this->payload, sizeof(double));
+            return v;
+        }
+        default:
+            return 0;
+    }
+}
+
+bool DataView::getBool() const {
+    return this->type == DataType::Bool && this->payload != 0;
+}
+
+bool DataView::getString(const char **value, unsigned int *length) const {
+    if (this->type != DataType::String) return false;
+    unsigned int len = 0;
+    if (!this->readCount(&len) || !isInRange(this->length, this->payload + 4, (unsigned long long)len + 1)) return false;
+    if (value) *value = (const char *)(this->buffer + this->payload + 4);
+    if (length) *length = len;
+    return true;
+}
+
+std::string DataView::getString() const {
+    const char *value = nullptr;
+    unsigned int length = 0;
+    if (!this->getString(&value, &length)) return "";
+    return std::string(value, length);
+}
+
+bool DataView::getBytes(const unsigned char **value, unsigned int *length) const {
+    if (this->type != DataType::ByteArray) return false;
+    unsigned int len = 0;
+    if (!this->readCount(&len) || !isInRange(this->length, this->payload + 4, len)) return false;
+    if (value) *value = this->buffer + this->payload + 4;
+    if (length) *length = len;
+    return true;
+}
+
+bool DataView::readCount(unsigned int *count) const {
+    if (!isInRange(this->length, this->payload, 4)) return false;
+    *count = readU32(this->buffer + this->payload);
+    return true;
+}
+
+unsigned int DataView::size() const {
+    unsigned int count = 0;
+    switch (this->type) {
+        case DataType::List:
+            if (!this->readCount(&count)) return 0;
+            return isInRange(this->length, this->payload + 4, (unsigned long long)count * DATA_PACK_SLOT_SIZE) ? count : 0;
+        case DataType::Dictionary:
+            if (!this->readCount(&count)) return 0;
+            return isInRange(this->length, this->payload + 4, (unsigned long long)count * DATA_PACK_ENTRY_SIZE) ? count : 0;
+        case DataType::String:
+        case DataType::ByteArray:
+            return this->readCount(&count) ? count : 0;
+        default:
+            return 0;
+    }
+}
+
+DataView DataView::at(unsigned int idx) const {
+    if (this->type != DataType::List || idx >= this->size()) return DataView();
+    return DataView(this->buffer, this->length, this->payload + 4 + idx * DATA_PACK_SLOT_SIZE, this->payload);
+}
+
+DataView DataView::get(const char *key, unsigned int length) const {
+    if (this->type != DataType::Dictionary) return DataView();
+    unsigned int lo = 0;
+    unsigned int hi = this->size();
+    while (lo < hi) {
+        unsigned int mid = lo + (hi - lo) / 2;
+        const char *k = nullptr;
+        unsigned int kLength = 0;
+        if (!this->getKeyAt(mid, &k, &kLength)) return DataView();
+        int c = compareKey(k, kLength, key, length);
+        if (c == 0) {
+            return this->valueAt(mid);
+        } else if (c < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return DataView();
+}
+
+DataView DataView::get(const std::string &key) const {
+    return this->get(key.c_str(), (unsigned int)key.length());
+}
+
+bool DataView::hasKey(const std::string &key) const {
+    return this->get(key).isValid();
+}
+
+bool DataView::getKeyAt(unsigned int idx, const char **key, unsigned int *length) const {
+    if (this->type != DataType::Dictionary || idx >= this->size()) return false;
+    unsigned int keyOffset = readU32(this->buffer + this->payload + 4 + idx * DATA_PACK_ENTRY_SIZE);
+    if (!isInRange(this->length, keyOffset, 4)) return false;
+    unsigned int len = readU32(this->buffer + keyOffset);
+    if (!isInRange(this->length, keyOffset + 4, (unsigned long long)len + 1)) return false;
+    if (key) *key = (const char *)(this->buffer + keyOffset + 4);
+    if (length) *length = len;
+    return true;
+}
+
+DataView DataView::valueAt(unsigned int idx) const {
+    if (this->type != DataType::Dictionary || idx >= this->size()) return DataView();
+    return DataView(this->buffer, this->length, this->payload + 4 + idx * DATA_PACK_ENTRY_SIZE + 4, this->payload);
+}
+
+std::shared_ptr<Data> DataView::toData() const {
+    return this->toData(0);
+}
+
+std::shared_ptr<Data> DataView::toData(int depth) const {
+    if (!this->isValid()) return nullptr;
+
+    switch (this->type) {
+        case DataType::Int:
+            return Int::create(this->getInt());
+        case DataType::Long:
+            return Long::create(this->getLong());
+        case DataType::Float:
+            return Float::create(this->getFloat());
+        case DataType::Double:
+            return Double::create(this->getDouble());
+        case DataType::Bool:
+            return Bool::create(this->getBool());
+        case DataType::String:
+            return String::create(this->getString());
+        case DataType::ByteArray: {
+            const unsigned char *value = nullptr;
+            unsigned int length = 0;
+            if (!this->getBytes(&value, &length)) return nullptr;
+            return ByteArray::create((unsigned char *)value, length, true);
+        }
+        case DataType::List: {
+            if (depth >= DATA_PACK_MAX_DEPTH) return nullptr;
+            auto list = List::create();
+            unsigned int count = this->size();
+            for (unsigned int i = 0; i < count; i++) {
+                list->append(this->at(i).toData(depth + 1));
+            }
+            return list;
+        }
+        case DataType::Dictionary: {
+            if (depth >= DATA_PACK_MAX_DEPTH) return nullptr;
+            auto dict = Dictionary::create();
+            unsigned int count = this->size();
+            for (unsigned int i = 0; i < count; i++) {
+                const char *key = nullptr;
+                unsigned int keyLength = 0;
+                if (!this->getKeyAt(i, &key, &keyLength)) continue;
+                dict->put(std::string(key, keyLength), this->valueAt(i).toData(depth + 1));
+            }
+            return dict;
+        }
+        default: {
+            auto null = Null::create();
+            null->type = DataType::Void;
+            return null;
+        }
+    }
+}
+
+
+#pragma - DataPackWriter
+
+namespace mog {
+    class DataPackWriter {
+    public:
+        std::vector<unsigned char> buffer;
+        std::unordered_map<std::string, unsigned int> keyOffsets;
+
+        void writeHeader(const std::shared_ptr<Data> &data) {
+            this->buffer.resize(DATA_PACK_HEADER_SIZE, 0);
+            memcpy(this->buffer.data(), dataPackMagic, 4);
+            unsigned short version = DATA_PACK_VERSION;
+            memcpy(this->buffer.data() + 4, &version, sizeof(unsigned short));
+            this->writeValue(DataValue(data), DATA_PACK_ROOT_OFFSET);
+            unsigned int length = (unsigned int)this->buffer.size();
+            memcpy(this->buffer.data() + 8, &length, sizeof(unsigned int));
+        }
+
+    private:
+        unsigned int reserve(size_t size, size_t align) {
+            size_t offset = (this->buffer.size() + align - 1) & ~(align - 1);
+            this->buffer.resize(offset + size, 0);
+            return (unsigned int)offset;
+        }
+
+        unsigned int appendBytes(const void *value, unsigned int length, bool terminate) {
+            unsigned int offset = this->reserve(4 + length + (terminate ? 1 : 0), 4);
+            memcpy(this->buffer.data() + offset, &length, sizeof(unsigned int));
+            if (length > 0) memcpy(this->buffer.data() + offset + 4, value, length);
+            return offset;
+        }
+
+        unsigned int appendKey(const std::string &key) {
+            auto it = this->keyOffsets.find(key);
+            if (it != this->keyOffsets.end()) return it->second;
+            unsigned int offset = this->appendBytes(key.c_str(), (unsigned int)key.length(), true);
+            this->keyOffsets[key] = offset;
+            return offset;
+        }
+
+        void setSlot(unsigned int slotOffset, DataType type, unsigned int payload) {
+            this->buffer[slotOffset] = (unsigned char)type;
+            memcpy(this->buffer.data() + slotOffset + 4, &payload, sizeof(unsigned int));
+        }
+
+        void writeValue(const DataValue &value, unsigned int slotOffset) {
+            DataType type = value.getType();
+            const std::shared_ptr<Data> &data = value.value.data;
+            unsigned int payload = 0;
+
+            switch (type) {
+                case DataType::Int: {
+                    int v = value.getInt();
+                    memcpy(&payload, &v, sizeof(int));
+                    break;
+                }
+                case DataType::Float: {
+                    float v = value.getFloat();
+                    memcpy(&payload, &v, sizeof(float));
+                    break;
+                }
+                case DataType::Bool:
+                    payload = value.getBool() ? 1 : 0;
+                    break;
+                case DataType::Long: {
+                    long long v = value.getLong();
+                    payload = this->reserve(sizeof(long long), 8);
+                    memcpy(this->buffer.data() + payload, &v, sizeof(long long));
+                    break;
+                }
+                case DataType::Double: {
+                    double v = value.getDouble();
+                    payload = this->reserve(sizeof(double), 8);
+                    memcpy(this->buffer.data() + payload, &v, sizeof(double));
+                    break;
+                }
+                case DataType::String: {
+                    if (value.isBoxed()) {
+                        std::string v = value.getString();
+                        payload = this->appendBytes(v.c_str(), (unsigned int)v.length(), true);
+                    } else {
+                        payload = this->appendBytes(value.value.str, value.length, true);
+                    }
+                    break;
+                }
+                case DataType::ByteArray: {
+                    unsigned char *value = nullptr;
+                    unsigned int length = 0;
+                    std::static_pointer_cast<ByteArray>(data)->getValue(&value, &length);
+                    payload = this->appendBytes(value, length, false);
+                    break;
+                }
+                case DataType::List: {
+                    auto list = std::static_pointer_cast<List>(data);
+                    unsigned int count = (unsigned int)list->datum.size();
+                    payload = this->reserve(4 + count * DATA_PACK_SLOT_SIZE, 4);
+                    memcpy(this->buffer.data() + payload, &count, sizeof(unsigned int));
+                    for (unsigned int i = 0; i < count; i++) {
+                        this->writeValue(list->datum[i], payload + 4 + i * DATA_PACK_SLOT_SIZE);
+                    }
+                    break;
+                }
+                case DataType::Dictionary: {
+                    auto dict = std::static_pointer_cast<Dictionary>(data);
+                    std::vector<std::pair<const std::string *, const DataValue *>> entries;
+                    entries.reserve(dict->entries.size());
+                    for (const auto &entry : dict->entries) {
+                        entries.emplace_back(&entry.key.str(), &entry.value);
+                    }
+                    std::sort(entries.begin(), entries.end(), [](const std::pair<const std::string *, const DataValue *> &e1,
+                                                                 const std::pair<const std::string *, const DataValue *> &e2) {
+                        return compareKey(e1.first->c_str(), (unsigned int)e1.first->length(), e2.first->c_str(), (unsigned int)e2.first->length()) < 0;
+                    });
+
+                    unsigned int count = (unsigned int)entries.size();
+                    payload = this->reserve(4 + count * DATA_PACK_ENTRY_SIZE, 4);
+                    memcpy(this->buffer.data() + payload, &count, sizeof(unsigned int));
+                    for (unsigned int i = 0; i < count; i++) {
+                        unsigned int entryOffset = payload + 4 + i * DATA_PACK_ENTRY_SIZE;
+                        unsigned int keyOffset = this->appendKey(*entries[i].first);
+                        memcpy(this->buffer.data() + entryOffset, &keyOffset, sizeof(unsigned int));
+                        this->writeValue(*entries[i].second, entryOffset + 4);
+                    }
+                    break;
+                }
+                default:
+                    type = DataType::Void;
+                    break;
+            }
+
+            this->setSlot(slotOffset, type, payload);
+        }
+    };
+}
+
+
+#pragma - DataPack
+
+std::shared_ptr<DataPack> DataPack::create(const std::shared_ptr<ByteArray> &bytes) {
+    if (!bytes) return nullptr;
+    auto pack = std::shared_ptr<DataPack>(new DataPack());
+    unsigned char *value = nullptr;
+    unsigned int length = 0;
+    bytes->getValue(&value, &length);
+    if (!pack->initWithBuffer(value, length)) return nullptr;
+    pack->bytes = bytes;
+    return pack;
+}
+
+std::shared_ptr<DataPack> DataPack::createWithFile(std::string filepath) {
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOGE("file open failed: %s", filepath.c_str());
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || (unsigned long long)st.st_size > 0xffffffffULL) {
+        close(fd);
+        LOGE("invalid data pack file: %s", filepath.c_str());
+        return nullptr;
+    }
+    size_t size = (size_t)st.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        auto bytes = FileUtils::readBytesFromFile(filepath);
+        return DataPack::create(bytes);
+    }
+
+    auto bytes = ByteArray::createWithDeleter((unsigned char *)mapped, (unsigned int)size, [size](unsigned char *value) {
+        munmap(value, size);
+    });
+    return DataPack::create(bytes);
+}
+
+std::shared_ptr<ByteArray> DataPack::pack(const std::shared_ptr<Data> &data) {
+    DataPackWriter writer;
+    writer.writeHeader(data);
+    if (writer.buffer.size() > 0xffffffffULL) {
+        LOGE("data pack is too large");
+        return nullptr;
+    }
+    auto buffer = std::make_shared<std::vector<unsigned char>>();
+    buffer->swap(writer.buffer);
+    return ByteArray::createWithOwner(buffer, buffer->data(), (unsigned int)buffer->size());
+}
+
+bool DataPack::writeFile(std::string filepath, const std::shared_ptr<Data> &data) {
+    auto bytes = DataPack::pack(data);
+    if (!bytes) return false;
+    return FileUtils::writeBytesToFile(filepath, bytes);
+}
+
+bool DataPack::initWithBuffer(const unsigned char *buffer, unsigned int length) {
+    if (buffer == nullptr || length < DATA_PACK_HEADER_SIZE || memcmp(buffer, dataPackMagic, 4) != 0) {
+        LOGE("invalid data pack");
+        return false;
+    }
+    unsigned short version;
+    memcpy(&version, buffer + 4, sizeof(unsigned short));
+    if (version != DATA_PACK_VERSION) {
+        LOGE("unsupported data pack version: %d", version);
+        return false;
+    }
+    unsigned int packLength = readU32(buffer + 8);
+    if (packLength < DATA_PACK_HEADER_SIZE || packLength > length) {
+        LOGE("invalid data pack length");
+        return false;
+    }
+    this->buffer = buffer;
+    this->length = packLength;
+    return true;
+}
+
+DataView DataPack::getRoot() const {
+    return DataView(this->buffer, this->length, DATA_PACK_ROOT_OFFSET, 0);
+}
+
+unsigned int DataPack::getLength() const {
+    return this->length;
+}
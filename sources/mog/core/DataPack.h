@@ -0,0 +1,79 @@
+#ifndef DataPack_h
+#define DataPack_h
+
+#include <memory>
+#include <string>
+#include "mog/core/Data.h"
+
+namespace mog {
+    class DataPack;
+
+    // lightweight reference into a DataPack buffer. no allocation, valid while the pack is alive.
+    // lookups on a missing key or a wrong type return a Void view.
+    class DataView {
+        friend class DataPack;
+    public:
+        DataView() {}
+
+        DataType getType() const;
+        bool isValid() const;
+        bool isNull() const;
+
+        // numeric getters convert between Int, Long, Float and Double
+        int getInt() const;
+        long long getLong() const;
+        float getFloat() const;
+        double getDouble() const;
+        bool getBool() const;
+        // string is null terminated
+        bool getString(const char **value, unsigned int *length) const;
+        std::string getString() const;
+        bool getBytes(const unsigned char **value, unsigned int *length) const;
+
+        // element count of List / Dictionary, byte length of String / ByteArray
+        unsigned int size() const;
+        DataView at(unsigned int idx) const;
+        DataView get(const char *key, unsigned int length) const;
+        DataView get(const std::string &key) const;
+        bool hasKey(const std::string &key) const;
+        // Dictionary entries are sorted by key
+        bool getKeyAt(unsigned int idx, const char **key, unsigned int *length) const;
+        DataView valueAt(unsigned int idx) const;
+
+        std::shared_ptr<Data> toData() const;
+
+    private:
+        DataView(const unsigned char *buffer, unsigned int length, unsigned int slotOffset, unsigned int parentOffset);
+
+        const unsigned char *buffer = nullptr;
+        unsigned int length = 0;
+        DataType type = DataType::Void;
+        unsigned int payload = 0;
+
+        bool readCount(unsigned int *count) const;
+        std::shared_ptr<Data> toData(int depth) const;
+    };
+
+    class DataPack {
+    public:
+        static std::shared_ptr<DataPack> create(const std::shared_ptr<ByteArray> &bytes);
+        // maps the file read-only where possible, otherwise reads it into one buffer
+        static std::shared_ptr<DataPack> createWithFile(std::string filepath);
+        static std::shared_ptr<ByteArray> pack(const std::shared_ptr<Data> &data);
+        static bool writeFile(std::string filepath, const std::shared_ptr<Data> &data);
+
+        DataView getRoot() const;
+        unsigned int getLength() const;
+
+    private:
+        DataPack() {}
+
+        const unsigned char *buffer = nullptr;
+        unsigned int length = 0;
+        std::shared_ptr<ByteArray> bytes;
+
+        bool initWithBuffer(const unsigned char *buffer, unsigned int length);
+    };
+}
+
+#endif /* DataPack_h */
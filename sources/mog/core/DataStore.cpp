@@ -1,31 +1,199 @@
 #include "mog/core/DataStore.h"
+#include "mog/core/Json.h"
+#include "mog/core/Compression.h"
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <thread>
+#include <chrono>
+
+// values set within the delay are coalesced into one journal write
+#define DATA_STORE_WRITE_DELAY 0.5f
+#define DATA_STORE_COMPACT_SIZE (512 * 1024)
+#define DATA_STORE_COMPACT_INTERVAL 10.0f
+#define DATA_STORE_COMPRESSION_MIN_SIZE 64
+#define DATA_STORE_RECORD_PUT 1
+#define DATA_STORE_RECORD_REMOVE 2
+
+#ifdef MOG_EMSCRIPTEN
+// no worker threads, the journal is written on flush
+#define DATA_STORE_SYNC_WRITE
+#endif
 
 using namespace mog;
 
+static std::vector<unsigned int> createCrc32Table() {
+    std::vector<unsigned int> table(256);
+    for (unsigned int i = 0; i < 256; i++) {
+        unsigned int c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (0xedb88320 ^ (c >> 1)) : (c >> 1);
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+static unsigned int crc32(const unsigned char *data, size_t length) {
+    static const std::vector<unsigned int> table = createCrc32Table();
+    unsigned int crc = 0xffffffff;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc ^ 0xffffffff;
+}
+
+static bool writeAll(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        length -= n;
+    }
+    return true;
+}
+
+static bool writeFileSync(std::string filepath, const std::string &bytes) {
+    std::string tmp = filepath + ".tmp";
+    int fd = open(tmp.c_str(), O_WRONLY|O_CREAT|O_TRUNC, S_IRUSR|S_IWUSR);
+    if (fd < 0) return false;
+    bool ret = writeAll(fd, bytes.data(), bytes.size()) && fsync(fd) == 0;
+    close(fd);
+    if (!ret || std::rename(tmp.c_str(), filepath.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+static void syncDirectory(std::string dir) {
+    int fd = open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+static void appendU32(std::string &buf, unsigned int value) {
+    buf.append((const char *)&value, sizeof(unsigned int));
+}
+
+static unsigned int readU32(const char *p) {
+    unsigned int value;
+    memcpy(&value, p, sizeof(unsigned int));
+    return value;
+}
+
+static size_t cacheShard(const std::string &key) {
+    return std::hash<std::string>()(key) % DATA_STORE_CACHE_SHARD_NUM;
+}
+
+static void writeData(std::ostream &out, const std::shared_ptr<Data> &data, bool compress) {
+    if (!compress) {
+        data->write(out);
+        return;
+    }
+    CompressStreamBuffer compressor(out);
+    std::ostream cout(&compressor);
+    cout.exceptions(std::ios::failbit|std::ios::badbit);
+    data->write(cout);
+    if (!compressor.finish()) {
+        throw std::ios_base::failure("failed to compress.");
+    }
+}
+
+static std::string writeBytes(const std::shared_ptr<Data> &data) {
+    std::ostringstream sout(std::ios::binary);
+    sout.exceptions(std::ios::failbit|std::ios::badbit);
+    data->write(sout);
+    return sout.str();
+}
+
+// values smaller than DATA_STORE_COMPRESSION_MIN_SIZE are kept raw, the frame overhead outweighs the gain
+static std::string compressBytes(const std::string &raw) {
+    if (raw.length() < DATA_STORE_COMPRESSION_MIN_SIZE) {
+        return raw;
+    }
+    std::ostringstream cout(std::ios::binary);
+    cout.exceptions(std::ios::failbit|std::ios::badbit);
+    CompressStreamBuffer compressor(cout, (long long)raw.length());
+    if (compressor.sputn(raw.data(), (std::streamsize)raw.length()) != (std::streamsize)raw.length() || !compressor.finish()) {
+        throw std::ios_base::failure("failed to compress.");
+    }
+    return cout.str();
+}
+
+// peeks the frame header and rewinds, non seekable streams are never treated as compressed
+static bool isCompressedStream(std::istream &in) {
+    std::streambuf *buf = in.rdbuf();
+    std::streampos start = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    if (start == std::streampos(-1)) return false;
+    char header[19];
+    std::streamsize n = buf->sgetn(header, sizeof(header));
+    buf->pubseekpos(start, std::ios::in);
+    return n > 0 && Compression::isCompressed(header, (size_t)n);
+}
+
+
 #pragma - DataStore
 
-std::unordered_map<std::string, std::shared_ptr<Data>> DataStore::caches;
-std::unordered_map<std::string, bool> DataStore::unsaved;
+std::shared_ptr<const DataStore::CacheMap> DataStore::caches[DATA_STORE_CACHE_SHARD_NUM];
+unsigned long long DataStore::cacheGeneration = 0;
+DataStore::RecordMap DataStore::unsaved;
+DataStore::RecordMap DataStore::journaled;
 std::mutex DataStore::mtx;
+std::mutex DataStore::loadMtx;
+std::condition_variable DataStore::cond;
+bool DataStore::opened = false;
+bool DataStore::writerStarted = false;
+bool DataStore::writerStopping = false;
+bool DataStore::writing = false;
+bool DataStore::flushRequested = false;
+unsigned long long DataStore::setCount = 0;
+unsigned long long DataStore::writtenCount = 0;
+unsigned long long DataStore::failedCount = 0;
+int DataStore::journalFd = -1;
+unsigned long long DataStore::journalSize = 0;
+std::atomic<bool> DataStore::compressionEnabled(DATA_STORE_COMPRESSION_ENABLE != 0);
 
 void DataStore::setData(std::string key, const std::shared_ptr<Data> &value, bool immediatelySave) {
-    std::lock_guard<std::mutex> lock(mtx);
+    Record record;
+    record.data = value;
+    if (value) {
+        try {
+            record.bytes = std::make_shared<std::string>(writeBytes(value));
+        } catch (std::ios_base::failure &e) {
+            LOGE("DataStore: failed to serialize. key=%s", key.c_str());
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mtx);
+    _open();
     
-    DataStore::caches[key] = value;
+    _putCache(key, value);
+    if (value && !record.bytes) return;
+    unsigned long long seq = _set(key, record);
     if (immediatelySave) {
-        _save(key);
-    } else {
-        DataStore::unsaved[key] = true;
+        _flush(lock, -1, seq);
     }
 }
 
+unsigned long long DataStore::_set(std::string key, Record record) {
+    record.seq = ++DataStore::setCount;
+    DataStore::unsaved[key] = record;
+    _startWriter();
+    return record.seq;
+}
+
 void DataStore::serialize(std::string filepath, const std::shared_ptr<Data> &data) {
     std::string tmp = filepath + ".tmp";
     std::ofstream fout;
     fout.exceptions(std::ios::failbit|std::ios::badbit);
     fout.open(tmp, std::ios::out|std::ios::binary);
-    data->write(fout);
+    writeData(fout, data, DataStore::compressionEnabled);
     fout.flush();
     fout.close();
     const char *filec = filepath.c_str();
@@ -39,33 +207,84 @@ void DataStore::serialize(std::string filepath, const std::shared_ptr<Data> &dat
 }
 
 std::shared_ptr<ByteArray> DataStore::serialize(const std::shared_ptr<Data> &data) {
-    std::ostringstream sout(std::ios::binary);
+    ByteArrayBuilder builder;
+    std::ostream sout(&builder);
     sout.exceptions(std::ios::failbit|std::ios::badbit);
-    data->write(sout);
-    unsigned char *byteData = (unsigned char *)malloc(sout.str().size());
-    memcpy(byteData, sout.str().data(), sout.str().size());
-    return ByteArray::create(byteData, (unsigned int)sout.str().size());
+    writeData(sout, data, DataStore::compressionEnabled);
+    return builder.toByteArray();
 }
 
-void DataStore::_serialize(std::string key, const std::shared_ptr<Data> &data) {
-    std::string dirStr = getStoreDirectory();
-    const char *dir = dirStr.c_str();
-    struct stat st;
-    if (stat(dir, &st) == -1) {
-        mkdir(dir, S_IRWXU|S_IRWXG);
+void DataStore::setCompressionEnabled(bool enabled) {
+    DataStore::compressionEnabled = enabled;
+}
+
+bool DataStore::isCompressionEnabled() {
+    return DataStore::compressionEnabled;
+}
+
+std::shared_ptr<Data> DataStore::_read(std::istream &in) {
+    if (isCompressedStream(in)) {
+        DecompressStreamBuffer decompressor(in);
+        std::istream din(&decompressor);
+        din.exceptions(std::ios::failbit|std::ios::badbit);
+        return _read(din);
     }
-    std::string file = getStoreFilePath(key);
-    serialize(file, data);
+    std::shared_ptr<Data> data = nullptr;
+    DataType type = (DataType)in.peek();
+    switch (type) {
+        case DataType::Int:
+            data = std::shared_ptr<Int>(new Int());
+            break;
+        case DataType::Long:
+            data = std::shared_ptr<Long>(new Long());
+            break;
+        case DataType::Float:
+            data = std::shared_ptr<Float>(new Float());
+            break;
+        case DataType::Double:
+            data = std::shared_ptr<Double>(new Double());
+            break;
+        case DataType::Bool:
+            data = std::shared_ptr<Bool>(new Bool());
+            break;
+        case DataType::String:
+            data = std::shared_ptr<String>(new String());
+            break;
+        case DataType::ByteArray:
+            data = std::shared_ptr<ByteArray>(new ByteArray());
+            break;
+        case DataType::List:
+            data = std::shared_ptr<List>(new List());
+            break;
+        case DataType::Dictionary:
+            data = std::shared_ptr<Dictionary>(new Dictionary());
+            break;
+        default:
+            return nullptr;
+    }
+    data->read(in);
+    return data;
 }
 
-bool DataStore::hasKey(std::string key) {
-    std::lock_guard<std::mutex> lock(mtx);
-    return _hasKey(key);
+void DataStore::_read(std::istream &in, const std::shared_ptr<Data> &data) {
+    if (isCompressedStream(in)) {
+        DecompressStreamBuffer decompressor(in);
+        std::istream din(&decompressor);
+        din.exceptions(std::ios::failbit|std::ios::badbit);
+        data->read(din);
+        return;
+    }
+    data->read(in);
 }
 
-bool DataStore::_hasKey(std::string key) {
-    if (DataStore::caches.count(key) > 0) return true;
-    
+bool DataStore::hasKey(std::string key) {
+    std::shared_ptr<Data> data = nullptr;
+    if (_findCache(key, &data)) return data != nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        _open();
+        if (_findCache(key, &data)) return data != nullptr;
+    }
     std::string file = getStoreFilePath(key);
     struct stat st;
     return (stat(file.c_str(), &st) == 0);
@@ -73,20 +292,32 @@ bool DataStore::_hasKey(std::string key) {
 
 void DataStore::remove(std::string key) {
     std::lock_guard<std::mutex> lock(mtx);
-    _remove(key);
-}
-
-void DataStore::_remove(std::string key) {
-    std::string file = getStoreFilePath(key);
-    std::remove(file.c_str());
+    _open();
+    _putCache(key, nullptr);
+    _set(key, Record());
 }
 
 void DataStore::removeAll() {
-    std::lock_guard<std::mutex> lock(mtx);
+    std::unique_lock<std::mutex> lock(mtx);
+    _open();
+    // a failed write puts its values back to unsaved, so the writer is waited for before clearing
+    cond.wait(lock, [] { return !DataStore::writing; });
+    DataStore::unsaved.clear();
+    DataStore::writtenCount = DataStore::setCount;
+    cond.notify_all();
     _removeAll();
 }
 
 void DataStore::_removeAll() {
+    if (DataStore::journalFd >= 0) {
+        close(DataStore::journalFd);
+        DataStore::journalFd = -1;
+    }
+    DataStore::journalSize = 0;
+    DataStore::journaled.clear();
+    DataStore::opened = false;
+    _clearCache();
+
     DIR* dp = opendir(getStoreDirectory().c_str());
     if (dp == NULL) return;
     
@@ -97,39 +328,384 @@ void DataStore::_removeAll() {
             std::remove(file.c_str());
         }
     }
+    closedir(dp);
     std::remove(getStoreDirectory().c_str());
-    DataStore::caches.clear();
 }
 
 void DataStore::save() {
+    flush();
+}
+
+void DataStore::save(std::string key) {
+    std::unique_lock<std::mutex> lock(mtx);
+    _open();
+    // a value being written has already moved from unsaved to journaled
+    unsigned long long target = 0;
+    auto it = DataStore::unsaved.find(key);
+    if (it != DataStore::unsaved.end()) {
+        target = it->second.seq;
+    } else {
+        auto jt = DataStore::journaled.find(key);
+        if (jt != DataStore::journaled.end()) target = jt->second.seq;
+    }
+    _flush(lock, -1, target);
+}
+
+bool DataStore::flush(float timeout) {
+    std::unique_lock<std::mutex> lock(mtx);
+    _open();
+    return _flush(lock, timeout, DataStore::setCount);
+}
+
+bool DataStore::_flush(std::unique_lock<std::mutex> &lock, float timeout, unsigned long long target) {
+    if (DataStore::writtenCount >= target) return true;
+#ifdef DATA_STORE_SYNC_WRITE
+    _writeJournal(lock);
+    if (DataStore::journalSize > DATA_STORE_COMPACT_SIZE) {
+        _compact(lock);
+    }
+    return DataStore::writtenCount >= target;
+#else
+    unsigned long long failed = DataStore::failedCount;
+    DataStore::flushRequested = true;
+    cond.notify_all();
+    // a failed write ends the wait, the values stay queued and are retried by the writer
+    auto done = [target, failed] { return DataStore::writtenCount >= target || DataStore::failedCount != failed; };
+    if (timeout < 0) {
+        cond.wait(lock, done);
+    } else {
+        cond.wait_for(lock, std::chrono::duration<float>(timeout), done);
+    }
+    return DataStore::writtenCount >= target;
+#endif
+}
+
+void DataStore::clearCache() {
     std::lock_guard<std::mutex> lock(mtx);
-    _save();
+    _clearCache();
 }
 
-void DataStore::_save() {
+
+#pragma - Cache
+
+bool DataStore::_findCache(const std::string &key, std::shared_ptr<Data> *data) {
+    auto shard = std::atomic_load(&DataStore::caches[cacheShard(key)]);
+    if (!shard) return false;
+    auto it = shard->find(key);
+    if (it == shard->end()) return false;
+    *data = it->second;
+    return true;
+}
+
+// copies one shard, readers keep using the snapshot they loaded
+void DataStore::_putCache(const std::string &key, const std::shared_ptr<Data> &data) {
+    auto &shard = DataStore::caches[cacheShard(key)];
+    auto current = std::atomic_load(&shard);
+    auto next = current ? std::make_shared<CacheMap>(*current) : std::make_shared<CacheMap>();
+    (*next)[key] = data;
+    std::atomic_store(&shard, std::shared_ptr<const CacheMap>(next));
+}
+
+// values not yet in the store files stay cached
+void DataStore::_clearCache() {
+    DataStore::cacheGeneration++;
+    std::shared_ptr<CacheMap> shards[DATA_STORE_CACHE_SHARD_NUM];
+    for (int i = 0; i < DATA_STORE_CACHE_SHARD_NUM; i++) {
+        shards[i] = std::make_shared<CacheMap>();
+    }
+    for (auto &kv : DataStore::journaled) {
+        (*shards[cacheShard(kv.first)])[kv.first] = kv.second.data;
+    }
     for (auto &kv : DataStore::unsaved) {
-        if (kv.second) {
-            auto data = DataStore::caches[kv.first];
-            DataStore::_serialize(kv.first, data);
-        }
+        (*shards[cacheShard(kv.first)])[kv.first] = kv.second.data;
+    }
+    for (int i = 0; i < DATA_STORE_CACHE_SHARD_NUM; i++) {
+        std::atomic_store(&DataStore::caches[i], std::shared_ptr<const CacheMap>(shards[i]));
     }
-    DataStore::unsaved.clear();
 }
 
-void DataStore::save(std::string key) {
+// file reads are serialized by loadMtx and done outside of mtx, so they do not block writes
+std::shared_ptr<Data> DataStore::_load(const std::string &key) {
+    std::lock_guard<std::mutex> loadLock(loadMtx);
+    std::shared_ptr<Data> data = nullptr;
+    unsigned long long generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        _open();
+        if (_findCache(key, &data)) return data;
+        generation = DataStore::cacheGeneration;
+    }
+
+    std::string file = getStoreFilePath(key);
+    struct stat st;
+    if (stat(file.c_str(), &st) == 0) {
+        std::ifstream fin;
+        fin.exceptions(std::ios::failbit|std::ios::badbit);
+        fin.open(file, std::ios::in|std::ios::binary);
+        data = _read(fin);
+        fin.close();
+    }
+
     std::lock_guard<std::mutex> lock(mtx);
-    _save(key);
+    std::shared_ptr<Data> current = nullptr;
+    if (_findCache(key, &current)) return current;
+    if (generation == DataStore::cacheGeneration) {
+        _putCache(key, data);
+    }
+    return data;
 }
 
-void DataStore::_save(std::string key) {
-    auto data = DataStore::caches[key];
-    if (data) {
-        DataStore::_serialize(key, data);
-        DataStore::unsaved.erase(key);
+#pragma - Journal
+
+/*
+ journal record: u32 body length | u32 crc32 of body | body
+ body: u8 op | u32 key length | key | serialized value (put only)
+ a truncated or corrupted record ends the journal.
+ */
+
+void DataStore::_open() {
+    if (DataStore::opened) return;
+    DataStore::opened = true;
+
+    std::string dir = getStoreDirectory();
+    struct stat st;
+    if (stat(dir.c_str(), &st) == -1) {
+        mkdir(dir.c_str(), S_IRWXU|S_IRWXG);
+    }
+    std::string file = getJournalFilePath();
+    DataStore::journalFd = open(file.c_str(), O_RDWR|O_CREAT, S_IRUSR|S_IWUSR);
+    if (DataStore::journalFd < 0) {
+        LOGE("DataStore: failed to open journal. %s", file.c_str());
+        return;
+    }
+
+    std::string buf;
+    char chunk[16 * 1024];
+    while (true) {
+        ssize_t n = read(DataStore::journalFd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        buf.append(chunk, n);
+    }
+
+    size_t offset = 0;
+    while (offset + 8 <= buf.size()) {
+        unsigned int length = readU32(buf.data() + offset);
+        unsigned int crc = readU32(buf.data() + offset + 4);
+        if (length < 5 || offset + 8 + length > buf.size()) break;
+        const char *body = buf.data() + offset + 8;
+        if (crc32((const unsigned char *)body, length) != crc) break;
+        unsigned char op = (unsigned char)body[0];
+        unsigned int keyLength = readU32(body + 1);
+        if (5 + (unsigned long long)keyLength > length) break;
+        offset += 8 + length;
+
+        std::string key(body + 5, keyLength);
+        if (op == DATA_STORE_RECORD_REMOVE) {
+            DataStore::journaled[key] = Record();
+        } else if (op == DATA_STORE_RECORD_PUT) {
+            auto bytes = std::make_shared<std::string>(body + 5 + keyLength, length - 5 - keyLength);
+            std::istringstream sin(*bytes, std::ios::binary);
+            sin.exceptions(std::ios::failbit|std::ios::badbit);
+            try {
+                Record record;
+                record.data = _read(sin);
+                record.bytes = bytes;
+                if (record.data) DataStore::journaled[key] = record;
+            } catch (std::ios_base::failure &e) {
+                LOGW("DataStore: skipped unreadable journal record. key=%s", key.c_str());
+            }
+        }
+    }
+
+    if (offset < buf.size()) {
+        LOGW("DataStore: journal recovered up to %zu of %zu bytes", offset, buf.size());
+        if (ftruncate(DataStore::journalFd, offset) != 0) {
+            LOGE("DataStore: failed to truncate journal.");
+        }
+        fsync(DataStore::journalFd);
+    }
+    lseek(DataStore::journalFd, offset, SEEK_SET);
+    DataStore::journalSize = offset;
+
+    _clearCache();
+    if (DataStore::journaled.size() > 0) {
+        _startWriter();
     }
 }
 
-void DataStore::clearCache() {
-    DataStore::caches.clear();
+void DataStore::_startWriter() {
+#ifndef DATA_STORE_SYNC_WRITE
+    if (DataStore::writerStarted) return;
+    DataStore::writerStarted = true;
+    std::thread(&DataStore::runWriter).detach();
+    // registered after the static members are constructed, so it runs before they are destroyed
+    std::atexit(&DataStore::stopWriter);
+#endif
 }
 
+void DataStore::stopWriter() {
+    std::unique_lock<std::mutex> lock(mtx);
+    DataStore::writerStopping = true;
+    cond.notify_all();
+    cond.wait(lock, [] { return !DataStore::writerStarted; });
+}
+
+void DataStore::runWriter() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        if (DataStore::writerStopping) {
+            _writeJournal(lock);
+            DataStore::writerStarted = false;
+            cond.notify_all();
+            return;
+        }
+        if (DataStore::unsaved.empty()) {
+            if (DataStore::journalSize == 0 && DataStore::journaled.empty()) {
+                cond.wait(lock);
+                continue;
+            }
+            // compact the journal once writes have settled
+            bool timeout = !cond.wait_for(lock, std::chrono::duration<float>(DATA_STORE_COMPACT_INTERVAL), [] {
+                return !DataStore::unsaved.empty() || DataStore::writerStopping;
+            });
+            if (timeout) {
+                _compact(lock);
+            }
+            continue;
+        }
+
+        cond.wait_for(lock, std::chrono::duration<float>(DATA_STORE_WRITE_DELAY), [] {
+            return DataStore::flushRequested || DataStore::writerStopping;
+        });
+        _writeJournal(lock);
+        if (DataStore::journalSize > DATA_STORE_COMPACT_SIZE) {
+            _compact(lock);
+        }
+    }
+}
+
+void DataStore::_writeJournal(std::unique_lock<std::mutex> &lock) {
+    DataStore::flushRequested = false;
+    if (DataStore::unsaved.empty()) {
+        DataStore::writtenCount = DataStore::setCount;
+        cond.notify_all();
+        return;
+    }
+    if (DataStore::journalFd < 0) {
+        // the journal is reopened on each pass, the values stay queued until it can be written
+        DataStore::opened = false;
+        _open();
+        if (DataStore::journalFd < 0) {
+            DataStore::failedCount++;
+            cond.notify_all();
+            return;
+        }
+    }
+
+    // published to the readers before being written
+    RecordMap values;
+    values.swap(DataStore::unsaved);
+    for (auto &kv : values) {
+        DataStore::journaled[kv.first] = kv.second;
+    }
+    unsigned long long count = DataStore::setCount;
+    unsigned long long offset = DataStore::journalSize;
+    int fd = DataStore::journalFd;
+    DataStore::writing = true;
+    lock.unlock();
+
+    std::string buf;
+    for (auto &kv : values) {
+        std::string body;
+        body.push_back(kv.second.data ? DATA_STORE_RECORD_PUT : DATA_STORE_RECORD_REMOVE);
+        appendU32(body, (unsigned int)kv.first.length());
+        body.append(kv.first);
+        if (kv.second.data) {
+            body.append(*kv.second.bytes);
+        }
+        appendU32(buf, (unsigned int)body.size());
+        appendU32(buf, crc32((const unsigned char *)body.data(), body.size()));
+        buf.append(body);
+    }
+    bool ret = writeAll(fd, buf.data(), buf.size()) && fsync(fd) == 0;
+    if (!ret) {
+        // drop the torn tail, so later records are not appended behind bytes that end the replay
+        if (ftruncate(fd, offset) != 0) {
+            LOGE("DataStore: failed to truncate journal.");
+        }
+        lseek(fd, offset, SEEK_SET);
+    }
+
+    lock.lock();
+    DataStore::writing = false;
+    if (ret) {
+        DataStore::journalSize += buf.size();
+        DataStore::writtenCount = count;
+    } else {
+        LOGE("DataStore: failed to write journal.");
+        // requeued unless a newer value was set meanwhile
+        for (auto &kv : values) {
+            DataStore::unsaved.insert(kv);
+        }
+        DataStore::failedCount++;
+    }
+    cond.notify_all();
+}
+
+void DataStore::_compact(std::unique_lock<std::mutex> &lock) {
+    if (DataStore::journalFd < 0) return;
+
+    // only the writer adds to the journal, so everything in it is in journaled
+    auto values = DataStore::journaled;
+    bool compressed = DataStore::compressionEnabled;
+    int fd = DataStore::journalFd;
+    DataStore::writing = true;
+    lock.unlock();
+
+    bool ret = true;
+    for (auto &kv : values) {
+        std::string file = getStoreFilePath(kv.first);
+        if (kv.second.data) {
+            try {
+                if (!writeFileSync(file, compressed ? compressBytes(*kv.second.bytes) : *kv.second.bytes)) ret = false;
+            } catch (std::ios_base::failure &e) {
+                ret = false;
+            }
+        } else {
+            std::remove(file.c_str());
+        }
+    }
+    syncDirectory(getStoreDirectory());
+    if (ret) {
+        ret = ftruncate(fd, 0) == 0 && fsync(fd) == 0;
+        lseek(fd, 0, SEEK_SET);
+    }
+
+    lock.lock();
+    DataStore::writing = false;
+    if (ret) {
+        for (auto &kv : values) {
+            auto it = DataStore::journaled.find(kv.first);
+            if (it != DataStore::journaled.end() && it->second.bytes == kv.second.bytes && it->second.data == kv.second.data) {
+                DataStore::journaled.erase(it);
+            }
+        }
+        DataStore::journalSize = 0;
+    } else {
+        LOGE("DataStore: failed to compact journal.");
+    }
+    cond.notify_all();
+}
+
+
+#pragma - Debug
+
+std::string DataStore::dumpJson(std::string key, bool pretty) {
+    std::shared_ptr<Data> data = nullptr;
+    if (!_findCache(key, &data)) {
+        data = _load(key);
+    }
+    if (!data) return "null";
+    return Json::toJson(data, pretty);
+}
@@ -8,6 +8,8 @@
 #include <iostream>
 #include <fstream>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <assert.h>
 #include <stdlib.h>
 #include <string.h>
@@ -24,18 +26,18 @@ namespace mog {
     public:
         template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
         static std::shared_ptr<T> getData(std::string key, const std::shared_ptr<T> &defaultValue) {
-            std::lock_guard<std::mutex> lock(mtx);
-            
-            if (!_hasKey(key)) {
-                return defaultValue;
+            std::shared_ptr<Data> data = nullptr;
+            if (!_findCache(key, &data)) {
+                data = _load(key);
             }
-            
-            auto data = DataStore::caches[key];
-            if (data) {
-                return std::static_pointer_cast<T>(data);
-            } else {
-                return _deserialize<T>(key);
+            if (!data) return defaultValue;
+            if (!isDataType<T>(data->type)) {
+#ifdef MOG_DEBUG
+                LOGE("Type Error : %s, %d, %s\n", key.c_str(), (int)data->type, typeid(T).name());
+#endif
+                return defaultValue;
             }
+            return std::static_pointer_cast<T>(data);
         }
         
         template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
@@ -43,6 +45,7 @@ namespace mog {
             return getData<T>(key, nullptr);
         }
         
+        // the value is serialized when set, so later changes to it are saved by setting it again
         static void setData(std::string key, const std::shared_ptr<Data> &value, bool immediatelySave = false);
         static void serialize(std::string filepath, const std::shared_ptr<Data> &data);
         static std::shared_ptr<ByteArray> serialize(const std::shared_ptr<Data> &data);
@@ -53,7 +56,7 @@ namespace mog {
             std::ifstream fin;
             fin.exceptions(std::ios::failbit|std::ios::badbit);
             fin.open(filepath, std::ios::in|std::ios::binary);
-            data->read(fin);
+            _read(fin, data);
             fin.close();
             return data;
         }
@@ -61,13 +64,10 @@ namespace mog {
         template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
         static std::shared_ptr<T> deserialize(const std::shared_ptr<ByteArray> &bytes) {
             auto data = std::shared_ptr<T>(new T());
-            unsigned char *byteData = nullptr;
-            unsigned int len = 0;
-            bytes->getValue(&byteData, &len);
-            auto str = std::string(byteData, byteData + len);
-            std::istringstream sin(str, std::ios::binary);
+            ByteArrayStreamBuffer buffer(bytes);
+            std::istream sin(&buffer);
             sin.exceptions(std::ios::failbit|std::ios::badbit);
-            data->read(sin);
+            _read(sin, data);
             return data;
         }
         
@@ -82,35 +82,70 @@ namespace mog {
         static void remove(std::string key);
         static void removeAll();
         static void save();
+        // waits only for the pending value of key
         static void save(std::string key);
+        // waits until every value set so far is in the journal. returns false on timeout or a failed write.
+        static bool flush(float timeout = -1);
+        // store files and serialize() output are compressed when enabled. compressed data is detected on read either way.
+        static void setCompressionEnabled(bool enabled);
+        static bool isCompressionEnabled();
         static void clearCache();
+        static std::string dumpJson(std::string key, bool pretty = true);
         
     private:
-        static std::unordered_map<std::string, std::shared_ptr<Data>> caches;
-        static std::unordered_map<std::string, bool> unsaved;
+        typedef std::unordered_map<std::string, std::shared_ptr<Data>> CacheMap;
+        // data is what readers see, bytes is its serialized snapshot taken by setData, so the writer never
+        // touches an object the caller can still modify. nullptr data means removed.
+        struct Record {
+            std::shared_ptr<Data> data;
+            std::shared_ptr<const std::string> bytes;
+            // setCount when it was set, written once writtenCount reaches it
+            unsigned long long seq = 0;
+        };
+        typedef std::unordered_map<std::string, Record> RecordMap;
+
+        // immutable snapshots read without locking, replaced under mtx. nullptr means the key does not exist.
+        static std::shared_ptr<const CacheMap> caches[DATA_STORE_CACHE_SHARD_NUM];
+        static unsigned long long cacheGeneration;
+        // waiting for the writer
+        static RecordMap unsaved;
+        // in the journal but not yet compacted into the store files
+        static RecordMap journaled;
         static std::mutex mtx;
+        static std::mutex loadMtx;
+        static std::condition_variable cond;
+        static bool opened;
+        static bool writerStarted;
+        static bool writerStopping;
+        static bool writing;
+        static bool flushRequested;
+        static unsigned long long setCount;
+        static unsigned long long writtenCount;
+        static unsigned long long failedCount;
+        static int journalFd;
+        static unsigned long long journalSize;
+        static std::atomic<bool> compressionEnabled;
         
-        static bool _hasKey(std::string key);
-        static void _remove(std::string key);
+        static bool _findCache(const std::string &key, std::shared_ptr<Data> *data);
+        static void _putCache(const std::string &key, const std::shared_ptr<Data> &data);
+        static void _clearCache();
+        static std::shared_ptr<Data> _load(const std::string &key);
+        static unsigned long long _set(std::string key, Record record);
         static void _removeAll();
-        static void _save();
-        static void _save(std::string key);
-        
-        static void _serialize(std::string key, const std::shared_ptr<Data> &data);
-        
-        template <class T, typename std::enable_if<std::is_base_of<Data, T>::value>::type*& = enabler>
-        static std::shared_ptr<T> _deserialize(std::string key) {
-            std::shared_ptr<T> d = nullptr;
-            std::string file = getStoreFilePath(key);
-            struct stat st;
-            if (stat(file.c_str(), &st) != 0) return d;
-            
-            d = deserialize<T>(file);
-            DataStore::caches[key] = d;
-            return d;
+        static bool _flush(std::unique_lock<std::mutex> &lock, float timeout, unsigned long long target);
+
+        static void _open();
+        static void _startWriter();
+        static void runWriter();
+        static void stopWriter();
+        static void _writeJournal(std::unique_lock<std::mutex> &lock);
+        static void _compact(std::unique_lock<std::mutex> &lock);
+        static std::string getJournalFilePath() {
+            return getStoreDirectory() + "journal";
         }
-        
-        
+
+        static std::shared_ptr<Data> _read(std::istream &in);
+        static void _read(std::istream &in, const std::shared_ptr<Data> &data);
     };
 }
 
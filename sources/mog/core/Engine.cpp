@@ -2,6 +2,7 @@
 #include <typeinfo>
 #include <unordered_map>
 #include <math.h>
+#include <algorithm>
 #include "mog/Constants.h"
 #include "mog/core/opengl.h"
 #include "mog/core/Engine.h"
@@ -10,6 +11,7 @@
 #include "mog/base/AppBase.h"
 #include "mog/core/Screen.h"
 #include "mog/core/DataStore.h"
+#include "mog/core/TweenManager.h"
 
 using namespace mog;
 
@@ -31,6 +33,8 @@ std::shared_ptr<Engine> Engine::getInstance() {
 
 Engine::Engine() {
     this->renderer = Renderer::create();
+    this->touchIndex = CollisionWorld::create();
+    this->frameGovernor = FrameGovernor::create();
 }
 
 Engine::~Engine() {
@@ -45,6 +49,7 @@ void Engine::startEngine() {
     
     this->startTimer();
     this->lastElapsedSec = this->getTimerElapsedSec();
+    this->accumulatedTime = 0;
     
     if (!this->stats) {
 #if defined(MOG_DEBUG) && MOG_STATS_ENABLE
@@ -73,41 +78,123 @@ void Engine::stopEngine() {
     AudioPlayer::onPause();
     
     this->stopTimer();
-    DataStore::save();
+    DataStore::flush(DATA_STORE_PAUSE_FLUSH_TIMEOUT);
     this->releaseAllBuffers();
 
     this->running = false;
 }
 
-void Engine::onDrawFrame(const std::map<unsigned int, TouchInput> &touches) {
-    if (!this->running) return;
+bool Engine::onDrawFrame(const std::map<unsigned int, TouchInput> &touches) {
+    if (!this->running) return false;
 
     if (this->dirtyFlag == DIRTY_ALL) {
         this->initParameters();
     }
     
-    float elapsed = this->getTimerElapsedSec();
+    // frames arriving faster than the target rate are skipped, unless they carry touches
+    long long timestamp = this->getTimerElapsed();
+    if (this->presentSkippable && touches.size() == 0 && this->dirtyFlag == 0 &&
+        this->frameGovernor->shouldSkipFrame(timestamp)) {
+        this->stats->skippedFrameCount++;
+        this->skippedFrameCount++;
+        return false;
+    }
+    this->frameGovernor->beginFrame(timestamp);
+
+    float elapsed = timestamp * 0.000001f;
     float delta = elapsed - this->lastElapsedSec;
     this->lastElapsedSec = elapsed;
 
-    this->initScreen();
-    this->clearColor();
+    // touchable entities are only collected on frames that carry touches
+    bool tracking = (this->touchEnable && touches.size() > 0);
+    if (tracking) {
+        this->touchFrame++;
+        this->touchOrderCounter = 0;
+    }
 
-    this->stats->drawCallCount = 0;
-    
-    if (this->app) {
-        this->app->drawFrame(delta, touches, this->dirtyFlag);
+    if (this->fixedTimestep > 0) {
+        this->updateFixedFrame(delta, tracking);
+    } else {
+        this->touchTracking = tracking;
+        TweenManager::getInstance()->update(delta);
+
+        if (this->app) {
+            this->app->updateFrame(delta, this->dirtyFlag);
+        }
     }
+    this->touchTracking = tracking;
     
-    this->stats->drawFrame(delta, this->dirtyFlag);
+    bool rendered = this->needsRender(touches);
+    if (rendered) {
+        this->initScreen();
+        this->clearColor();
+        
+        this->stats->drawCallCount = 0;
+        
+        if (this->app) {
+            this->app->drawFrame(delta, touches);
+        }
+        
+        this->stats->drawFrame(delta, this->dirtyFlag);
+        this->renderRequested = false;
+    } else {
+        this->stats->skippedFrameCount++;
+        this->skippedFrameCount++;
+    }
     
     this->frameCount++;
     
     this->fireTouchListeners(touches);
+    this->touchTracking = false;
     
     this->invokeOnUpdateFunc();
     
     this->dirtyFlag = 0;
+    
+    this->frameGovernor->endFrame(this->getTimerElapsed());
+
+    return rendered;
+}
+
+void Engine::updateFixedFrame(float delta, bool tracking) {
+    this->accumulatedTime += delta;
+
+    int steps = 0;
+    while (this->accumulatedTime >= this->fixedTimestep && steps < this->maxStepsPerFrame) {
+        this->accumulatedTime -= this->fixedTimestep;
+        steps++;
+        bool lastStep = (this->accumulatedTime < this->fixedTimestep || steps == this->maxStepsPerFrame);
+        this->touchTracking = (tracking && lastStep && !this->interpolationEnable);
+        this->interpolationRequested = false;
+
+        TweenManager::getInstance()->update(this->fixedTimestep);
+        if (this->app) {
+            this->app->updateFrame(this->fixedTimestep, this->dirtyFlag);
+        }
+    }
+    // a frame that would need more catch-up steps drops the backlog instead of spiraling
+    if (this->accumulatedTime >= this->fixedTimestep) {
+        this->accumulatedTime = fmodf(this->accumulatedTime, this->fixedTimestep);
+    }
+    this->interpolationAlpha = this->accumulatedTime / this->fixedTimestep;
+
+    // the interpolation pass only rebuilds matrices, so touches are hit-tested where entities are drawn
+    bool interpolating = (this->interpolationEnable && (this->interpolationRequested || tracking));
+    if (!interpolating && !(tracking && steps == 0)) return;
+    this->touchTracking = tracking;
+    this->interpolatingFrame = true;
+    if (this->app) {
+        this->app->updateFrame(0, 0);
+    }
+    this->interpolatingFrame = false;
+}
+
+bool Engine::needsRender(const std::map<unsigned int, TouchInput> &touches) {
+    if (!this->renderOnDemand || !this->presentSkippable) return true;
+    if (this->dirtyFlag > 0 || this->renderRequested) return true;
+    if (touches.size() > 0) return true;
+    if (this->onUpdateFuncs.size() > 0 || this->onUpdateFuncsToAdd.size() > 0) return true;
+    return (this->app && this->app->isDirty());
 }
 
 void Engine::onLowMemory() {
@@ -151,6 +238,67 @@ Color Engine::getClearColor() {
 
 void Engine::setClearColor(const Color &color) {
     this->color = color;
+    this->renderRequested = true;
+}
+
+void Engine::setRenderOnDemand(bool renderOnDemand) {
+    this->renderOnDemand = renderOnDemand;
+    this->renderRequested = true;
+}
+
+bool Engine::isRenderOnDemand() {
+    return this->renderOnDemand;
+}
+
+void Engine::requestRender() {
+    this->renderRequested = true;
+}
+
+void Engine::setPresentSkippable(bool presentSkippable) {
+    this->presentSkippable = presentSkippable;
+}
+
+bool Engine::isFrameSkippingActive() {
+    return this->renderOnDemand || this->frameGovernor->getTargetFps() > 0;
+}
+
+unsigned long long Engine::getSkippedFrameCount() {
+    return this->skippedFrameCount;
+}
+
+void Engine::setFixedTimestep(float timestep, int maxStepsPerFrame) {
+    this->fixedTimestep = fmax(0.0f, timestep);
+    this->maxStepsPerFrame = std::max(1, maxStepsPerFrame);
+    this->accumulatedTime = 0;
+    this->interpolationAlpha = 1.0f;
+}
+
+float Engine::getFixedTimestep() {
+    return this->fixedTimestep;
+}
+
+int Engine::getMaxStepsPerFrame() {
+    return this->maxStepsPerFrame;
+}
+
+void Engine::setInterpolationEnable(bool enable) {
+    this->interpolationEnable = enable;
+}
+
+bool Engine::isInterpolationEnable() {
+    return (this->interpolationEnable && this->fixedTimestep > 0);
+}
+
+bool Engine::isInterpolatingFrame() {
+    return this->interpolatingFrame;
+}
+
+float Engine::getInterpolationAlpha() {
+    return this->interpolationAlpha;
+}
+
+void Engine::requestInterpolation() {
+    this->interpolationRequested = true;
 }
 
 void Engine::clearColor() {
@@ -162,12 +310,26 @@ void Engine::onKeyEvent(const KeyEvent &keyEvent) {
     
 }
 
+void Engine::setTargetFps(float targetFps) {
+    this->frameGovernor->setTargetFps(targetFps);
+}
+
+float Engine::getTargetFps() {
+    return this->frameGovernor->getTargetFps();
+}
+
+std::shared_ptr<FrameGovernor> Engine::getFrameGovernor() {
+    return this->frameGovernor;
+}
+
 void Engine::setStatsEnable(bool enable) {
     this->stats->setEnable(enable);
+    this->renderRequested = true;
 }
 
 void Engine::setStatsAlignment(Alignment alignment) {
     this->stats->setAlignment(alignment);
+    this->renderRequested = true;
 }
 
 std::shared_ptr<MogStats> Engine::getStats() {
@@ -218,24 +380,28 @@ void Engine::fireTouchListeners(std::map<unsigned int, TouchInput> touches) {
         }
         
         if (this->touchEnable) {
-            bool isSwallowTouches = false;
-            
-            for (int i = (int)this->touchableEntities.size() - 1; i >= 0; i--) {
-                auto entity = this->touchableEntities[i];
-                
-                if (touchInput.action == TouchAction::TouchDown || touchInput.action == TouchAction::TouchDownUp) {
-                    if (!isSwallowTouches && entity->contains(p)) {
-                        entity->fireTouchBeginEvent(touch);
-                        
-                        if (entity->isSwallowTouches()) {
-                            isSwallowTouches = true;
-                        }
-                    }
+            // only entities under the touch, or already touched by it, can react to it
+            if (touchInput.action == TouchAction::TouchDown || touchInput.action == TouchAction::TouchDownUp) {
+                for (auto &entity : this->getTouchableEntitiesAt(p)) {
+                    entity->fireTouchBeginEvent(touch);
+                    this->addTouchedEntity(touchId, entity);
+                    if (entity->isSwallowTouches()) break;
                 }
-                if (touchInput.action == TouchAction::TouchMove) {
+            }
+            if (touchInput.action == TouchAction::TouchMove) {
+                for (auto &entity : this->getTouchableEntitiesAt(p)) {
+                    this->addTouchedEntity(touchId, entity);
+                }
+                auto touched = this->touchedEntities[touchId];
+                this->sortByDrawOrder(touched);
+                for (auto &entity : touched) {
                     entity->fireTouchMoveEvent(touch);
                 }
-                if (touchInput.action == TouchAction::TouchUp || touchInput.action == TouchAction::TouchDownUp) {
+            }
+            if (touchInput.action == TouchAction::TouchUp || touchInput.action == TouchAction::TouchDownUp) {
+                auto touched = this->touchedEntities[touchId];
+                this->sortByDrawOrder(touched);
+                for (auto &entity : touched) {
                     entity->fireTouchEndEvent(touch);
                 }
             }
@@ -243,6 +409,7 @@ void Engine::fireTouchListeners(std::map<unsigned int, TouchInput> touches) {
         
         if (touchInput.action == TouchAction::TouchUp || touchInput.action == TouchAction::TouchDownUp) {
             this->prevTouches.erase(touchId);
+            this->touchedEntities.erase(touchId);
         } else {
             this->prevTouches[touchId] = touch;
         }
@@ -252,11 +419,64 @@ void Engine::fireTouchListeners(std::map<unsigned int, TouchInput> touches) {
         }
     }
     
-    this->touchableEntities.clear();
+    if (this->touchTracking) {
+        this->pruneTouchableEntities();
+    }
+}
+
+std::vector<std::shared_ptr<Entity>> Engine::getTouchableEntitiesAt(const Point &position) {
+    auto entities = this->touchIndex->queryPoint(position);
+    this->sortByDrawOrder(entities);
+    return entities;
 }
 
-void Engine::pushTouchableEntity(const std::shared_ptr<Entity> &entity) {
-    this->touchableEntities.emplace_back(entity);
+void Engine::addTouchedEntity(unsigned int touchId, const std::shared_ptr<Entity> &entity) {
+    auto &touched = this->touchedEntities[touchId];
+    if (std::find(touched.begin(), touched.end(), entity) == touched.end()) {
+        touched.emplace_back(entity);
+    }
+}
+
+void Engine::sortByDrawOrder(std::vector<std::shared_ptr<Entity>> &entities) {
+    // drops entities that were not touchable this frame, then sorts front to back
+    auto touchables = &this->touchableEntities;
+    unsigned long long frame = this->touchFrame;
+    entities.erase(std::remove_if(entities.begin(), entities.end(), [touchables, frame](const std::shared_ptr<Entity> &entity) {
+        auto it = touchables->find(entity.get());
+        return (it == touchables->end() || it->second.frame != frame);
+    }), entities.end());
+    std::sort(entities.begin(), entities.end(), [touchables](const std::shared_ptr<Entity> &e1, const std::shared_ptr<Entity> &e2) {
+        return touchables->at(e1.get()).order > touchables->at(e2.get()).order;
+    });
+}
+
+void Engine::pruneTouchableEntities() {
+    if (this->touchableEntities.size() <= this->touchOrderCounter * 2 + 64) return;
+    for (auto it = this->touchableEntities.begin(); it != this->touchableEntities.end();) {
+        if (it->second.frame == this->touchFrame) {
+            ++it;
+            continue;
+        }
+        if (auto entity = it->second.entity.lock()) {
+            this->touchIndex->remove(entity);
+        }
+        it = this->touchableEntities.erase(it);
+    }
+}
+
+bool Engine::isTouchTracking() {
+    return this->touchTracking;
+}
+
+void Engine::pushTouchableEntity(Entity *entity) {
+    auto &touchable = this->touchableEntities[entity];
+    if (touchable.entity.expired()) {
+        auto self = std::static_pointer_cast<Entity>(entity->shared_from_this());
+        touchable.entity = self;
+        this->touchIndex->add(self);
+    }
+    touchable.order = ++this->touchOrderCounter;
+    touchable.frame = this->touchFrame;
 }
 
 void Engine::setTouchEnable(bool enable) {
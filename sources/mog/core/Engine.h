@@ -10,6 +10,8 @@
 #include "mog/core/Screen.h"
 #include "mog/core/AudioPlayer.h"
 #include "mog/core/MogStats.h"
+#include "mog/core/FrameGovernor.h"
+#include "mog/core/CollisionWorld.h"
 #include "mog/base/AppBase.h"
 
 extern void *enabler;
@@ -27,7 +29,7 @@ namespace mog {
         void startEngine();
         void stopEngine();
         
-        void onDrawFrame(const std::map<unsigned int, TouchInput> &touches);
+        bool onDrawFrame(const std::map<unsigned int, TouchInput> &touches);
         void onLowMemory();
         void onKeyEvent(const KeyEvent &keyEvent);
 
@@ -48,6 +50,28 @@ namespace mog {
         long long getTimerElapsed();
         float getTimerElapsedSec();
         
+        void setRenderOnDemand(bool renderOnDemand);
+        bool isRenderOnDemand();
+        void requestRender();
+        void setPresentSkippable(bool presentSkippable);
+        // true while render on demand or a frame cap may leave frames unrendered
+        bool isFrameSkippingActive();
+        unsigned long long getSkippedFrameCount();
+
+        // timestep 0 runs the simulation once per rendered frame with the raw delta
+        void setFixedTimestep(float timestep, int maxStepsPerFrame = 5);
+        float getFixedTimestep();
+        int getMaxStepsPerFrame();
+        void setInterpolationEnable(bool enable);
+        bool isInterpolationEnable();
+        bool isInterpolatingFrame();
+        float getInterpolationAlpha();
+        void requestInterpolation();
+
+        void setTargetFps(float targetFps);
+        float getTargetFps();
+        std::shared_ptr<FrameGovernor> getFrameGovernor();
+
         void setStatsEnable(bool enable);
         void setStatsAlignment(Alignment alignment);
         std::shared_ptr<MogStats> getStats();
@@ -56,7 +80,8 @@ namespace mog {
         void setMultiTouchEnable(bool enable);
         bool isTouchEnable();
         bool isMultiTouchEnable();
-        void pushTouchableEntity(const std::shared_ptr<Entity> &entity);
+        bool isTouchTracking();
+        void pushTouchableEntity(Entity *entity);
 
         unsigned int registerOnUpdateFunc(std::function<void(unsigned int funcId)> onUpdateFunc);
         void removeOnUpdateFunc(unsigned int funcId);
@@ -67,6 +92,7 @@ namespace mog {
         std::shared_ptr<AppBase> app;
         std::shared_ptr<Renderer> renderer;
         std::shared_ptr<MogStats> stats;
+        std::shared_ptr<FrameGovernor> frameGovernor;
         bool running = false;
         unsigned long long frameCount = 0;
         Color color = Color::black;
@@ -79,20 +105,44 @@ namespace mog {
         long long timerBackupTime = 0;
         float lastElapsedSec = 0;
         unsigned char dirtyFlag = 0;
+        bool renderOnDemand = false;
+        bool renderRequested = false;
+        bool presentSkippable = true;
+        unsigned long long skippedFrameCount = 0;
+        float fixedTimestep = 0;
+        int maxStepsPerFrame = 5;
+        float accumulatedTime = 0;
+        bool interpolationEnable = true;
+        bool interpolatingFrame = false;
+        bool interpolationRequested = false;
+        float interpolationAlpha = 1.0f;
 
         std::unordered_map<unsigned int, std::function<void(unsigned int funcId)>> onUpdateFuncs;
         std::unordered_map<unsigned int, std::function<void(unsigned int funcId)>> onUpdateFuncsToAdd;
         std::vector<unsigned int> onUpdateFuncIdsToRemove;
         
         void invokeOnUpdateFunc();
+        bool needsRender(const std::map<unsigned int, TouchInput> &touches);
+        void updateFixedFrame(float delta, bool tracking);
         
     private:
+        struct TouchableEntity {
+            std::weak_ptr<Entity> entity;
+            unsigned int order = 0;
+            unsigned long long frame = 0;
+        };
+
         static std::weak_ptr<Engine> instance;
         
         bool initialized = false;
         bool touchEnable = true;
         bool multiTouchEnable = true;
-        std::vector<std::shared_ptr<Entity>> touchableEntities;
+        bool touchTracking = false;
+        unsigned long long touchFrame = 0;
+        unsigned int touchOrderCounter = 0;
+        std::shared_ptr<CollisionWorld> touchIndex;
+        std::unordered_map<Entity *, TouchableEntity> touchableEntities;
+        std::unordered_map<unsigned int, std::vector<std::shared_ptr<Entity>>> touchedEntities;
         std::unordered_map<int, Touch> prevTouches;
         std::shared_ptr<Screen> screen;
         std::shared_ptr<AudioPlayer> audioPlayer;
@@ -103,6 +153,10 @@ namespace mog {
         void releaseAllBuffers();
 
         void fireTouchListeners(std::map<unsigned int, TouchInput> touches);
+        std::vector<std::shared_ptr<Entity>> getTouchableEntitiesAt(const Point &position);
+        void addTouchedEntity(unsigned int touchId, const std::shared_ptr<Entity> &entity);
+        void sortByDrawOrder(std::vector<std::shared_ptr<Entity>> &entities);
+        void pruneTouchableEntities();
     };
 }
 
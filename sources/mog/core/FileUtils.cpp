@@ -2,6 +2,7 @@
 #include "mog/core/FileUtils.h"
 #include "mog/core/FileUtilsNative.h"
 #include "mog/core/mog_functions.h"
+#include "mog/core/Compression.h"
 #include <fstream>
 #include <stdlib.h>
 
@@ -11,15 +12,32 @@ bool FileUtils::existAsset(std::string filename) {
     return FileUtilsNative::existAsset(filename);
 }
 
+// read as bytes, so that compressed text assets are detected before decoding
 std::string FileUtils::readTextAsset(std::string filename) {
-    return FileUtilsNative::readTextAsset(filename);
+    auto bytes = FileUtils::readBytesAsset(filename);
+    if (!bytes) return "";
+    unsigned char *value = nullptr;
+    unsigned int length = 0;
+    bytes->getValue(&value, &length);
+    if (!value) return "";
+    return std::string((const char *)value, length);
 }
 
 std::shared_ptr<ByteArray> FileUtils::readBytesAsset(std::string filename) {
     unsigned char *data = nullptr;
     unsigned int len = 0;
     FileUtilsNative::readBytesAsset(filename, &data, &len);
-    return ByteArray::create(data, len);
+    auto bytes = ByteArray::create(data, len);
+    if (Compression::isCompressed(bytes)) {
+        auto decompressed = Compression::decompress(bytes);
+        if (!decompressed) {
+            // callers expect a ByteArray, the same as for a missing asset
+            LOGE("asset decompress failed: %s", filename.c_str());
+            return ByteArray::create(nullptr, 0);
+        }
+        return decompressed;
+    }
+    return bytes;
 }
 
 std::shared_ptr<ByteArray> FileUtils::readFile(std::string filename, Directory dir) {
@@ -0,0 +1,199 @@
+#include "mog/core/FrameGovernor.h"
+#include <math.h>
+#include <algorithm>
+
+#define FRAME_GOVERNOR_SMOOTHING 0.1f
+#define FRAME_GOVERNOR_WINDOW_SIZE 120
+#define FRAME_GOVERNOR_LATE_RATIO 1.5f
+#define FRAME_GOVERNOR_LATE_FRAMES_RATIO 0.25f
+#define FRAME_GOVERNOR_VSYNC_GAP_RATIO 1.5f
+
+using namespace mog;
+
+std::shared_ptr<FrameGovernor> FrameGovernor::create(float targetFps) {
+    auto governor = std::shared_ptr<FrameGovernor>(new FrameGovernor());
+    governor->setTargetFps(targetFps);
+    governor->setWindowSize(FRAME_GOVERNOR_WINDOW_SIZE);
+    return governor;
+}
+
+void FrameGovernor::setTargetFps(float targetFps) {
+    this->targetFps = fmax(0.0f, targetFps);
+    this->resetWindow();
+}
+
+float FrameGovernor::getTargetFps() {
+    return this->targetFps;
+}
+
+float FrameGovernor::getFrameBudget() {
+    return (this->targetFps > 0) ? 1.0f / this->targetFps : this->vsyncInterval;
+}
+
+float FrameGovernor::getVsyncInterval() {
+    return this->vsyncInterval;
+}
+
+bool FrameGovernor::shouldSkipFrame(long long timestamp) {
+    this->trackVsync(timestamp);
+    if (this->targetFps <= 0 || this->lastFrameTimestamp == 0 || this->vsyncInterval <= 0) return false;
+    // render every n-th vsync. n rounds down unless the cap is exceeded by more than a quarter,
+    // so a 90Hz display capped at 60 runs at 90 rather than alternating 1 and 2 vsyncs.
+    int vsyncs = std::max(1, (int)floorf(1.0f / (this->targetFps * this->vsyncInterval) + 0.25f));
+    float elapsed = (timestamp - this->lastFrameTimestamp) * 0.000001f;
+    return (elapsed < (vsyncs - 0.5f) * this->vsyncInterval);
+}
+
+void FrameGovernor::beginFrame(long long timestamp) {
+    this->trackVsync(timestamp);
+    if (this->lastFrameTimestamp > 0) {
+        this->lastFrameInterval = (timestamp - this->lastFrameTimestamp) * 0.000001f;
+        this->frameInterval += (this->lastFrameInterval - this->frameInterval) * FRAME_GOVERNOR_SMOOTHING;
+    }
+    this->lastFrameTimestamp = timestamp;
+    this->frameBeginTimestamp = timestamp;
+}
+
+void FrameGovernor::endFrame(long long timestamp) {
+    float time = (timestamp - this->frameBeginTimestamp) * 0.000001f;
+    this->cpuTime += (time - this->cpuTime) * FRAME_GOVERNOR_SMOOTHING;
+
+    float budget = this->getFrameBudget();
+    if (budget <= 0 || !this->adaptiveQualityEnable || this->qualityTierNum <= 1) return;
+    this->pushLoad(time / budget, this->lastFrameInterval > budget * FRAME_GOVERNOR_LATE_RATIO);
+}
+
+float FrameGovernor::getCpuTime() {
+    return this->cpuTime;
+}
+
+float FrameGovernor::getFrameInterval() {
+    return this->frameInterval;
+}
+
+float FrameGovernor::getLoad() {
+    float budget = this->getFrameBudget();
+    return (budget > 0) ? this->cpuTime / budget : 0;
+}
+
+void FrameGovernor::setQualityTierNum(int tierNum) {
+    this->qualityTierNum = std::max(1, tierNum);
+    if (this->qualityTier >= this->qualityTierNum) {
+        this->changeQualityTier(this->qualityTierNum - 1);
+    }
+}
+
+int FrameGovernor::getQualityTierNum() {
+    return this->qualityTierNum;
+}
+
+void FrameGovernor::setQualityTier(int tier) {
+    this->changeQualityTier(std::max(0, std::min(tier, this->qualityTierNum - 1)));
+}
+
+int FrameGovernor::getQualityTier() {
+    return this->qualityTier;
+}
+
+void FrameGovernor::setAdaptiveQualityEnable(bool enable) {
+    this->adaptiveQualityEnable = enable;
+    this->resetWindow();
+}
+
+bool FrameGovernor::isAdaptiveQualityEnable() {
+    return this->adaptiveQualityEnable;
+}
+
+void FrameGovernor::setWindowSize(int frames) {
+    frames = std::max(1, frames);
+    this->loads.assign(frames, 0);
+    this->lateFrames.assign(frames, false);
+    this->resetWindow();
+}
+
+void FrameGovernor::setLoadThresholds(float overloadLoad, float underloadLoad) {
+    this->overloadLoad = overloadLoad;
+    this->underloadLoad = std::min(underloadLoad, overloadLoad);
+}
+
+void FrameGovernor::setOnQualityTierChangeEvent(std::function<void(int tier, int prevTier)> onQualityTierChangeEvent) {
+    this->onQualityTierChangeEvent = onQualityTierChangeEvent;
+}
+
+// estimated from callback intervals. longer gaps are missed vsyncs or pauses and do not move the estimate.
+void FrameGovernor::trackVsync(long long timestamp) {
+    if (timestamp <= this->lastVsyncTimestamp) return;
+    if (this->lastVsyncTimestamp > 0) {
+        float interval = (timestamp - this->lastVsyncTimestamp) * 0.000001f;
+        if (this->vsyncInterval <= 0) {
+            this->vsyncInterval = interval;
+        } else if (interval < this->vsyncInterval * FRAME_GOVERNOR_VSYNC_GAP_RATIO) {
+            this->vsyncInterval += (interval - this->vsyncInterval) * FRAME_GOVERNOR_SMOOTHING;
+        }
+    }
+    this->lastVsyncTimestamp = timestamp;
+}
+
+void FrameGovernor::pushLoad(float load, bool late) {
+    int size = (int)this->loads.size();
+    if (this->windowCount == size) {
+        this->loadSum -= this->loads[this->windowIdx];
+        if (this->lateFrames[this->windowIdx]) this->lateFrameCount--;
+    } else {
+        this->windowCount++;
+    }
+    this->loads[this->windowIdx] = load;
+    this->lateFrames[this->windowIdx] = late;
+    this->loadSum += load;
+    if (late) this->lateFrameCount++;
+    this->windowIdx = (this->windowIdx + 1) % size;
+
+    if (this->windowCount == size) {
+        this->evaluateWindow();
+    }
+}
+
+void FrameGovernor::resetWindow() {
+    this->windowIdx = 0;
+    this->windowCount = 0;
+    this->loadSum = 0;
+    this->lateFrameCount = 0;
+    std::fill(this->lateFrames.begin(), this->lateFrames.end(), false);
+}
+
+void FrameGovernor::evaluateWindow() {
+    int size = (int)this->loads.size();
+    float averageLoad = this->loadSum / size;
+    bool overloaded = (averageLoad > this->overloadLoad || this->lateFrameCount > size * FRAME_GOVERNOR_LATE_FRAMES_RATIO);
+
+    if (overloaded) {
+        this->underloadedWindows = 0;
+        if (this->qualityTier < this->qualityTierNum - 1) {
+            this->changeQualityTier(this->qualityTier + 1);
+        }
+        return;
+    }
+
+    // stepping back up needs a longer quiet period than stepping down, so tiers do not oscillate
+    if (averageLoad < this->underloadLoad && this->lateFrameCount == 0 && this->qualityTier > 0) {
+        this->underloadedWindows++;
+        if (this->underloadedWindows >= this->recoveryWindows) {
+            this->changeQualityTier(this->qualityTier - 1);
+        } else {
+            this->resetWindow();
+        }
+    } else {
+        this->underloadedWindows = 0;
+    }
+}
+
+void FrameGovernor::changeQualityTier(int tier) {
+    this->resetWindow();
+    if (tier == this->qualityTier) return;
+    this->underloadedWindows = 0;
+    int prevTier = this->qualityTier;
+    this->qualityTier = tier;
+    if (this->onQualityTierChangeEvent) {
+        this->onQualityTierChangeEvent(tier, prevTier);
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef FrameGovernor_h
+#define FrameGovernor_h
+
+#include <memory>
+#include <vector>
+#include <functional>
+
+namespace mog {
+    class FrameGovernor {
+    public:
+        static std::shared_ptr<FrameGovernor> create(float targetFps = 0);
+
+        // the cap is off by default. a cap renders every n-th vsync, so frames stay evenly paced.
+        void setTargetFps(float targetFps);
+        float getTargetFps();
+        // 1 / targetFps, or the measured vsync interval when uncapped
+        float getFrameBudget();
+        float getVsyncInterval();
+
+        bool shouldSkipFrame(long long timestamp);
+        void beginFrame(long long timestamp);
+        void endFrame(long long timestamp);
+
+        // smoothed values in seconds, load is cpu time / frame budget
+        float getCpuTime();
+        float getFrameInterval();
+        float getLoad();
+
+        // tier 0 is full quality, higher tiers are cheaper
+        void setQualityTierNum(int tierNum);
+        int getQualityTierNum();
+        void setQualityTier(int tier);
+        int getQualityTier();
+        void setAdaptiveQualityEnable(bool enable);
+        bool isAdaptiveQualityEnable();
+        void setWindowSize(int frames);
+        void setLoadThresholds(float overloadLoad, float underloadLoad);
+        void setOnQualityTierChangeEvent(std::function<void(int tier, int prevTier)> onQualityTierChangeEvent);
+
+    private:
+        FrameGovernor() {}
+
+        float targetFps = 0;
+        long long lastFrameTimestamp = 0;
+        long long lastVsyncTimestamp = 0;
+        float vsyncInterval = 0;
+        long long frameBeginTimestamp = 0;
+        float cpuTime = 0;
+        float frameInterval = 0;
+        float lastFrameInterval = 0;
+
+        int qualityTierNum = 1;
+        int qualityTier = 0;
+        bool adaptiveQualityEnable = true;
+        float overloadLoad = 0.9f;
+        float underloadLoad = 0.5f;
+        int recoveryWindows = 3;
+
+        // rolling window of per-frame loads
+        std::vector<float> loads;
+        int windowIdx = 0;
+        int windowCount = 0;
+        float loadSum = 0;
+        int lateFrameCount = 0;
+        std::vector<bool> lateFrames;
+        int underloadedWindows = 0;
+
+        std::function<void(int tier, int prevTier)> onQualityTierChangeEvent;
+
+        void trackVsync(long long timestamp);
+        void pushLoad(float load, bool late);
+        void resetWindow();
+        void evaluateWindow();
+        void changeQualityTier(int tier);
+    };
+}
+
+#endif /* FrameGovernor_h */
@@ -2,6 +2,7 @@
 #include "mog/core/Http.h"
 #include "mog/core/HttpNative.h"
 #include "mog/core/Engine.h"
+#include "mog/core/Json.h"
 
 using namespace mog;
 
@@ -32,6 +33,13 @@ void Http::Request::setBody(const std::shared_ptr<ByteArray> &body) {
     this->body = body;
 }
 
+void Http::Request::setJsonBody(const std::shared_ptr<Data> &json) {
+    this->setBody(Json::toJson(json));
+    if (this->headers.count("Content-Type") == 0) {
+        this->headers["Content-Type"] = "application/json";
+    }
+}
+
 
 void Http::request(const Http::Request &req, std::function<void(const Http::Response &res)> callback) {
     HttpNative::request(req, callback);
@@ -30,6 +30,7 @@ namespace mog {
             void setTimeout(int timeout);
             void setBody(std::string body);
             void setBody(const std::shared_ptr<ByteArray> &body);
+            void setJsonBody(const std::shared_ptr<Data> &json);
 
             std::string url;
             Method method = Method::Get;
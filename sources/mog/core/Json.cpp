@@ -1,424 +1,882 @@
 #include "mog/core/Json.h"
+#include "mog/Constants.h"
+#include "mog/core/simd.h"
+#include <atomic>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <cmath>
+
+#define JSON_MAX_DEPTH 512
+#define JSON_ARENA_ALIGN 16
+#define JSON_ARENA_MIN_BLOCK_SIZE (4 * 1024)
+#define JSON_ARENA_MAX_BLOCK_SIZE (1024 * 1024)
+// power of two
+#define JSON_KEY_CACHE_SIZE 64
 
 using namespace mog;
 
-static std::shared_ptr<Dictionary> parseObject(const char *json, int &i, int len, bool &hasError);
-static std::shared_ptr<List> parseArray(const char *json, int &i, int len, bool &hasError);
-static std::string parseText(const char *json, int &i, int len, bool &hasError);
-static void parseComment(const char *json, int &i, int len, bool &hasError);
-static std::shared_ptr<Data> parseValue(const char *json, int &i, int len, bool &hasError);
-static std::shared_ptr<Data> parseNumber(const char *json, int &i, int len, bool &hasError);
-static void skipWhiteSpace(const char *json, int &i, int len);
+#pragma - JsonArena
 
-static void dataTojsonString(std::stringstream &ss, const std::shared_ptr<Data> &data) {
-    switch (data->type) {
-        case DataType::Int:
-            ss << std::static_pointer_cast<Int>(data)->getValue();
-            break;
-            
-        case DataType::Long:
-            ss << std::static_pointer_cast<Long>(data)->getValue();
-            break;
-            
-        case DataType::Float:
-            ss << std::static_pointer_cast<Float>(data)->getValue();
-            break;
-            
-        case DataType::Double:
-            ss << std::static_pointer_cast<Double>(data)->getValue();
-            break;
-            
-        case DataType::Bool: {
-            bool b = std::static_pointer_cast<Bool>(data)->getValue();
-            if (b) {
-                ss << "true";
-            } else {
-                ss << "false";
+namespace mog {
+    // bump allocator for one parsed document, freed when the last value allocated from it is released
+    class JsonArena {
+    public:
+        JsonArena(size_t blockSize) : blockSize(blockSize) {}
+
+        ~JsonArena() {
+            while (this->blocks) {
+                Block *next = this->blocks->next;
+                mogfree(this->blocks);
+                this->blocks = next;
             }
-            break;
         }
-            
-        case DataType::String: {
-            std::string str = std::static_pointer_cast<String>(data)->getValue();
-            if (!str.empty()) {
-                std::string::size_type pos = 0;
-                while ((pos = str.find('"', pos)) != std::string::npos) {
-                    str.replace(pos, 1, "\\\"");
-                    pos += 2;
-                }
+
+        void *allocate(size_t size) {
+            size = (size + JSON_ARENA_ALIGN - 1) & ~(size_t)(JSON_ARENA_ALIGN - 1);
+            if (this->used + size > this->capacity) {
+                this->newBlock(size);
             }
-            ss << "\"" << str << "\"";
-            break;
+            void *p = this->current + this->used;
+            this->used += size;
+            return p;
         }
-            
-        case DataType::ByteArray: {
-            auto bytes = std::static_pointer_cast<ByteArray>(data);
-            ss << "[";
-            for (int i = 0; i < bytes->getLength(); i++) {
-                if (i > 0) ss << ",";
-                unsigned char b = bytes->getByte(i);
-                ss << (int)b;
-            }
-            ss << "]";
-            break;
+
+        void retain() {
+            this->refCount.fetch_add(1, std::memory_order_relaxed);
         }
-            
-        case DataType::Dictionary: {
-            auto dict = std::static_pointer_cast<Dictionary>(data);
-            ss << "{";
-            for (int i = 0; i < dict->size(); i++) {
-                if (i > 0) ss << ",";
-                auto pair = dict->getKeyValue(i);
-                dataTojsonString(ss, String::create(pair.first));
-                ss << ":";
-                dataTojsonString(ss, pair.second);
+
+        void release() {
+            if (this->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
             }
-            ss << "}";
-            break;
         }
-            
-        case DataType::List: {
-            auto list = std::static_pointer_cast<List>(data);
-            ss << "[";
-            for (int i = 0; i < list->size(); i++) {
-                if (i > 0) ss << ",";
-                dataTojsonString(ss, list->at<Data>(i));
-            }
-            ss << "]";
-            break;
+
+    private:
+        struct Block {
+            Block *next;
+        };
+        static const size_t headerSize = (sizeof(Block) + JSON_ARENA_ALIGN - 1) & ~(size_t)(JSON_ARENA_ALIGN - 1);
+
+        std::atomic<int> refCount{0};
+        size_t blockSize;
+        Block *blocks = nullptr;
+        char *current = nullptr;
+        size_t used = 0;
+        size_t capacity = 0;
+
+        void newBlock(size_t size) {
+            size_t capacity = (size > this->blockSize) ? size : this->blockSize;
+            Block *block = (Block *)mogmalloc(headerSize + capacity);
+            block->next = this->blocks;
+            this->blocks = block;
+            this->current = (char *)block + headerSize;
+            this->used = 0;
+            this->capacity = capacity;
         }
-            
-        case DataType::NativeObject:
-        case DataType::Void:
-            break;
-    }
+    };
 }
 
+// control blocks hold the arena references, since they outlive the values they own
+template <class T>
+class JsonArenaAllocator {
+public:
+    typedef T value_type;
+    JsonArena *arena;
+
+    JsonArenaAllocator(JsonArena *arena) : arena(arena) {}
+    template <class U>
+    JsonArenaAllocator(const JsonArenaAllocator<U> &other) : arena(other.arena) {}
 
-std::shared_ptr<Dictionary> Json::parse(std::string jsonText) {
-    int len = (int)jsonText.size();
-    const char *json = jsonText.c_str();
-    int i = 0;
-    
-    skipWhiteSpace(json, i, len);
-    if (json[i] != '{') {
-        return nullptr;
+    T *allocate(size_t n) {
+        this->arena->retain();
+        return (T *)this->arena->allocate(sizeof(T) * n);
     }
-    
-    bool hasError;
-    auto obj = parseObject(json, i, len, hasError);
-    if (hasError) {
-        return nullptr;
+
+    void deallocate(T *p, size_t n) {
+        this->arena->release();
     }
-    return obj;
-}
 
-std::string Json::toJson(const std::shared_ptr<Dictionary> &data) {
-    std::stringstream ss;
-    dataTojsonString(ss, data);
-    return ss.str();
+    template <class U>
+    bool operator==(const JsonArenaAllocator<U> &other) const { return this->arena == other.arena; }
+    template <class U>
+    bool operator!=(const JsonArenaAllocator<U> &other) const { return this->arena != other.arena; }
+};
+
+class JsonArenaDeleter {
+public:
+    template <class T>
+    void operator()(T *p) const {
+        p->~T();
+    }
+};
+
+template <class T, class... Args>
+std::shared_ptr<T> Json::createInArena(JsonArena *arena, Args&&... args) {
+    void *mem = arena->allocate(sizeof(T));
+    T *data = new(mem) T(std::forward<Args>(args)...);
+    return std::shared_ptr<T>(data, JsonArenaDeleter(), JsonArenaAllocator<T>(arena));
 }
 
 
+#pragma - JsonReader
 
-static std::shared_ptr<Dictionary> parseObject(const char *json, int &i, int len, bool &hasError) {
-    auto dict = Dictionary::create();
-    
-    int state = 0;   // 0:findingFirstKey, 1:finding':', 2:findingValue, 3:findingEnd, 4:findingNextKey
-    std::string key;
-    
-    i++;
-    while (i < len) {
-        switch (json[i]) {
-            case '}':
-                if (state != 0 && state != 3) {
-                    hasError = true;
-                    return nullptr;
-                }
-                return dict;
+template <class Handler>
+class JsonReader {
+public:
+    JsonReader(const char *json, size_t length, Handler &handler) : p(json), end(json + length), handler(handler) {}
+
+    bool parse(bool objectOnly) {
+        if (!this->skipWhiteSpace() || this->p >= this->end) return false;
+        if (objectOnly && *this->p != '{') return false;
+        return this->parseValue(0);
+    }
+
+private:
+    const char *p;
+    const char *end;
+    Handler &handler;
+    std::string scratch;
+
+    bool skipWhiteSpace() {
+        while (this->p < this->end) {
+            switch (*this->p) {
+                case ' ':
+                case '\n':
+                case '\r':
+                case '\t':
+                    this->p++;
+                    break;
+
+                case '/':
+                    if (!this->skipComment()) return false;
+                    break;
+
+                default:
+                    return true;
+            }
+        }
+        return true;
+    }
 
-            case ',':
-                if (state != 3) {
-                    hasError = true;
-                    return nullptr;
+    bool skipComment() {
+        if (this->p + 1 >= this->end) return false;
+        if (this->p[1] == '/') {
+            this->p += 2;
+            while (this->p < this->end && *this->p != '\n') this->p++;
+            return true;
+        }
+        if (this->p[1] == '*') {
+            this->p += 2;
+            while (this->p + 1 < this->end) {
+                if (this->p[0] == '*' && this->p[1] == '/') {
+                    this->p += 2;
+                    return true;
                 }
-                state = 4;
-                break;
+                this->p++;
+            }
+        }
+        return false;
+    }
+
+    bool parseValue(int depth) {
+        if (this->p >= this->end) return false;
+        switch (*this->p) {
+            case '{':
+                return this->parseObject(depth + 1);
+
+            case '[':
+                return this->parseArray(depth + 1);
 
             case '"': {
-                if (state == 0 || state == 4) {
-                    key = parseText(json, i, len, hasError);
-                    if (hasError) return nullptr;
-                    
-                    state = 1;
-                    
-                } else if (state == 2) {
-                    std::string value = parseText(json, i, len, hasError);
-                    if (hasError) return nullptr;
-                    
-                    dict->put(key, String::create(value));
-                    state = 3;
-                    
-                } else {
-                    hasError = true;
-                    return nullptr;
-                }
-                break;
+                const char *str;
+                size_t length;
+                if (!this->parseString(&str, &length)) return false;
+                return this->handler.onString(str, length);
             }
 
-            case ':':
-                if (state == 1) {
-                    state = 2;
-                } else {
-                    hasError = true;
-                    return nullptr;
-                }
-                break;
+            case 't':
+                return (this->parseLiteral("true", 4) && this->handler.onBool(true));
+
+            case 'f':
+                return (this->parseLiteral("false", 5) && this->handler.onBool(false));
+
+            case 'n':
+                return (this->parseLiteral("null", 4) && this->handler.onNull());
 
-            case ' ':
-            case '\t':
-            case '\n':
-                break;
-                
-            case '/':
-                parseComment(json, i, len, hasError);
-                if (hasError) return nullptr;
-                break;
-                
             default:
-                if (state == 2) {
-                    auto value = parseValue(json, i, len, hasError);
-                    if (hasError) return nullptr;
-                    
-                    dict->put(key, value);
-                    state = 3;
-                    
-                } else {
-                    hasError = true;
-                    return nullptr;
-                }
-                break;
+                return this->parseNumber();
         }
-        i++;
     }
-    return dict;
-}
 
-static std::shared_ptr<List> parseArray(const char *json, int &i, int len, bool &hasError) {
-    auto list = List::create();
-    
-    int state = 0;   // 0:findingFirstValue, 1:findingEnd, 2:findingNextKey
-
-    i++;
-    while (i < len) {
-        switch (json[i]) {
-            case ']':
-                if (state != 0 && state != 1) {
-                    hasError = true;
-                    return nullptr;
-                }
-                return list;
+    bool parseObject(int depth) {
+        if (depth > JSON_MAX_DEPTH || !this->handler.onStartObject()) return false;
+        this->p++;
+        while (true) {
+            if (!this->skipWhiteSpace() || this->p >= this->end) return false;
+            // a trailing comma is tolerated
+            if (*this->p == '}') {
+                this->p++;
+                return this->handler.onEndObject();
+            }
+            if (*this->p != '"') return false;
 
-            case ',':
-                if (state != 1) {
-                    hasError = true;
-                    return nullptr;
-                }
-                state = 0;
-                break;
-                
-            case '"': {
-                if (state == 0 || state == 2) {
-                    std::string value = parseText(json, i, len, hasError);
-                    if (hasError) return nullptr;
-                    
-                    list->append(String::create(value));
-                    state = 1;
-                }
-                break;
+            const char *key;
+            size_t length;
+            if (!this->parseString(&key, &length) || !this->handler.onKey(key, length)) return false;
+            if (!this->skipWhiteSpace() || this->p >= this->end || *this->p != ':') return false;
+            this->p++;
+            if (!this->skipWhiteSpace() || !this->parseValue(depth)) return false;
+            if (!this->skipWhiteSpace() || this->p >= this->end) return false;
+
+            if (*this->p == ',') {
+                this->p++;
+            } else if (*this->p != '}') {
+                return false;
             }
-                
-            case ' ':
-            case '\t':
-            case '\n':
-                break;
-                
-            case '/':
-                parseComment(json, i, len, hasError);
-                if (hasError) return nullptr;
-                break;
-                
-            default:
-                if (state == 0 || state == 2) {
-                    auto value = parseValue(json, i, len, hasError);
-                    if (hasError) return nullptr;
-                    
-                    list->append(value);
-                    state = 1;
-                    
-                } else {
-                    hasError = true;
-                    return nullptr;
-                }
-                break;
         }
-        i++;
     }
-    return list;
-}
 
-static std::string parseText(const char *json, int &i, int len, bool &hasError) {
-    i++;
-    int startIdx = i;
-    while (i < len) {
-        if (json[i] == '"') {
-            int textLen = i - startIdx;
-            char *text = new char[textLen + 1];
-            strncpy(text, &json[startIdx], textLen);
-            text[textLen] = '\0';
-            auto str = std::string(text);
-            delete[] text;
-            hasError = false;
-            return str;
-        }
-        i++;
-    }
-    hasError = true;
-    return "";
-}
+    bool parseArray(int depth) {
+        if (depth > JSON_MAX_DEPTH || !this->handler.onStartArray()) return false;
+        this->p++;
+        while (true) {
+            if (!this->skipWhiteSpace() || this->p >= this->end) return false;
+            if (*this->p == ']') {
+                this->p++;
+                return this->handler.onEndArray();
+            }
+            if (!this->parseValue(depth)) return false;
+            if (!this->skipWhiteSpace() || this->p >= this->end) return false;
 
-static void parseComment(const char *json, int &i, int len, bool &hasError) {
-    if (i + 1 >= len) {
-        hasError = true;
-        return;
+            if (*this->p == ',') {
+                this->p++;
+            } else if (*this->p != ']') {
+                return false;
+            }
+        }
     }
-    i++;
-    
-    if (json[i] == '/') {
-        while (i < len) {
-            if (json[i] == '\n') {
-                hasError = false;
-                return;
+
+    bool parseString(const char **str, size_t *length) {
+        const char *start = ++this->p;
+        int n = simd::findQuoteOrEscape(start, (int)(this->end - start));
+        if (start + n >= this->end) return false;
+
+        // strings without escapes are passed straight from the input buffer
+        if (start[n] == '"') {
+            *str = start;
+            *length = n;
+            this->p = start + n + 1;
+            return true;
+        }
+
+        this->scratch.assign(start, n);
+        this->p = start + n;
+        while (true) {
+            if (this->p >= this->end) return false;
+            if (*this->p == '"') {
+                this->p++;
+                break;
             }
+            if (this->p + 1 >= this->end) return false;
+            char c = this->p[1];
+            this->p += 2;
+            switch (c) {
+                case '"':
+                case '\\':
+                case '/':
+                    this->scratch.push_back(c);
+                    break;
+                case 'b':
+                    this->scratch.push_back('\b');
+                    break;
+                case 'f':
+                    this->scratch.push_back('\f');
+                    break;
+                case 'n':
+                    this->scratch.push_back('\n');
+                    break;
+                case 'r':
+                    this->scratch.push_back('\r');
+                    break;
+                case 't':
+                    this->scratch.push_back('\t');
+                    break;
+                case 'u':
+                    if (!this->parseUnicode()) return false;
+                    break;
+                default:
+                    return false;
+            }
+            n = simd::findQuoteOrEscape(this->p, (int)(this->end - this->p));
+            this->scratch.append(this->p, n);
+            this->p += n;
         }
-    } else if (json[i] == '*') {
-        while (i < len - 1) {
-            if (json[i] == '*' && json[i+1] == '/') {
-                hasError = false;
-                return;
+        *str = this->scratch.data();
+        *length = this->scratch.size();
+        return true;
+    }
+
+    bool parseHex4(unsigned int *code) {
+        if (this->end - this->p < 4) return false;
+        unsigned int value = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = this->p[i];
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= (c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= (c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= (c - 'A' + 10);
+            } else {
+                return false;
             }
         }
+        this->p += 4;
+        *code = value;
+        return true;
     }
-    hasError = true;
-}
 
-static std::shared_ptr<Data> parseValue(const char *json, int &i, int len, bool &hasError) {
-    while (i < len) {
-        switch (json[i]) {
-            case '{':
-                return parseObject(json, i, len, hasError);
-                break;
+    bool parseUnicode() {
+        unsigned int code;
+        if (!this->parseHex4(&code)) return false;
+        if (code >= 0xD800 && code <= 0xDBFF && this->end - this->p >= 6 && this->p[0] == '\\' && this->p[1] == 'u') {
+            const char *backup = this->p;
+            this->p += 2;
+            unsigned int low;
+            if (this->parseHex4(&low) && low >= 0xDC00 && low <= 0xDFFF) {
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            } else {
+                this->p = backup;
+            }
+        }
 
-            case '[':
-                return parseArray(json, i, len, hasError);
-                break;
+        if (code < 0x80) {
+            this->scratch.push_back((char)code);
+        } else if (code < 0x800) {
+            this->scratch.push_back((char)(0xC0 | (code >> 6)));
+            this->scratch.push_back((char)(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            this->scratch.push_back((char)(0xE0 | (code >> 12)));
+            this->scratch.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            this->scratch.push_back((char)(0x80 | (code & 0x3F)));
+        } else {
+            this->scratch.push_back((char)(0xF0 | (code >> 18)));
+            this->scratch.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+            this->scratch.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            this->scratch.push_back((char)(0x80 | (code & 0x3F)));
+        }
+        return true;
+    }
 
-            case 'n':
-                if (i + 4 >= len) {
-                    hasError = true;
-                    return nullptr;
-                }
-                if (json[i+1] == 'u' &&
-                    json[i+2] == 'l' &&
-                    json[i+3] == 'l') {
-                    hasError = false;
-                    i += 3;
-                    return Null::create();
-                }
-                break;
+    bool parseLiteral(const char *literal, int length) {
+        if (this->end - this->p < length || memcmp(this->p, literal, length) != 0) return false;
+        this->p += length;
+        return true;
+    }
 
-            case 't':
-                if (i + 4 >= len) {
-                    hasError = true;
-                    return nullptr;
-                }
-                if (json[i+1] == 'r' &&
-                    json[i+2] == 'u' &&
-                    json[i+3] == 'e') {
-                    hasError = false;
-                    i += 3;
-                    return Bool::create(true);
-                }
-                break;
+    bool parseNumber() {
+        const char *start = this->p;
+        const char *q = this->p;
+        bool negative = false;
+        if (q < this->end && (*q == '-' || *q == '+')) {
+            negative = (*q == '-');
+            q++;
+        }
 
-            case 'f':
-                if (i + 5 >= len) {
-                    hasError = true;
-                    return nullptr;
-                }
-                if (json[i+1] == 'a' &&
-                    json[i+2] == 'l' &&
-                    json[i+3] == 's' &&
-                    json[i+4] == 'e') {
-                    hasError = false;
-                    i += 4;
-                    return Bool::create(false);
-                }
-                break;
+        unsigned long long value = 0;
+        int intDigits = 0;
+        while (q < this->end && *q >= '0' && *q <= '9') {
+            value = value * 10 + (*q - '0');
+            intDigits++;
+            q++;
+        }
 
-            default:
-                return parseNumber(json, i, len, hasError);
+        bool isDouble = false;
+        int fracDigits = 0;
+        if (q < this->end && *q == '.') {
+            isDouble = true;
+            q++;
+            while (q < this->end && *q >= '0' && *q <= '9') {
+                fracDigits++;
+                q++;
+            }
+        }
+        if (intDigits == 0 && fracDigits == 0) return false;
+        if (q < this->end && (*q == 'e' || *q == 'E')) {
+            isDouble = true;
+            q++;
+            if (q < this->end && (*q == '-' || *q == '+')) q++;
+            if (q >= this->end || *q < '0' || *q > '9') return false;
+            while (q < this->end && *q >= '0' && *q <= '9') q++;
+        }
+        this->p = q;
+
+        if (!isDouble && intDigits <= 18) {
+            long long v = (long long)value;
+            return this->handler.onLong(negative ? -v : v);
         }
-        i++;
+
+        // the input is not null terminated, so the slow paths parse from a copy
+        char buf[64];
+        size_t length = q - start;
+        std::string longText;
+        const char *text = buf;
+        if (length < sizeof(buf)) {
+            memcpy(buf, start, length);
+            buf[length] = '\0';
+        } else {
+            longText.assign(start, length);
+            text = longText.c_str();
+        }
+        if (isDouble) {
+            return this->handler.onDouble(strtod(text, nullptr));
+        }
+        return this->handler.onLong(strtoll(text, nullptr, 10));
     }
-    hasError = true;
-    return nullptr;
-}
+};
 
-static std::shared_ptr<Data> parseNumber(const char *json, int &i, int len, bool &hasError) {
-    int startIdx = i;
-    bool hasColon = false;
-    while (i < len) {
-        char c = json[i];
-        
-        if (c >= '0' && c <= '9') {
-            // Valid Number
-        } else if (c == '-' || c == '+' || c == 'e') {
-            // Valid Sign
-        } else if (c == '.') {
-            hasColon = true;
+
+#pragma - Json::DocumentBuilder
+
+class Json::DocumentBuilder {
+public:
+    std::shared_ptr<Data> root;
+
+    DocumentBuilder(JsonArena *arena) : arena(arena) {}
+
+    bool onStartObject() {
+        return this->push(Json::createInArena<Dictionary>(this->arena), true);
+    }
+
+    // repeated keys are taken from the cache, so they skip the intern table lock
+    bool onKey(const char *key, size_t length) {
+        size_t hash = Symbol::hash(key, length);
+        auto &cached = this->keyCache[hash & (JSON_KEY_CACHE_SIZE - 1)];
+        if (cached.hash() != hash || cached.length() != length || memcmp(cached.c_str(), key, length) != 0) {
+            cached = Symbol(key, length);
+        }
+        this->stack.back().key = cached;
+        return true;
+    }
+
+    bool onEndObject() {
+        this->stack.pop_back();
+        return true;
+    }
+
+    bool onStartArray() {
+        return this->push(Json::createInArena<List>(this->arena), false);
+    }
+
+    bool onEndArray() {
+        this->stack.pop_back();
+        return true;
+    }
+
+    // scalars and short strings are stored inline in their container, only boxed values go to the arena
+    bool onString(const char *value, size_t length) {
+        if (length <= DataValue::inlineStringSize) {
+            return this->add(DataValue(std::string(value, length)));
+        }
+        return this->add(DataValue(Json::createInArena<String>(this->arena, std::string(value, length))));
+    }
+
+    bool onLong(long long value) {
+        return this->add(DataValue(value));
+    }
+
+    bool onDouble(double value) {
+        return this->add(DataValue(value));
+    }
+
+    bool onBool(bool value) {
+        return this->add(DataValue(value));
+    }
+
+    bool onNull() {
+        return this->add(DataValue());
+    }
+
+private:
+    struct Frame {
+        Data *container;
+        bool dictionary;
+        Symbol key;
+    };
+
+    JsonArena *arena;
+    std::vector<Frame> stack;
+    Symbol keyCache[JSON_KEY_CACHE_SIZE];
+
+    bool add(const DataValue &value) {
+        if (this->stack.empty()) {
+            this->root = value.toData();
+            return true;
+        }
+        auto &frame = this->stack.back();
+        if (frame.dictionary) {
+            static_cast<Dictionary *>(frame.container)->put(frame.key, value);
         } else {
-            i--;
+            static_cast<List *>(frame.container)->append(value);
+        }
+        return true;
+    }
+
+    bool push(const std::shared_ptr<Data> &container, bool dictionary) {
+        this->add(container);
+        this->stack.emplace_back(Frame{container.get(), dictionary, Symbol()});
+        return true;
+    }
+};
+
+
+#pragma - Json
+
+std::shared_ptr<Dictionary> Json::parse(const std::string &jsonText) {
+    return Json::parse(jsonText.data(), jsonText.size());
+}
+
+std::shared_ptr<Dictionary> Json::parse(const char *json, size_t length) {
+    if (!json || length == 0) return nullptr;
+
+    size_t blockSize = length * 2;
+    if (blockSize < JSON_ARENA_MIN_BLOCK_SIZE) blockSize = JSON_ARENA_MIN_BLOCK_SIZE;
+    if (blockSize > JSON_ARENA_MAX_BLOCK_SIZE) blockSize = JSON_ARENA_MAX_BLOCK_SIZE;
+    auto arena = new JsonArena(blockSize);
+    arena->retain();
+
+    std::shared_ptr<Dictionary> dict = nullptr;
+    {
+        DocumentBuilder builder(arena);
+        JsonReader<DocumentBuilder> reader(json, length, builder);
+        if (reader.parse(true)) {
+            dict = std::static_pointer_cast<Dictionary>(builder.root);
+        }
+    }
+    arena->release();
+    return dict;
+}
+
+bool Json::parse(const char *json, size_t length, JsonHandler &handler) {
+    if (!json) return false;
+    JsonReader<JsonHandler> reader(json, length, handler);
+    return reader.parse(false);
+}
+
+std::string Json::toJson(const std::shared_ptr<Data> &data, bool pretty) {
+    JsonWriter writer(pretty);
+    writer.writeData(data);
+    return writer.getString();
+}
+
+
+#pragma - JsonWriter
+
+// shortest %g precision that reads back to the same value, with the decimal point fixed to '.'
+template <class T>
+static int formatShortest(char *buf, size_t size, T value, int minPrecision, int maxPrecision) {
+    int len = 0;
+    for (int precision = minPrecision; precision <= maxPrecision; precision++) {
+        len = snprintf(buf, size, "%.*g", precision, (double)value);
+        for (int i = 0; i < len; i++) {
+            if (buf[i] == ',') buf[i] = '.';
+        }
+        if ((T)strtod(buf, nullptr) == value) break;
+    }
+    // keeps integral values parsing back as Double rather than Long
+    bool integral = true;
+    for (int i = 0; i < len; i++) {
+        if (buf[i] == '.' || buf[i] == 'e') {
+            integral = false;
             break;
         }
-        i++;
     }
-    
-    if (hasColon) {
-        char *end;
-        double dValue = std::strtod(&json[startIdx], &end);
-        hasError = false;
-        return Double::create(dValue);
-        
+    if (integral && len + 2 < (int)size) {
+        buf[len++] = '.';
+        buf[len++] = '0';
+        buf[len] = '\0';
+    }
+    return len;
+}
+
+JsonWriter::JsonWriter(bool pretty, size_t capacity) {
+    this->pretty = pretty;
+    this->buffer.reserve(capacity);
+}
+
+void JsonWriter::beginValue() {
+    if (this->afterKey) {
+        this->afterKey = false;
+        return;
+    }
+    if (this->counts.empty()) return;
+    if (this->counts.back()++ > 0) {
+        this->buffer.push_back(',');
+    }
+    if (this->pretty) {
+        this->writeNewLine();
+    }
+}
+
+void JsonWriter::writeNewLine() {
+    this->buffer.push_back('\n');
+    this->buffer.append(this->counts.size() * 2, ' ');
+}
+
+void JsonWriter::startObject() {
+    this->beginValue();
+    this->buffer.push_back('{');
+    this->counts.emplace_back(0);
+}
+
+void JsonWriter::endObject() {
+    int count = this->counts.back();
+    this->counts.pop_back();
+    if (this->pretty && count > 0) {
+        this->writeNewLine();
+    }
+    this->buffer.push_back('}');
+}
+
+void JsonWriter::startArray() {
+    this->beginValue();
+    this->buffer.push_back('[');
+    this->counts.emplace_back(0);
+}
+
+void JsonWriter::endArray() {
+    int count = this->counts.back();
+    this->counts.pop_back();
+    if (this->pretty && count > 0) {
+        this->writeNewLine();
+    }
+    this->buffer.push_back(']');
+}
+
+void JsonWriter::writeKey(const char *key, size_t length) {
+    this->beginValue();
+    this->writeEscaped(key, length);
+    this->buffer.push_back(':');
+    if (this->pretty) {
+        this->buffer.push_back(' ');
+    }
+    this->afterKey = true;
+}
+
+void JsonWriter::writeKey(const std::string &key) {
+    this->writeKey(key.data(), key.size());
+}
+
+void JsonWriter::writeString(const char *value, size_t length) {
+    this->beginValue();
+    this->writeEscaped(value, length);
+}
+
+void JsonWriter::writeString(const std::string &value) {
+    this->writeString(value.data(), value.size());
+}
+
+void JsonWriter::writeLong(long long value) {
+    this->beginValue();
+    char buf[24];
+    char *p = buf + sizeof(buf);
+    unsigned long long v = (value < 0) ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        *--p = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    if (value < 0) {
+        *--p = '-';
+    }
+    this->buffer.append(p, buf + sizeof(buf) - p);
+}
+
+void JsonWriter::writeFloat(float value) {
+    if (!std::isfinite(value)) {
+        this->writeNull();
+        return;
+    }
+    this->beginValue();
+    char buf[32];
+    int len = formatShortest<float>(buf, sizeof(buf), value, 6, 9);
+    this->buffer.append(buf, len);
+}
+
+void JsonWriter::writeDouble(double value) {
+    if (!std::isfinite(value)) {
+        this->writeNull();
+        return;
+    }
+    this->beginValue();
+    char buf[40];
+    int len = formatShortest<double>(buf, sizeof(buf), value, 15, 17);
+    this->buffer.append(buf, len);
+}
+
+void JsonWriter::writeBool(bool value) {
+    this->beginValue();
+    if (value) {
+        this->buffer.append("true", 4);
     } else {
-        char *end;
-        long long lValue = std::strtoll(&json[startIdx], &end, 10);
-        hasError = false;
-        return Long::create(lValue);
+        this->buffer.append("false", 5);
     }
 }
 
-static void skipWhiteSpace(const char *json, int &i, int len) {
-    while (i < len) {
-        switch (json[i]) {
-            case ' ':
+void JsonWriter::writeNull() {
+    this->beginValue();
+    this->buffer.append("null", 4);
+}
+
+void JsonWriter::writeEscaped(const char *value, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+    this->buffer.push_back('"');
+    const char *p = value;
+    const char *end = value + length;
+    while (p < end) {
+        int n = simd::findJsonEscape(p, (int)(end - p));
+        this->buffer.append(p, n);
+        p += n;
+        if (p >= end) break;
+
+        unsigned char c = (unsigned char)*p++;
+        switch (c) {
+            case '"':
+                this->buffer.append("\\\"", 2);
+                break;
+            case '\\':
+                this->buffer.append("\\\\", 2);
+                break;
             case '\n':
+                this->buffer.append("\\n", 2);
+                break;
+            case '\r':
+                this->buffer.append("\\r", 2);
+                break;
             case '\t':
+                this->buffer.append("\\t", 2);
                 break;
-                
-            default:
-                return;
+            case '\b':
+                this->buffer.append("\\b", 2);
+                break;
+            case '\f':
+                this->buffer.append("\\f", 2);
+                break;
+            default: {
+                char u[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                this->buffer.append(u, 6);
+                break;
+            }
         }
-        i++;
     }
+    this->buffer.push_back('"');
+}
+
+void JsonWriter::writeData(const std::shared_ptr<Data> &data) {
+    if (!data) {
+        this->writeNull();
+        return;
+    }
+    switch (data->type) {
+        case DataType::Int:
+            this->writeLong(std::static_pointer_cast<Int>(data)->getValue());
+            break;
+
+        case DataType::Long:
+            this->writeLong(std::static_pointer_cast<Long>(data)->getValue());
+            break;
+
+        case DataType::Float:
+            this->writeFloat(std::static_pointer_cast<Float>(data)->getValue());
+            break;
+
+        case DataType::Double:
+            this->writeDouble(std::static_pointer_cast<Double>(data)->getValue());
+            break;
+
+        case DataType::Bool:
+            this->writeBool(std::static_pointer_cast<Bool>(data)->getValue());
+            break;
+
+        case DataType::String: {
+            auto str = std::static_pointer_cast<String>(data);
+            this->writeString(str->getValue());
+            break;
+        }
+
+        case DataType::ByteArray: {
+            auto bytes = std::static_pointer_cast<ByteArray>(data);
+            this->startArray();
+            for (int i = 0; i < (int)bytes->getLength(); i++) {
+                this->writeLong(bytes->getByte(i));
+            }
+            this->endArray();
+            break;
+        }
+
+        case DataType::Dictionary: {
+            auto dict = std::static_pointer_cast<Dictionary>(data);
+            this->startObject();
+            for (const auto &entry : dict->entries) {
+                this->writeKey(entry.key.str());
+                this->writeValue(entry.value);
+            }
+            this->endObject();
+            break;
+        }
+
+        case DataType::List: {
+            auto list = std::static_pointer_cast<List>(data);
+            this->startArray();
+            for (const auto &value : list->datum) {
+                this->writeValue(value);
+            }
+            this->endArray();
+            break;
+        }
+
+        case DataType::NativeObject:
+        case DataType::Void:
+            this->writeNull();
+            break;
+    }
+}
+
+const std::string &JsonWriter::getString() const {
+    return this->buffer;
+}
+
+void JsonWriter::writeValue(const DataValue &value) {
+    if (value.isBoxed()) {
+        this->writeData(value.value.data);
+        return;
+    }
+    switch (value.getType()) {
+        case DataType::Int:
+        case DataType::Long:
+            this->writeLong(value.getLong());
+            break;
+        case DataType::Float:
+            this->writeFloat(value.getFloat());
+            break;
+        case DataType::Double:
+            this->writeDouble(value.getDouble());
+            break;
+        case DataType::Bool:
+            this->writeBool(value.getBool());
+            break;
+        case DataType::String:
+            this->writeString(value.value.str, value.length);
+            break;
+        default:
+            this->writeNull();
+            break;
+    }
+}
+
+void JsonWriter::clear() {
+    this->buffer.clear();
+    this->counts.clear();
+    this->afterKey = false;
 }
@@ -5,10 +5,71 @@
 #include "mog/core/Data.h"
 
 namespace mog {
+    class JsonArena;
+
+    // return false from a callback to stop parsing.
+    // strings are not null terminated and only valid during the call.
+    class JsonHandler {
+    public:
+        virtual ~JsonHandler() {}
+        virtual bool onStartObject() { return true; }
+        virtual bool onKey(const char *key, size_t length) { return true; }
+        virtual bool onEndObject() { return true; }
+        virtual bool onStartArray() { return true; }
+        virtual bool onEndArray() { return true; }
+        virtual bool onString(const char *value, size_t length) { return true; }
+        virtual bool onLong(long long value) { return true; }
+        virtual bool onDouble(double value) { return true; }
+        virtual bool onBool(bool value) { return true; }
+        virtual bool onNull() { return true; }
+    };
+
+    class JsonWriter {
+    public:
+        JsonWriter(bool pretty = false, size_t capacity = 1024);
+
+        void startObject();
+        void endObject();
+        void startArray();
+        void endArray();
+        void writeKey(const char *key, size_t length);
+        void writeKey(const std::string &key);
+        void writeString(const char *value, size_t length);
+        void writeString(const std::string &value);
+        void writeLong(long long value);
+        void writeFloat(float value);
+        void writeDouble(double value);
+        void writeBool(bool value);
+        void writeNull();
+        void writeData(const std::shared_ptr<Data> &data);
+        void writeValue(const DataValue &value);
+
+        const std::string &getString() const;
+        void clear();
+
+    private:
+        std::string buffer;
+        std::vector<int> counts;
+        bool pretty = false;
+        bool afterKey = false;
+
+        void beginValue();
+        void writeNewLine();
+        void writeEscaped(const char *value, size_t length);
+    };
+
     class Json {
     public:
-        static std::shared_ptr<Dictionary> parse(std::string jsonText);
-        static std::string toJson(const std::shared_ptr<Dictionary> &dict);
+        static std::shared_ptr<Dictionary> parse(const std::string &jsonText);
+        static std::shared_ptr<Dictionary> parse(const char *json, size_t length);
+        static bool parse(const char *json, size_t length, JsonHandler &handler);
+        static std::string toJson(const std::shared_ptr<Data> &data, bool pretty = false);
+
+    private:
+        class DocumentBuilder;
+
+        template <class T, class... Args>
+        static std::shared_ptr<T> createInArena(JsonArena *arena, Args&&... args);
     };
 }
 
@@ -10,11 +10,13 @@ using namespace mog;
 #define MOG_STATS_DELTA 1
 #define MOG_STATS_DRAW_CALL 2
 #define MOG_STATS_INSTANTS 3
+#define MOG_STATS_SKIPPED 4
 #define MOG_STATS_ALPHA 150
 #define MOG_STATS_INTERVAL 0.2f
 
 int MogStats::drawCallCount = 0;
 int MogStats::instanceCount = 0;
+int MogStats::skippedFrameCount = 0;
 
 std::shared_ptr<MogStats> MogStats::create(bool enable) {
     auto stats = std::shared_ptr<MogStats>(new MogStats());
@@ -162,11 +164,14 @@ void MogStats::init() {
     auto drawCall = this->createLabelTexture("0");
     auto instantsLabel = this->createLabelTexture("INSTANTS  :");
     auto instants = this->createLabelTexture("0");
+    auto skippedLabel = this->createLabelTexture("SKIPPED   :");
+    auto skipped = this->createLabelTexture("0");
 
     this->width = fps->width + separator->width + delta->width + xMargin * 2 + padding * 2;
     this->height = fmax(fps->height, delta->height) +
         fmax(drawCallLabel->height, drawCall->height) +
-        fmax(instantsLabel->height, instants->height) + padding * 2;
+        fmax(instantsLabel->height, instants->height) +
+        fmax(skippedLabel->height, skipped->height) + padding * 2;
     this->data = (unsigned char *)mogcalloc(this->width * this->height * 4, sizeof(unsigned char));
     for (int i = 0; i < this->width * this->height; i++) {
         this->data[i * 4 + 3] = MOG_STATS_ALPHA;
@@ -195,6 +200,13 @@ void MogStats::init() {
     this->setTextToData(instants, x, y);
     this->positions[MOG_STATS_INSTANTS] = std::pair<int, int>(x, y);
 
+    x = startX;
+    y += instantsLabel->height + yMargin;
+    this->setTextToData(skippedLabel, x, y);
+    x += skippedLabel->width + xMargin;
+    this->setTextToData(skipped, x, y);
+    this->positions[MOG_STATS_SKIPPED] = std::pair<int, int>(x, y);
+
     this->bindVertex();
     this->initialized = true;
     this->setAlignment(this->alignment);
@@ -282,4 +294,6 @@ void MogStats::updateValues(float delta) {
     this->setNumberToData(delta, 2, 4, this->positions[MOG_STATS_DELTA].first, this->positions[MOG_STATS_DELTA].second);
     this->setNumberToData(drawCallCount, 3, 0, this->positions[MOG_STATS_DRAW_CALL].first, this->positions[MOG_STATS_DRAW_CALL].second);
     this->setNumberToData((instanceCount), 3, 0, this->positions[MOG_STATS_INSTANTS].first, this->positions[MOG_STATS_INSTANTS].second);
+    this->setNumberToData(fmin(skippedFrameCount, 999), 3, 0, this->positions[MOG_STATS_SKIPPED].first, this->positions[MOG_STATS_SKIPPED].second);
+    skippedFrameCount = 0;
 }
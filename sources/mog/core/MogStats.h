@@ -15,6 +15,7 @@ namespace mog {
     public:
         static int drawCallCount;
         static int instanceCount;
+        static int skippedFrameCount;
 
         static std::shared_ptr<MogStats> create(bool enable);
         void drawFrame(float delta, unsigned char parentDirtyFlag = 0);
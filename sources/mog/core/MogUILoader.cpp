@@ -101,21 +101,23 @@ std::shared_ptr<Group> MogUILoader::load(std::string filename, const std::vector
 }
 
 std::string MogUILoader::toJsonString(const std::shared_ptr<Dictionary> &dict) {
-    std::string jsonStr;
-    jsonStr.reserve(1024);
-    dictToGroupJsonString(dict, jsonStr);
-    return jsonStr;
+    JsonWriter writer;
+    dictToGroupJsonString(dict, writer);
+    return writer.getString();
 }
 
-void MogUILoader::dictToGroupJsonString(const std::shared_ptr<Dictionary> &dict, std::string &jsonStr) {
+void MogUILoader::dictToGroupJsonString(const std::shared_ptr<Dictionary> &dict, JsonWriter &writer) {
     auto groupEntityType = (EntityType)dict->get<Int>("entityType")->getValue();
     auto groupEntityTypeStr = entityTypeMap[(int)groupEntityType];
     auto groupName = dict->get<String>("name")->getValue();
 
-    jsonStr.append("{");
-    jsonStr.append("\"name\":\"").append(groupName).append("\",");
-    jsonStr.append("\"entityType\":\"").append(groupEntityTypeStr).append("\",");
-    jsonStr.append("\"childEntities\":[");
+    writer.startObject();
+    writer.writeKey("name");
+    writer.writeString(groupName);
+    writer.writeKey("entityType");
+    writer.writeString(groupEntityTypeStr);
+    writer.writeKey("childEntities");
+    writer.startArray();
 
     auto childEntityList = dict->get<List>("childEntities");
     int len = childEntityList->size();
@@ -124,22 +126,21 @@ void MogUILoader::dictToGroupJsonString(const std::shared_ptr<Dictionary> &dict,
         auto entityType = (EntityType)entityDict->get<Int>("entityType")->getValue();
         
         if (isGroupType(entityType)) {
-            dictToGroupJsonString(entityDict, jsonStr);
+            dictToGroupJsonString(entityDict, writer);
             
         } else {
             auto entityTypeStr = entityTypeMap[(int)entityType];
             auto name = entityDict->get<String>("name")->getValue();
             
-            jsonStr.append("{");
-            jsonStr.append("\"name\":\"").append(name).append("\",");
-            jsonStr.append("\"entityType\":\"").append(entityTypeStr).append("\"");
-            jsonStr.append("}");
-        }
-        
-        if (i < len - 1) {
-            jsonStr.append(",");
+            writer.startObject();
+            writer.writeKey("name");
+            writer.writeString(name);
+            writer.writeKey("entityType");
+            writer.writeString(entityTypeStr);
+            writer.endObject();
         }
     }
     
-    jsonStr.append("]}");
+    writer.endArray();
+    writer.endObject();
 }
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include "mog/core/Data.h"
+#include "mog/core/Json.h"
 #include "mog/base/Group.h"
 
 extern void *enabler;
@@ -43,7 +44,7 @@ namespace mog {
         static std::string toJsonString(const std::shared_ptr<Dictionary> &dict);
         
     private:
-        static void dictToGroupJsonString(const std::shared_ptr<Dictionary> &dict, std::string &jsonStr);
+        static void dictToGroupJsonString(const std::shared_ptr<Dictionary> &dict, JsonWriter &writer);
         
         template<class First, class... Rest, typename std::enable_if<std::is_same<Param, First>::value>::type*& = enabler>
         static void addParam(std::vector<Param> &params, const First &first, const Rest&... rest) {
@@ -58,6 +58,7 @@ namespace mog {
     
     class NativeObject : public Data {
     public:
+        static constexpr DataType dataType = DataType::NativeObject;
         static std::shared_ptr<NativeObject> create(void *value);
         static std::shared_ptr<NativeObject> create(const std::shared_ptr<Dictionary> &dict);
         static std::shared_ptr<NativeObject> create(const std::shared_ptr<List> &list);
@@ -16,13 +16,14 @@ PubSub::~PubSub() {
     }
 }
 
-void PubSub::publish(std::string key) {
+void PubSub::publish(const Symbol &key) {
     this->publish(key, nullptr);
 }
 
-void PubSub::publish(std::string key, const std::shared_ptr<Data> &param) {
-    if (this->subscribers.count(key) > 0) {
-        for (auto &sub : this->subscribers[key]) {
+void PubSub::publish(const Symbol &key, const std::shared_ptr<Data> &param) {
+    auto it = this->subscribers.find(key);
+    if (it != this->subscribers.end()) {
+        for (auto &sub : it->second) {
             sub.second(param);
         }
     }
@@ -33,17 +34,17 @@ void PubSub::publish(std::string key, const std::shared_ptr<Data> &param) {
     }
 }
 
-unsigned int PubSub::subscribe(std::string key, std::function<void(const std::shared_ptr<Data> &p)> func) {
+unsigned int PubSub::subscribe(const Symbol &key, std::function<void(const std::shared_ptr<Data> &p)> func) {
     unsigned int pubsubId = ++this->subscribeIdCounter;
     this->subscribers[key][pubsubId] = func;
     return pubsubId;
 }
 
-void PubSub::unsubscribe(std::string key, unsigned int subscribeId) {
+void PubSub::unsubscribe(const Symbol &key, unsigned int subscribeId) {
     this->subscribers[key].erase(subscribeId);
 }
 
-void PubSub::unsubscribeAll(std::string key) {
+void PubSub::unsubscribeAll(const Symbol &key) {
     this->subscribers.erase(key);
 }
 
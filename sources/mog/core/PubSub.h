@@ -8,16 +8,17 @@
 #include <vector>
 #include <memory>
 #include "mog/core/Data.h"
+#include "mog/core/Symbol.h"
 
 namespace mog {
     class PubSub : public std::enable_shared_from_this<PubSub> {
     public:
-        void publish(std::string key);
-        void publish(std::string key, const std::shared_ptr<Data> &param);
+        void publish(const Symbol &key);
+        void publish(const Symbol &key, const std::shared_ptr<Data> &param);
         
-        unsigned int subscribe(std::string key, std::function<void(const std::shared_ptr<Data> &p)> func);
-        void unsubscribe(std::string key, unsigned int subscribeId);
-        void unsubscribeAll(std::string key);
+        unsigned int subscribe(const Symbol &key, std::function<void(const std::shared_ptr<Data> &p)> func);
+        void unsubscribe(const Symbol &key, unsigned int subscribeId);
+        void unsubscribeAll(const Symbol &key);
         
         void propagate(const std::weak_ptr<PubSub> childPubsub);
         void stopPropagete(const std::weak_ptr<PubSub> childPubsub);
@@ -30,7 +31,7 @@ namespace mog {
         static unsigned int pubsubInstanceId;
         unsigned int subscribeIdCounter = 0;
         
-        std::map<std::string, std::map<unsigned int, std::function<void(const std::shared_ptr<Data> &p)>>> subscribers;
+        std::unordered_map<Symbol, std::map<unsigned int, std::function<void(const std::shared_ptr<Data> &p)>>> subscribers;
         std::map<unsigned int, std::weak_ptr<PubSub>> childPubsubs;
         std::map<unsigned int, std::weak_ptr<PubSub>> parentPubsubs;
     };
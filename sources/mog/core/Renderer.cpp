@@ -3,6 +3,7 @@
 #include "mog/core/MogStats.h"
 #include <math.h>
 #include <string.h>
+#include <stddef.h>
 
 using namespace mog;
 
@@ -17,6 +18,35 @@ static void checkGLError(const char *label) {
 #define checkGLError(label)
 #endif
 
+static const Symbol U_SCREEN_SIZE("u_screenSize");
+static const Symbol U_DISPLAY_SIZE("u_displaySize");
+static const Symbol U_SCREEN_SCALE("u_screenScale");
+static const Symbol A_POSITION("a_position");
+static const Symbol A_COLOR("a_color");
+static const Symbol A_TRANSFORM("a_transform");
+static const Symbol A_TRANSLATE("a_translate");
+static const Symbol A_UV_RECT("a_uvRect");
+
+static std::array<Symbol, MULTI_TEXTURE_NUM> createIndexedSymbols(const char *prefix) {
+    std::array<Symbol, MULTI_TEXTURE_NUM> symbols;
+    char str[32];
+    for (int i = 0; i < MULTI_TEXTURE_NUM; i++) {
+        snprintf(str, sizeof(str), "%s%d", prefix, i);
+        symbols[i] = Symbol(str);
+    }
+    return symbols;
+}
+
+static const Symbol &getUVAttributeName(int textureIdx) {
+    static const std::array<Symbol, MULTI_TEXTURE_NUM> names = createIndexedSymbols("a_uv");
+    return names[textureIdx];
+}
+
+static const Symbol &getTextureUniformName(int textureIdx) {
+    static const std::array<Symbol, MULTI_TEXTURE_NUM> names = createIndexedSymbols("u_texture");
+    return names[textureIdx];
+}
+
 float Renderer::identityMatrix[20] = {
     1, 0, 0, 0,
     0, 1, 0, 0,
@@ -26,6 +56,8 @@ float Renderer::identityMatrix[20] = {
 };
 
 std::unordered_map<intptr_t, std::weak_ptr<Renderer>> Renderer::allRenderers;
+int Renderer::instancingSupported = -1;
+bool Renderer::premultipliedTarget = false;
 
 void Renderer::releaseAllBufferes() {
     for (auto &pair : allRenderers) {
@@ -33,6 +65,30 @@ void Renderer::releaseAllBufferes() {
             renderer->releaseBuffer();
         }
     }
+    Renderer::instancingSupported = -1;
+}
+
+bool Renderer::isInstancingSupported() {
+#ifdef MOG_GL_INSTANCING
+    if (Renderer::instancingSupported < 0) {
+        const char *version = (const char *)glGetString(GL_VERSION);
+        const char *extensions = (const char *)glGetString(GL_EXTENSIONS);
+        bool supported = false;
+#ifdef MOG_GL_INSTANCING_LOADER
+        supported = glLoadInstancingMOG(version, extensions);
+#else
+        if (version && strstr(version, "OpenGL ES 3")) {
+            supported = true;
+        } else if (extensions && (strstr(extensions, "GL_ARB_instanced_arrays") || strstr(extensions, "GL_ANGLE_instanced_arrays"))) {
+            supported = true;
+        }
+#endif
+        Renderer::instancingSupported = supported ? 1 : 0;
+    }
+    return (Renderer::instancingSupported == 1);
+#else
+    return false;
+#endif
 }
 
 std::shared_ptr<Renderer> Renderer::create() {
@@ -54,6 +110,7 @@ Renderer::~Renderer() {
     mogfree(this->vertices);
     mogfree(this->indices);
     mogfree(this->vertexColors);
+    mogfree(this->instances);
     for (int i = 0; i < MULTI_TEXTURE_NUM; i++ ) {
         if (this->vertexTexCoords[i]) mogfree(this->vertexTexCoords[i]);
     }
@@ -70,9 +127,9 @@ void Renderer::initScreenParameters() {
     auto screenSize = Screen::getSize();
     auto displaySize = Screen::getDisplaySize();
     float screenScale = Screen::getScreenScale();
-    this->shader->setUniformParameter("u_screenSize", screenSize.width, screenSize.height);
-    this->shader->setUniformParameter("u_displaySize", displaySize.width, displaySize.height);
-    this->shader->setUniformParameter("u_screenScale", screenScale);
+    this->shader->setUniformParameter(U_SCREEN_SIZE, screenSize.width, screenSize.height);
+    this->shader->setUniformParameter(U_DISPLAY_SIZE, displaySize.width, displaySize.height);
+    this->shader->setUniformParameter(U_SCREEN_SCALE, screenScale);
     this->screenParameterInitialized = true;
 }
 
@@ -93,31 +150,42 @@ void Renderer::bindVertex(bool dynamicDraw) {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     
-    this->shader->bindAttributeLocation("a_position", ATTR_LOCATION_IDX_POSITION);
+    this->shader->bindAttributeLocation(A_POSITION, ATTR_LOCATION_IDX_POSITION);
 
     checkGLError("Renderer::bindVertex");
 }
 
 void Renderer::bindVertexTexCoords(int textureIdx, bool dynamicDraw) {
-    char uvStr[8];
-    sprintf(uvStr, "a_uv%d", textureIdx);
-    this->shader->bindAttributeLocation(uvStr, ATTR_LOCATION_IDX_UV_START + textureIdx);
+    this->shader->bindAttributeLocation(getUVAttributeName(textureIdx), ATTR_LOCATION_IDX_UV_START + textureIdx);
     this->shader->bindVertexAttributeParameter(ATTR_LOCATION_IDX_UV_START + textureIdx, this->vertexTexCoords[textureIdx], this->verticesNum * 2, 2, dynamicDraw);
     checkGLError("Renderer::bindTextureVertex");
 }
 
 void Renderer::bindVertexColors(bool dynamicDraw) {
-    this->shader->bindAttributeLocation("a_color", ATTR_LOCATION_IDX_COLOR);
+    this->shader->bindAttributeLocation(A_COLOR, ATTR_LOCATION_IDX_COLOR);
     this->shader->bindVertexAttributeParameter(ATTR_LOCATION_IDX_COLOR, this->vertexColors, this->verticesNum * 4, 4, dynamicDraw);
     this->enableVertexColor = true;
     checkGLError("Renderer::bindColorsVertex");
 }
 
-void Renderer::bindTexture(const std::shared_ptr<Texture2D> &texture, int textureIdx) {
-    char texStr[16];
-    sprintf(texStr, "u_texture%d", textureIdx);
+void Renderer::bindInstances(bool dynamicDraw) {
+    if (this->instanceBuffer == 0) {
+        glGenBuffers(1, &this->instanceBuffer);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, this->instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(InstanceAttribute) * this->instancesNum, this->instances, (dynamicDraw ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    this->shader->bindAttributeLocation(A_COLOR, ATTR_LOCATION_IDX_INSTANCE_COLOR);
+    this->shader->bindAttributeLocation(A_TRANSFORM, ATTR_LOCATION_IDX_INSTANCE_TRANSFORM);
+    this->shader->bindAttributeLocation(A_TRANSLATE, ATTR_LOCATION_IDX_INSTANCE_TRANSLATE);
+    this->shader->bindAttributeLocation(A_UV_RECT, ATTR_LOCATION_IDX_INSTANCE_UV_RECT);
     
-    this->shader->setUniformParameter(texStr, textureIdx);
+    checkGLError("Renderer::bindInstances");
+}
+
+void Renderer::bindTexture(const std::shared_ptr<Texture2D> &texture, int textureIdx) {
+    this->shader->setUniformParameter(getTextureUniformName(textureIdx), textureIdx);
     this->textures[textureIdx] = texture;
     
     checkGLError("Renderer::bindTexture");
@@ -143,6 +211,14 @@ void Renderer::bindVertexColorsSub(int index, int size) {
     checkGLError("Renderer::bindColorsVertexSub");
 }
 
+void Renderer::bindInstancesSub(int index, int size) {
+    glBindBuffer(GL_ARRAY_BUFFER, this->instanceBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, sizeof(InstanceAttribute) * index, sizeof(InstanceAttribute) * size, &this->instances[index]);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    checkGLError("Renderer::bindInstancesSub");
+}
+
 bool Renderer::setVerticesNum(int verticesNum) {
     if (this->verticesNum == verticesNum) return false;
     this->verticesNum = verticesNum;
@@ -155,6 +231,17 @@ bool Renderer::setIndicesNum(int indicesNum) {
     return true;
 }
 
+bool Renderer::setInstancesNum(int instancesNum) {
+    if (this->instancesNum == instancesNum) return false;
+    if ((this->instancesNum == 0) != (instancesNum == 0) && this->defaultShaderAttached) {
+        this->shader->attachVertexShader(nullptr);
+        this->shader->attachFragmentShader(nullptr);
+        this->defaultShaderAttached = false;
+    }
+    this->instancesNum = instancesNum;
+    return true;
+}
+
 void Renderer::newVerticesArr() {
     this->vertices = (float *)mogrealloc(this->vertices, sizeof(float) * this->verticesNum * 2);
 }
@@ -172,16 +259,26 @@ void Renderer::newVertexTexCoordsArr(int textureIdx) {
     this->vertexTexCoords[textureIdx] = (float *)mogrealloc(this->vertexTexCoords[textureIdx], sizeof(float) * this->verticesNum * 2);
 }
 
+void Renderer::newInstancesArr() {
+    this->instances = (InstanceAttribute *)mogrealloc(this->instances, sizeof(InstanceAttribute) * this->instancesNum);
+}
+
 void Renderer::drawFrame() {
     if (this->shader->vertexShader == nullptr) {
         this->shader->vertexShader = this->getDefaultShader(ShaderType::VertexShader);
+        this->defaultShaderAttached = true;
     }
     if (this->shader->fragmentShader == nullptr) {
         this->shader->fragmentShader = this->getDefaultShader(ShaderType::FragmentShader);
+        this->defaultShaderAttached = true;
     }
     this->shader->compileIfNeed();
     
-    glBlendFunc((GLenum)this->blendingFactorSrc, (GLenum)this->blendingFactorDest);
+    if (Renderer::premultipliedTarget) {
+        glBlendFuncSeparate((GLenum)this->blendingFactorSrc, (GLenum)this->blendingFactorDest, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        glBlendFunc((GLenum)this->blendingFactorSrc, (GLenum)this->blendingFactorDest);
+    }
     glUseProgram(this->shader->glShaderProgram);
     
     glEnableVertexAttribArray(ATTR_LOCATION_IDX_POSITION);
@@ -202,7 +299,11 @@ void Renderer::drawFrame() {
     this->shader->setParameters();
 
     // draw
-    glDrawElements((int)this->drawType, this->indicesNum, GL_UNSIGNED_SHORT, 0);
+    if (this->instancesNum > 0) {
+        this->drawInstances();
+    } else {
+        glDrawElements((int)this->drawType, this->indicesNum, GL_UNSIGNED_SHORT, 0);
+    }
     
     MogStats::drawCallCount++;
 
@@ -214,7 +315,40 @@ void Renderer::drawFrame() {
     checkGLError("Renderer::drawFrame");
 }
 
+void Renderer::drawInstances() {
+#ifdef MOG_GL_INSTANCING
+    GLsizei stride = sizeof(InstanceAttribute);
+    GLuint locations[4] = {
+        ATTR_LOCATION_IDX_INSTANCE_TRANSFORM,
+        ATTR_LOCATION_IDX_INSTANCE_TRANSLATE,
+        ATTR_LOCATION_IDX_INSTANCE_UV_RECT,
+        ATTR_LOCATION_IDX_INSTANCE_COLOR,
+    };
+    
+    glBindBuffer(GL_ARRAY_BUFFER, this->instanceBuffer);
+    glVertexAttribPointer(ATTR_LOCATION_IDX_INSTANCE_TRANSFORM, 4, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(InstanceAttribute, transform));
+    glVertexAttribPointer(ATTR_LOCATION_IDX_INSTANCE_TRANSLATE, 2, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(InstanceAttribute, translate));
+    glVertexAttribPointer(ATTR_LOCATION_IDX_INSTANCE_UV_RECT, 4, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(InstanceAttribute, uvRect));
+    glVertexAttribPointer(ATTR_LOCATION_IDX_INSTANCE_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void *)offsetof(InstanceAttribute, color));
+    for (int i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(locations[i]);
+        glVertexAttribDivisorMOG(locations[i], 1);
+    }
+    
+    glDrawElementsInstancedMOG((int)this->drawType, this->indicesNum, GL_UNSIGNED_SHORT, 0, this->instancesNum);
+    
+    for (int i = 0; i < 4; i++) {
+        glVertexAttribDivisorMOG(locations[i], 0);
+        glDisableVertexAttribArray(locations[i]);
+    }
+#endif
+    checkGLError("Renderer::drawInstances");
+}
+
 std::shared_ptr<ShaderUnit> Renderer::getDefaultShader(ShaderType shaderType) {
+    if (this->instancesNum > 0) {
+        return BasicShader::getShaderUnit(BasicShader::Type::Instanced, shaderType);
+    }
     bool hasTexture = false;
     if (auto texture = this->textures[0].lock()) {
         hasTexture = (texture->textureId > 0);
@@ -242,6 +376,10 @@ void Renderer::releaseBuffer() {
         this->vertexBuffer[0] = 0;
         this->vertexBuffer[1] = 0;
     }
+    if (this->instanceBuffer > 0) {
+        glDeleteBuffers(1, &this->instanceBuffer);
+        this->instanceBuffer = 0;
+    }
     if (this->shader) {
         this->shader->releaseBuffer();
     }
@@ -16,6 +16,11 @@
 #define VBO_TEXTURES 2
 #define VBO_COLORS 3
 
+#define ATTR_LOCATION_IDX_INSTANCE_COLOR ATTR_LOCATION_IDX_COLOR
+#define ATTR_LOCATION_IDX_INSTANCE_TRANSFORM 2
+#define ATTR_LOCATION_IDX_INSTANCE_TRANSLATE 3
+#define ATTR_LOCATION_IDX_INSTANCE_UV_RECT 4
+
 namespace mog {
     class Engine;
     
@@ -47,6 +52,13 @@ namespace mog {
         SrcAlphaSaturate        = GL_SRC_ALPHA_SATURATE,
     };
 
+    struct InstanceAttribute {
+        float transform[4];
+        float translate[2];
+        float uvRect[4];
+        unsigned char color[4];
+    };
+
     
     class Renderer {
     public:
@@ -54,6 +66,9 @@ namespace mog {
         
         static void releaseAllBufferes();
         static std::shared_ptr<Renderer> create();
+        static bool isInstancingSupported();
+        // set while drawing into an offscreen texture, whose alpha is accumulated as premultiplied alpha
+        static bool premultipliedTarget;
 
         unsigned long long rendererId = 0;
         std::array<std::weak_ptr<Texture2D>, MULTI_TEXTURE_NUM> textures;
@@ -63,6 +78,8 @@ namespace mog {
         short *indices = nullptr;
         float *vertexColors = nullptr;
         float *vertexTexCoords[MULTI_TEXTURE_NUM];
+        int instancesNum = 0;
+        InstanceAttribute *instances = nullptr;
         float matrix[20] = {
             1, 0, 0, 0,
             0, 1, 0, 0,
@@ -81,26 +98,32 @@ namespace mog {
         void bindVertex(bool dynamicDraw = false);
         void bindVertexTexCoords(int textureIdx = 0, bool dynamicDraw = false);
         void bindVertexColors(bool dynamicDraw = false);
+        void bindInstances(bool dynamicDraw = false);
         void bindTexture(const std::shared_ptr<Texture2D> &texture, int textureIdx = 0);
 
         void bindVertexSub(int index, int size);
         void bindVertexTexCoordsSub(int index, int size, int textureIdx = 0);
         void bindVertexColorsSub(int index, int size);
+        void bindInstancesSub(int index, int size);
 
         bool setVerticesNum(int verticesNum);
         bool setIndicesNum(int indicesNum);
+        bool setInstancesNum(int instancesNum);
         void newVerticesArr();
         void newIndicesArr();
         void newVertexColorsArr();
         void newVertexTexCoordsArr(int textureIdx = 0);
+        void newInstancesArr();
         std::shared_ptr<Shader> getShader();
 
         void drawFrame();
         
     private:
         static std::unordered_map<intptr_t, std::weak_ptr<Renderer>> allRenderers;
+        static int instancingSupported;
 
         GLuint vertexBuffer[2] = {0, 0};
+        GLuint instanceBuffer = 0;
 
         Renderer();
 
@@ -113,6 +136,7 @@ namespace mog {
         std::shared_ptr<Shader> shader = nullptr;
         bool screenParameterInitialized = false;
         bool enableVertexColor = false;
+        bool defaultShaderAttached = false;
 
         DrawType drawType = DrawType::TrinangleStrip;
         BlendingFactor blendingFactorSrc = BlendingFactor::SrcAlpha;
@@ -125,6 +149,7 @@ namespace mog {
          */
         std::shared_ptr<ShaderUnit> getDefaultShader(ShaderType shaderType);
         void releaseBuffer();
+        void drawInstances();
     };
 }
 
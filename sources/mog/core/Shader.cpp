@@ -181,64 +181,64 @@ void Shader::setUniformColor(float r, float g, float b, float a) {
     this->setUniformParameter("u_color", r, g, b, a);
 }
 
-void Shader::setUniformParameter(std::string name, const UniformParameter &param) {
+void Shader::setUniformParameter(const Symbol &name, const UniformParameter &param) {
     this->uniformParamsMap[name] = param;
     this->dirtyUniformParamsMap[name] = true;
 }
 
-void Shader::setUniformParameter(std::string name, float f1) {
+void Shader::setUniformParameter(const Symbol &name, float f1) {
     this->setUniformParameter(name, UniformParameter(f1));
 }
 
-void Shader::setUniformParameter(std::string name, float f1, float f2) {
+void Shader::setUniformParameter(const Symbol &name, float f1, float f2) {
     this->setUniformParameter(name, UniformParameter(f1, f2));
 }
 
-void Shader::setUniformParameter(std::string name, float f1, float f2, float f3) {
+void Shader::setUniformParameter(const Symbol &name, float f1, float f2, float f3) {
     this->setUniformParameter(name, UniformParameter(f1, f2, f3));
 }
 
-void Shader::setUniformParameter(std::string name, float f1, float f2, float f3, float f4) {
+void Shader::setUniformParameter(const Symbol &name, float f1, float f2, float f3, float f4) {
     this->setUniformParameter(name, UniformParameter(f1, f2, f3, f4));
 }
 
-void Shader::setUniformParameter(std::string name, int i1) {
+void Shader::setUniformParameter(const Symbol &name, int i1) {
     this->setUniformParameter(name, UniformParameter(i1));
 }
 
-void Shader::setUniformParameter(std::string name, int i1, int i2) {
+void Shader::setUniformParameter(const Symbol &name, int i1, int i2) {
     this->setUniformParameter(name, UniformParameter(i1, i2));
 }
 
-void Shader::setUniformParameter(std::string name, int i1, int i2, int i3) {
+void Shader::setUniformParameter(const Symbol &name, int i1, int i2, int i3) {
     this->setUniformParameter(name, UniformParameter(i1, i2, i3));
 }
 
-void Shader::setUniformParameter(std::string name, int i1, int i2, int i3, int i4) {
+void Shader::setUniformParameter(const Symbol &name, int i1, int i2, int i3, int i4) {
     this->setUniformParameter(name, UniformParameter(i1, i2, i3, i4));
 }
 
-void Shader::setUniformParameter(std::string name, const float *matrix, int size) {
+void Shader::setUniformParameter(const Symbol &name, const float *matrix, int size) {
     this->setUniformParameter(name, UniformParameter(matrix, size));
 }
 
-void Shader::setVertexAttributeParameter(std::string name, float f1) {
+void Shader::setVertexAttributeParameter(const Symbol &name, float f1) {
     this->setVertexAttributeParameter(name, VertexAttributeParameter(f1));
 }
 
-void Shader::setVertexAttributeParameter(std::string name, float f1, float f2) {
+void Shader::setVertexAttributeParameter(const Symbol &name, float f1, float f2) {
     this->setVertexAttributeParameter(name, VertexAttributeParameter(f1, f2));
 }
 
-void Shader::setVertexAttributeParameter(std::string name, float f1, float f2, float f3) {
+void Shader::setVertexAttributeParameter(const Symbol &name, float f1, float f2, float f3) {
     this->setVertexAttributeParameter(name, VertexAttributeParameter(f1, f2, f3));
 }
 
-void Shader::setVertexAttributeParameter(std::string name, float f1, float f2, float f3, float f4) {
+void Shader::setVertexAttributeParameter(const Symbol &name, float f1, float f2, float f3, float f4) {
     this->setVertexAttributeParameter(name, VertexAttributeParameter(f1, f2, f3, f4));
 }
 
-void Shader::setVertexAttributeParameter(std::string name, float *values, int arrLength, int size, bool dynamicDraw, bool normalized, int stride) {
+void Shader::setVertexAttributeParameter(const Symbol &name, float *values, int arrLength, int size, bool dynamicDraw, bool normalized, int stride) {
 //    int index = this->getBufferIndex(location);
     
     /*
@@ -251,7 +251,7 @@ void Shader::setVertexAttributeParameter(std::string name, float *values, int ar
     this->setVertexAttributeParameter(name, VertexAttributeParameter(GL_FLOAT, values, sizeof(float) * arrLength, size, dynamicDraw, normalized, stride));
 }
 
-void Shader::setVertexAttributeParameter(std::string name, int *values, int arrLength, int size, bool dynamicDraw, bool normalized, int stride) {
+void Shader::setVertexAttributeParameter(const Symbol &name, int *values, int arrLength, int size, bool dynamicDraw, bool normalized, int stride) {
 //    int index = this->getBufferIndex(location);
 
     /*
@@ -264,7 +264,7 @@ void Shader::setVertexAttributeParameter(std::string name, int *values, int arrL
     this->setVertexAttributeParameter(name, VertexAttributeParameter(GL_INT, values, sizeof(int) * arrLength, size, dynamicDraw, normalized, stride));
 }
 
-void Shader::setVertexAttributeParameter(std::string name, short *values, int arrLength, int size, bool dynamicDraw, bool normalized, int stride) {
+void Shader::setVertexAttributeParameter(const Symbol &name, short *values, int arrLength, int size, bool dynamicDraw, bool normalized, int stride) {
 //    int index = this->getBufferIndex(location);
     
     /*
@@ -277,7 +277,7 @@ void Shader::setVertexAttributeParameter(std::string name, short *values, int ar
     this->setVertexAttributeParameter(name, VertexAttributeParameter(GL_SHORT, values, sizeof(short) * arrLength, size, dynamicDraw, normalized, stride));
 }
 
-void Shader::setVertexAttributeParameter(std::string name, const VertexAttributeParameter &param) {
+void Shader::setVertexAttributeParameter(const Symbol &name, const VertexAttributeParameter &param) {
     unsigned int location = this->bindAttributeLocation(name);
     this->vertexAttributeParamsMap[location] = param;
 }
@@ -302,14 +302,17 @@ void Shader::bindVertexAttributePointerSub(unsigned int location, float *value,
     checkGLError("Shader::bindVertexAttributePointerSub");
 }
 
-unsigned int Shader::bindAttributeLocation(std::string name) {
-    if (this->attributeLocationMap.count(name) == 0) {
-        this->attributeLocationMap[name] = this->attributeLocationIndexCounter++;
+unsigned int Shader::bindAttributeLocation(const Symbol &name) {
+    auto it = this->attributeLocationMap.find(name);
+    if (it != this->attributeLocationMap.end()) {
+        return it->second;
     }
-    return this->attributeLocationMap[name];
+    unsigned int location = this->attributeLocationIndexCounter++;
+    this->attributeLocationMap[name] = location;
+    return location;
 }
 
-void Shader::bindAttributeLocation(std::string name, unsigned int location) {
+void Shader::bindAttributeLocation(const Symbol &name, unsigned int location) {
     this->attributeLocationMap[name] = location;
 }
 
@@ -409,7 +412,7 @@ Shader::UniformParameter::UniformParameter(const float *matrix, int size) {
     }
 }
 
-void Shader::UniformParameter::setUniform(GLuint program, std::string name) {
+void Shader::UniformParameter::setUniform(GLuint program, const Symbol &name) {
     GLint location = glGetUniformLocation(program, name.c_str());
     switch (this->type) {
         case Type::Float1:
@@ -614,6 +617,9 @@ std::shared_ptr<ShaderUnit> BasicShader::getShaderUnit(Type type, ShaderType sha
                 case Type::PointSprite:
                     vertexShaderCache[(int)type] = ShaderUnit::create(pointSprite_vertexShaderSource, ShaderType::VertexShader);
                     break;
+                case Type::Instanced:
+                    vertexShaderCache[(int)type] = ShaderUnit::create(instanced_vertexShaderSource, ShaderType::VertexShader);
+                    break;
             }
         }
         return vertexShaderCache[(int)type];
@@ -636,6 +642,9 @@ std::shared_ptr<ShaderUnit> BasicShader::getShaderUnit(Type type, ShaderType sha
                 case Type::PointSprite:
                     fragmentShaderCache[(int)type] = BasicShader::getShaderUnit(Type::SolidColor, ShaderType::FragmentShader);
                     break;
+                case Type::Instanced:
+                    fragmentShaderCache[(int)type] = BasicShader::getShaderUnit(Type::VertexColorWithTexture, ShaderType::FragmentShader);
+                    break;
             }
         }
         return fragmentShaderCache[(int)type];
@@ -5,6 +5,7 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include "mog/core/Symbol.h"
 
 #define ATTR_LOCATION_IDX_POSITION 0
 #define ATTR_LOCATION_IDX_COLOR 1
@@ -88,7 +89,7 @@ namespace mog {
             
             UniformParameter(const float *matrix, int size = 4);
             
-            void setUniform(GLuint program, std::string name);
+            void setUniform(GLuint program, const Symbol &name);
         };
         
         
@@ -154,29 +155,29 @@ namespace mog {
         void setUniformMatrix(const float *matrix);
         void setUniformColor(float r, float g, float b, float a);
         
-        void setUniformParameter(std::string name, float f1);
-        void setUniformParameter(std::string name, float f1, float f2);
-        void setUniformParameter(std::string name, float f1, float f2, float f3);
-        void setUniformParameter(std::string name, float f1, float f2, float f3, float f4);
-        void setUniformParameter(std::string name, int i1);
-        void setUniformParameter(std::string name, int i1, int i2);
-        void setUniformParameter(std::string name, int i1, int i2, int i3);
-        void setUniformParameter(std::string name, int i1, int i2, int i3, int i4);
-        void setUniformParameter(std::string name, const float *matrix, int size = 4);
-        
-        void setVertexAttributeParameter(std::string name, float f1);
-        void setVertexAttributeParameter(std::string name, float f1, float f2);
-        void setVertexAttributeParameter(std::string name, float f1, float f2, float f3);
-        void setVertexAttributeParameter(std::string name, float f1, float f2, float f3, float f4);
-        void setVertexAttributeParameter(std::string name, float *values, int arrLength, int size, bool dynamicDraw = false, bool normalized = false, int stride = 0);
-        void setVertexAttributeParameter(std::string name, int *values, int arrLength, int size, bool dynamicDraw = false, bool normalized = false, int stride = 0);
-        void setVertexAttributeParameter(std::string name, short *values, int arrLength, int size, bool dynamicDraw = false, bool normalized = false, int stride = 0);
+        void setUniformParameter(const Symbol &name, float f1);
+        void setUniformParameter(const Symbol &name, float f1, float f2);
+        void setUniformParameter(const Symbol &name, float f1, float f2, float f3);
+        void setUniformParameter(const Symbol &name, float f1, float f2, float f3, float f4);
+        void setUniformParameter(const Symbol &name, int i1);
+        void setUniformParameter(const Symbol &name, int i1, int i2);
+        void setUniformParameter(const Symbol &name, int i1, int i2, int i3);
+        void setUniformParameter(const Symbol &name, int i1, int i2, int i3, int i4);
+        void setUniformParameter(const Symbol &name, const float *matrix, int size = 4);
+        
+        void setVertexAttributeParameter(const Symbol &name, float f1);
+        void setVertexAttributeParameter(const Symbol &name, float f1, float f2);
+        void setVertexAttributeParameter(const Symbol &name, float f1, float f2, float f3);
+        void setVertexAttributeParameter(const Symbol &name, float f1, float f2, float f3, float f4);
+        void setVertexAttributeParameter(const Symbol &name, float *values, int arrLength, int size, bool dynamicDraw = false, bool normalized = false, int stride = 0);
+        void setVertexAttributeParameter(const Symbol &name, int *values, int arrLength, int size, bool dynamicDraw = false, bool normalized = false, int stride = 0);
+        void setVertexAttributeParameter(const Symbol &name, short *values, int arrLength, int size, bool dynamicDraw = false, bool normalized = false, int stride = 0);
         
         void bindVertexAttributeParameter(unsigned int location, float *values, int arrLength, int size, bool dynamicDraw = false, bool normalized = false, int stride = 0);
         void bindVertexAttributePointerSub(unsigned int location, float *value, int arrLength, int offset);
         
-        unsigned int bindAttributeLocation(std::string name);
-        void bindAttributeLocation(std::string name, unsigned int location);
+        unsigned int bindAttributeLocation(const Symbol &name);
+        void bindAttributeLocation(const Symbol &name, unsigned int location);
 
         float getMaxLineWidth();
         float getMaxPointSize();
@@ -193,15 +194,15 @@ namespace mog {
         GLuint glShaderProgram = 0;
 
         std::unordered_map<unsigned int, unsigned int> bufferIndexMap;
-        std::unordered_map<std::string, UniformParameter> uniformParamsMap;
-        std::unordered_map<std::string, bool> dirtyUniformParamsMap;
+        std::unordered_map<Symbol, UniformParameter> uniformParamsMap;
+        std::unordered_map<Symbol, bool> dirtyUniformParamsMap;
         std::unordered_map<unsigned int, VertexAttributeParameter> vertexAttributeParamsMap;
-        std::unordered_map<std::string, unsigned int> attributeLocationMap;
+        std::unordered_map<Symbol, unsigned int> attributeLocationMap;
         unsigned int attributeLocationIndexCounter = ATTR_LOCATION_IDX_USER_START;
 
         Shader() {}
-        void setUniformParameter(std::string name, const UniformParameter &param);
-        void setVertexAttributeParameter(std::string name, const VertexAttributeParameter &param);
+        void setUniformParameter(const Symbol &name, const UniformParameter &param);
+        void setVertexAttributeParameter(const Symbol &name, const VertexAttributeParameter &param);
         unsigned int getBufferIndex(unsigned int location);
     };
     
@@ -216,6 +217,7 @@ namespace mog {
             SolidColorWithTexture,
             VertexColorWithTexture,
             PointSprite,
+            Instanced,
         };
         
 //        static std::shared_ptr<Shader> getShader(Type type);
@@ -0,0 +1,126 @@
+#include "mog/core/Symbol.h"
+#include <string.h>
+#include <mutex>
+#include <vector>
+
+#define SYMBOL_TABLE_MIN_BUCKETS 256
+
+using namespace mog;
+
+#pragma - Symbol
+
+class Symbol::Table {
+public:
+    std::mutex mtx;
+    std::vector<Entry *> buckets;
+    size_t count = 0;
+    unsigned long long serial = 0;
+    unsigned long long markSerial = 0;
+
+    Table() : buckets(SYMBOL_TABLE_MIN_BUCKETS, nullptr) {}
+};
+
+// never destroyed, symbols may be interned during static initialization and used until exit
+Symbol::Table &Symbol::getTable() {
+    static Table *table = new Table();
+    return *table;
+}
+
+const Symbol::Entry *Symbol::intern(const char *str, size_t length) {
+    size_t hash = Symbol::hash(str, length);
+    auto &table = Symbol::getTable();
+    std::lock_guard<std::mutex> lock(table.mtx);
+
+    size_t mask = table.buckets.size() - 1;
+    for (auto entry = table.buckets[hash & mask]; entry; entry = entry->next) {
+        if (entry->hash == hash && entry->str.length() == length && memcmp(entry->str.data(), str, length) == 0) {
+            return entry;
+        }
+    }
+
+    if (table.count + 1 > table.buckets.size()) {
+        std::vector<Entry *> buckets(table.buckets.size() * 2, nullptr);
+        size_t newMask = buckets.size() - 1;
+        for (auto head : table.buckets) {
+            auto entry = head;
+            while (entry) {
+                auto next = entry->next;
+                entry->next = buckets[entry->hash & newMask];
+                buckets[entry->hash & newMask] = entry;
+                entry = next;
+            }
+        }
+        table.buckets.swap(buckets);
+        mask = newMask;
+    }
+
+    auto entry = new Entry();
+    entry->str.assign(str, length);
+    entry->hash = hash;
+    entry->serial = ++table.serial;
+    entry->next = table.buckets[hash & mask];
+    table.buckets[hash & mask] = entry;
+    table.count++;
+    return entry;
+}
+
+Symbol::Symbol() {
+    static const Entry *empty = Symbol::intern("", 0);
+    this->entry = empty;
+}
+
+Symbol::Symbol(const std::string &str) {
+    this->entry = Symbol::intern(str.data(), str.length());
+}
+
+Symbol::Symbol(const char *str) {
+    this->entry = Symbol::intern(str, strlen(str));
+}
+
+Symbol::Symbol(const char *str, size_t length) {
+    this->entry = Symbol::intern(str, length);
+}
+
+// FNV-1a
+size_t Symbol::hash(const char *str, size_t length) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)str[i];
+        h *= 1099511628211ULL;
+    }
+    return (size_t)(h ^ (h >> 32));
+}
+
+size_t Symbol::getSymbolCount() {
+    auto &table = Symbol::getTable();
+    std::lock_guard<std::mutex> lock(table.mtx);
+    return table.count;
+}
+
+void Symbol::mark() {
+    auto &table = Symbol::getTable();
+    std::lock_guard<std::mutex> lock(table.mtx);
+    table.markSerial = table.serial;
+}
+
+// the empty entry is kept, default constructed symbols share it
+size_t Symbol::purge() {
+    auto &table = Symbol::getTable();
+    std::lock_guard<std::mutex> lock(table.mtx);
+    size_t purged = 0;
+    for (auto &head : table.buckets) {
+        Entry **link = &head;
+        while (*link) {
+            Entry *entry = *link;
+            if (entry->serial > table.markSerial && !entry->str.empty()) {
+                *link = entry->next;
+                delete entry;
+                purged++;
+            } else {
+                link = &entry->next;
+            }
+        }
+    }
+    table.count -= purged;
+    return purged;
+}
@@ -0,0 +1,87 @@
+#ifndef Symbol_h
+#define Symbol_h
+
+#include <string>
+#include <functional>
+#include <type_traits>
+
+namespace mog {
+    // interned string. equal symbols share one entry, so they compare by pointer and carry a precomputed hash.
+    // entries live until exit or purge and may be created from any thread. copies do not touch the table.
+    class Symbol {
+    public:
+        Symbol();
+        Symbol(const std::string &str);
+        Symbol(const char *str);
+        Symbol(const char *str, size_t length);
+
+        const std::string &str() const {
+            return this->entry->str;
+        }
+        const char *c_str() const {
+            return this->entry->str.c_str();
+        }
+        size_t length() const {
+            return this->entry->str.length();
+        }
+        bool empty() const {
+            return this->entry->str.empty();
+        }
+        size_t hash() const {
+            return this->entry->hash;
+        }
+        bool operator==(const Symbol &symbol) const {
+            return this->entry == symbol.entry;
+        }
+        bool operator!=(const Symbol &symbol) const {
+            return this->entry != symbol.entry;
+        }
+        bool operator==(const std::string &str) const {
+            return this->entry->str == str;
+        }
+        bool operator!=(const std::string &str) const {
+            return this->entry->str != str;
+        }
+        bool operator==(const char *str) const {
+            return this->entry->str == str;
+        }
+        bool operator!=(const char *str) const {
+            return this->entry->str != str;
+        }
+
+        static size_t hash(const char *str, size_t length);
+        static size_t getSymbolCount();
+        // for tools that load and drop many documents, the engine itself never purges.
+        // purge frees the entries interned since the last mark, no symbol created from them may be alive.
+        static void mark();
+        static size_t purge();
+
+    private:
+        struct Entry {
+            std::string str;
+            size_t hash;
+            Entry *next;
+            unsigned long long serial;
+        };
+        class Table;
+
+        const Entry *entry;
+
+        static Table &getTable();
+        static const Entry *intern(const char *str, size_t length);
+    };
+
+    static_assert(sizeof(Symbol) == sizeof(void *), "Symbol must stay pointer sized");
+    static_assert(std::is_trivially_copyable<Symbol>::value, "Symbol copies must not touch the table");
+}
+
+namespace std {
+    template <>
+    struct hash<mog::Symbol> {
+        size_t operator()(const mog::Symbol &symbol) const {
+            return symbol.hash();
+        }
+    };
+}
+
+#endif /* Symbol_h */
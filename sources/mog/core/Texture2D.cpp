@@ -69,6 +69,19 @@ std::shared_ptr<Texture2D> Texture2D::createWithRGBA(unsigned char *data, int wi
     return tex2d;
 }
 
+std::shared_ptr<Texture2D> Texture2D::createWithFramebuffer(int width, int height, Density density) {
+    auto tex2d = std::make_shared<Texture2D>();
+    allTextures[(intptr_t)tex2d.get()] = tex2d;
+    tex2d->width = width;
+    tex2d->height = height;
+    tex2d->bitsPerPixel = 4;
+    tex2d->textureType = TextureType::RGBA;
+    tex2d->density = density;
+    tex2d->isFlip = true;
+    tex2d->renderTarget = true;
+    return tex2d;
+}
+
 Texture2D::Texture2D() {
 }
 
@@ -172,6 +185,7 @@ GLenum toGLFormat(TextureType textureType) {
 }
 
 void Texture2D::bindTexture(int textureIdx) {
+    if (this->renderTarget && this->textureId > 0) return;
     if (this->textureId == 0) {
         glGenTextures(1, &this->textureId);
     }
@@ -268,7 +282,31 @@ GLenum Texture2D::getTextureEnum(int textureIdx) {
     return textureEnums[textureIdx];
 }
 
+void Texture2D::bindFramebuffer() {
+    if (this->textureId == 0) {
+        this->bindTexture();
+    }
+    if (this->framebufferId == 0) {
+        glGenFramebuffers(1, &this->framebufferId);
+        glBindFramebuffer(GL_FRAMEBUFFER, this->framebufferId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->textureId, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            LOGE("Framebuffer is not complete. (%d x %d)", this->width, this->height);
+        }
+    } else {
+        glBindFramebuffer(GL_FRAMEBUFFER, this->framebufferId);
+    }
+}
+
+bool Texture2D::isRenderTarget() {
+    return this->renderTarget;
+}
+
 void Texture2D::releaseBuffer() {
+    if (this->framebufferId > 0) {
+        glDeleteFramebuffers(1, &this->framebufferId);
+        this->framebufferId = 0;
+    }
     if (this->textureId > 0) {
         glDeleteTextures(1, &this->textureId);
         this->textureId = 0;
@@ -21,6 +21,7 @@ namespace mog {
     class Texture2D {
     public:
         GLuint textureId = 0;
+        GLuint framebufferId = 0;
         std::string filename;
         TextureType textureType = TextureType::RGBA;
         int width = 0;
@@ -37,6 +38,7 @@ namespace mog {
         static std::shared_ptr<Texture2D> createWithText(std::string text, float fontSize, std::string fontFilename = "", float height = 0);
         static std::shared_ptr<Texture2D> createWithColor(TextureType textureType, const Color &color, int width, int height, Density density);
         static std::shared_ptr<Texture2D> createWithRGBA(unsigned char *data, int width, int height, Density density);
+        static std::shared_ptr<Texture2D> createWithFramebuffer(int width, int height, Density density);
         static void releaseAllBufferes();
         static GLenum getTextureEnum(int textureIdx);
 
@@ -45,10 +47,13 @@ namespace mog {
         
         void bindTexture(int textureIdx = 0);
         void bindTextureSub(GLubyte* data, int x, int y, int width, int height);
+        void bindFramebuffer();
+        bool isRenderTarget();
         void loadImageFromBuffer(unsigned char *buffer, int len);
         
     private:
         static std::unordered_map<intptr_t, std::weak_ptr<Texture2D>> allTextures;
+        bool renderTarget = false;
         
         void loadTextureAsset(std::string filename);
         std::shared_ptr<ByteArray> readBytesAsset(std::string filename, Density *density);
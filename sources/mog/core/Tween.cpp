@@ -2,6 +2,7 @@
 #include <algorithm>
 #include "mog/Constants.h"
 #include "mog/core/Tween.h"
+#include "mog/core/TweenManager.h"
 #include "mog/core/Engine.h"
 #include "mog/base/Drawable.h"
 
@@ -113,6 +114,69 @@ std::shared_ptr<EasingFunc> EasingFunc::getEasingFunc(Easing easing) {
     }
 }
 
+float EasingFunc::ease(Easing easing, float t) {
+    // the concrete types are known here, so process() is called without a virtual dispatch or an allocation
+    switch (easing) {
+        case Easing::QuadIn:
+            return EasingQuadIn().process(t);
+        case Easing::QuadOut:
+            return EasingQuadOut().process(t);
+        case Easing::QuadInOut:
+            return EasingQuadInOut().process(t);
+        case Easing::CubicIn:
+            return EasingCubicIn().process(t);
+        case Easing::CubicOut:
+            return EasingCubicOut().process(t);
+        case Easing::CubicInOut:
+            return EasingCubicInOut().process(t);
+        case Easing::QuartIn:
+            return EasingQuartIn().process(t);
+        case Easing::QuartOut:
+            return EasingQuartOut().process(t);
+        case Easing::QuartInOut:
+            return EasingQuartInOut().process(t);
+        case Easing::QuintIn:
+            return EasingQuintIn().process(t);
+        case Easing::QuintOut:
+            return EasingQuintOut().process(t);
+        case Easing::QuintInOut:
+            return EasingQuintInOut().process(t);
+        case Easing::SineIn:
+            return EasingSineIn().process(t);
+        case Easing::SineOut:
+            return EasingSineOut().process(t);
+        case Easing::SineInOut:
+            return EasingSineInOut().process(t);
+        case Easing::BackIn:
+            return EasingBackIn().process(t);
+        case Easing::BackOut:
+            return EasingBackOut().process(t);
+        case Easing::BackInOut:
+            return EasingBackInOut().process(t);
+        case Easing::CircIn:
+            return EasingCircIn().process(t);
+        case Easing::CircOut:
+            return EasingCircOut().process(t);
+        case Easing::CircInOut:
+            return EasingCircInOut().process(t);
+        case Easing::BounceIn:
+            return EasingBounceIn().process(t);
+        case Easing::BounceOut:
+            return EasingBounceOut().process(t);
+        case Easing::BounceInOut:
+            return EasingBounceInOut().process(t);
+        case Easing::ElasticIn:
+            return EasingElasticIn().process(t);
+        case Easing::ElasticOut:
+            return EasingElasticOut().process(t);
+        case Easing::ElasticInOut:
+            return EasingElasticInOut().process(t);
+        case Easing::Linear:
+        default:
+            return t;
+    }
+}
+
 // Linear
 float EasingLinear::process(float t) {
     return t;
@@ -275,7 +339,6 @@ Tween::Tween(float start, float end, float duration, Easing easing,
     this->endValue = end;
     this->duration = duration;
     this->easing = easing;
-    this->easingFunc = EasingFunc::getEasingFunc(this->easing);
     this->loopType = loopType;
     this->loopCount = loopCount;
     this->tweenId = ++Tween::tweenIdCounter;
@@ -336,7 +399,7 @@ void Tween::update(float delta, const std::shared_ptr<Drawable> &drawable) {
         return;
     }
     
-    float percent = this->easingFunc->process(this->elapsedTime / this->duration);
+    float percent = EasingFunc::ease(this->easing, this->elapsedTime / this->duration);
     if (this->loopType == LoopType::PingPong && this->currentCount % 2 == 1) {
         percent = 1.0 - percent;
     }
@@ -347,10 +410,16 @@ void Tween::update(float delta, const std::shared_ptr<Drawable> &drawable) {
 
 void Tween::pause() {
     this->pausing = true;
+    if (this->managedIndex >= 0) {
+        TweenManager::getInstance()->setPaused(this, true);
+    }
 }
 
 void Tween::resume() {
     this->pausing = false;
+    if (this->managedIndex >= 0) {
+        TweenManager::getInstance()->setPaused(this, false);
+    }
 }
 
 void Tween::addOnFinishEventForParent(std::function<void(const std::shared_ptr<Tween> &m)> callback) {
@@ -404,6 +473,13 @@ void TweenMove::onModify(float currentValue, const std::shared_ptr<Drawable> &dr
     drawable->setPosition(p);
 }
 
+void TweenMove::getKindValues(float *startValues, float *endValues) {
+    startValues[0] = this->startPoint.x;
+    startValues[1] = this->startPoint.y;
+    endValues[0] = this->endPoint.x;
+    endValues[1] = this->endPoint.y;
+}
+
 
 std::shared_ptr<TweenAlpha> TweenAlpha::create(float start, float end, float duration, Easing easing,
                                           LoopType loopType, int loopCount, float delayTime) {
@@ -422,6 +498,11 @@ void TweenAlpha::onModify(float currentValue, const std::shared_ptr<Drawable> &d
     e->setColor(color);
 }
 
+void TweenAlpha::getKindValues(float *startValues, float *endValues) {
+    startValues[0] = this->startValue;
+    endValues[0] = this->endValue;
+}
+
 
 std::shared_ptr<TweenColor> TweenColor::create(const Color &start, const Color &end, float duration, Easing easing,
                                           LoopType loopType, int loopCount, float delayTime) {
@@ -444,6 +525,17 @@ void TweenColor::onModify(float currentValue, const std::shared_ptr<Drawable> &d
     e->setColor(Color(r, g, b, a));
 }
 
+void TweenColor::getKindValues(float *startValues, float *endValues) {
+    startValues[0] = this->startColor.r;
+    startValues[1] = this->startColor.g;
+    startValues[2] = this->startColor.b;
+    startValues[3] = this->startColor.a;
+    endValues[0] = this->endColor.r;
+    endValues[1] = this->endColor.g;
+    endValues[2] = this->endColor.b;
+    endValues[3] = this->endColor.a;
+}
+
 
 std::shared_ptr<TweenScale> TweenScale::create(float start, float end, float duration, Easing easing,
                                           LoopType loopType, int loopCount, float delayTime) {
@@ -474,6 +566,13 @@ void TweenScale::onModify(float currentValue, const std::shared_ptr<Drawable> &d
     drawable->setScale(s);
 }
 
+void TweenScale::getKindValues(float *startValues, float *endValues) {
+    startValues[0] = this->startScale.x;
+    startValues[1] = this->startScale.y;
+    endValues[0] = this->endScale.x;
+    endValues[1] = this->endScale.y;
+}
+
 std::shared_ptr<TweenRotate> TweenRotate::create(float start, float end, float duration, Easing easing,
                                             LoopType loopType, int loopCount, float delayTime) {
     return std::shared_ptr<TweenRotate>(new TweenRotate(start, end, duration, easing, loopType, loopCount, delayTime));
@@ -488,6 +587,11 @@ void TweenRotate::onModify(float currentValue, const std::shared_ptr<Drawable> &
     drawable->setRotation(currentValue);
 }
 
+void TweenRotate::getKindValues(float *startValues, float *endValues) {
+    startValues[0] = this->startValue;
+    endValues[0] = this->endValue;
+}
+
 
 
 std::shared_ptr<TweenValue> TweenValue::create(float start, float end, float duration, Easing easing,
@@ -57,10 +57,21 @@ namespace mog {
         PingPong,
     };
     
+    // built-in kinds are run by TweenManager, Custom runs through Tween::update
+    enum class TweenKind {
+        Custom,
+        Move,
+        Scale,
+        Rotate,
+        Alpha,
+        Color,
+    };
+    
     
     class EasingFunc {
     public:
         static std::shared_ptr<EasingFunc> getEasingFunc(Easing easing);
+        static float ease(Easing easing, float t);
         virtual float process(float t) = 0;
     };
     // Linear
@@ -188,6 +199,8 @@ namespace mog {
     
     
     class Tween : public std::enable_shared_from_this<Tween> {
+        friend class TweenManager;
+        
     public:
         virtual void setOnStartEvent(std::function<void(const std::shared_ptr<Drawable> &d)> callback);
         virtual void setOnRestartEvent(std::function<void(const std::shared_ptr<Drawable> &d)> callback);
@@ -200,6 +213,7 @@ namespace mog {
         void addOnFinishEventForParent(std::function<void(const std::shared_ptr<Tween> &m)> callback);
         
         unsigned int getTweenId();
+        virtual TweenKind getKind() { return TweenKind::Custom; }
         
     protected:
         static unsigned int tweenIdCounter;
@@ -214,7 +228,6 @@ namespace mog {
         float duration = 0;
         Easing easing = Easing::Linear;
         LoopType loopType = LoopType::None;
-        std::shared_ptr<EasingFunc> easingFunc = nullptr;
         bool started = false;
         bool pausing = false;
         int loopCount = 0;
@@ -232,9 +245,11 @@ namespace mog {
         virtual void onRestart(const std::shared_ptr<Drawable> &drawable);
         virtual void onFinish(const std::shared_ptr<Drawable> &drawable);
         virtual void onModify(float currentValue, const std::shared_ptr<Drawable> &drawable) = 0;
+        virtual void getKindValues(float *startValues, float *endValues) {}
         
     private:
         unsigned int tweenId = 0;
+        int managedIndex = -1;
         float tmpDelayTime = 0;
         float elapsedTime = 0;
     };
@@ -245,6 +260,8 @@ namespace mog {
         static std::shared_ptr<TweenMove> create(const Point &start, const Point &end, float duration, Easing easing = Easing::Linear,
                                                  LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
         
+        virtual TweenKind getKind() override { return TweenKind::Move; }
+        
     protected:
         TweenMove(const Point &start, const Point &end, float duration, Easing easing = Easing::Linear,
                   LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
@@ -252,6 +269,7 @@ namespace mog {
         Point endPoint = Point::zero;
         
         virtual void onModify(float currentValue, const std::shared_ptr<Drawable> &drawable);
+        virtual void getKindValues(float *startValues, float *endValues) override;
     };
     
     
@@ -262,6 +280,8 @@ namespace mog {
         static std::shared_ptr<TweenScale> create(const Point &start, const Point &end, float duration, Easing easing = Easing::Linear,
                                                   LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
         
+        virtual TweenKind getKind() override { return TweenKind::Scale; }
+        
     protected:
         TweenScale(float start, float end, float duration, Easing easing = Easing::Linear,
                    LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
@@ -272,6 +292,7 @@ namespace mog {
         Point endScale = Point::zero;
         
         void onModify(float currentValue, const std::shared_ptr<Drawable> &drawable);
+        virtual void getKindValues(float *startValues, float *endValues) override;
     };
     
     
@@ -280,11 +301,14 @@ namespace mog {
         static std::shared_ptr<TweenRotate> create(float start, float end, float duration, Easing easing = Easing::Linear,
                                                    LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
         
+        virtual TweenKind getKind() override { return TweenKind::Rotate; }
+        
     protected:
         TweenRotate(float start, float end, float duration, Easing easing = Easing::Linear,
                     LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
         
         void onModify(float currentValue, const std::shared_ptr<Drawable> &drawable);
+        virtual void getKindValues(float *startValues, float *endValues) override;
     };
     
     
@@ -293,10 +317,13 @@ namespace mog {
         static std::shared_ptr<TweenAlpha> create(float start, float end, float duration, Easing easing = Easing::Linear,
                                                   LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
         
+        virtual TweenKind getKind() override { return TweenKind::Alpha; }
+        
     protected:
         TweenAlpha(float start, float end, float duration, Easing easing = Easing::Linear,
                    LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
         void onModify(float currentValue, const std::shared_ptr<Drawable> &drawable);
+        virtual void getKindValues(float *startValues, float *endValues) override;
     };
     
     
@@ -305,11 +332,14 @@ namespace mog {
         static std::shared_ptr<TweenColor> create(const Color &start, const Color &end, float duration, Easing easing = Easing::Linear,
                                                   LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
         
+        virtual TweenKind getKind() override { return TweenKind::Color; }
+        
     protected:
         TweenColor(const Color &start, const Color &end, float duration, Easing easing = Easing::Linear,
                    LoopType loopType = LoopType::None, int loopCount = 0, float delayTime = 0);
         
         void onModify(float currentValue, const std::shared_ptr<Drawable> &drawable);
+        virtual void getKindValues(float *startValues, float *endValues) override;
         
         Color startColor;
         Color endColor;
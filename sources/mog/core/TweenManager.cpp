@@ -0,0 +1,295 @@
+#include "mog/core/TweenManager.h"
+#include "mog/base/Drawable.h"
+
+#define TWEEN_STATE_STARTED     1
+#define TWEEN_STATE_PAUSED      2
+#define TWEEN_STATE_FINISHED    4
+#define TWEEN_STATE_MODIFIED    8
+
+using namespace mog;
+
+std::shared_ptr<TweenManager> TweenManager::instance;
+
+std::shared_ptr<TweenManager> TweenManager::getInstance() {
+    if (!TweenManager::instance) {
+        TweenManager::instance = std::shared_ptr<TweenManager>(new TweenManager());
+    }
+    return TweenManager::instance;
+}
+
+TweenManager::TweenManager() {
+    this->getChannel(TweenKind::Move).valueNum = 2;
+    this->getChannel(TweenKind::Scale).valueNum = 2;
+    this->getChannel(TweenKind::Rotate).valueNum = 1;
+    this->getChannel(TweenKind::Alpha).valueNum = 1;
+    this->getChannel(TweenKind::Color).valueNum = 4;
+}
+
+TweenManager::Channel &TweenManager::getChannel(TweenKind kind) {
+    return this->channels[(int)kind - 1];
+}
+
+void TweenManager::add(const std::shared_ptr<Tween> &tween, const std::shared_ptr<Drawable> &drawable) {
+    auto kind = tween->getKind();
+    if (kind == TweenKind::Custom) return;
+    if (tween->managedIndex >= 0) {
+        this->remove(tween.get());
+    }
+    tween->init();
+
+    auto &channel = this->getChannel(kind);
+    int idx = (int)channel.tweens.size();
+    int n = channel.valueNum;
+    channel.tweens.emplace_back(tween.get());
+    channel.drawables.emplace_back(drawable);
+    channel.targets.emplace_back(drawable.get());
+    channel.states.emplace_back(0);
+    channel.easings.emplace_back(tween->easing);
+    channel.loopTypes.emplace_back(tween->loopType);
+    channel.loopCounts.emplace_back(tween->loopCount);
+    channel.currentCounts.emplace_back(0);
+    channel.delayTimes.emplace_back(tween->delayTime);
+    channel.durations.emplace_back(tween->duration);
+    channel.elapsedTimes.emplace_back(0);
+    channel.percents.emplace_back(0);
+    channel.startValues.resize((idx + 1) * n);
+    channel.endValues.resize((idx + 1) * n);
+    channel.values.resize((idx + 1) * n);
+    tween->getKindValues(&channel.startValues[idx * n], &channel.endValues[idx * n]);
+    tween->managedIndex = idx;
+
+    // same as Tween::update(0) on the object path: the start value is applied right away
+    this->advance(channel, idx, 0);
+    this->interpolate(channel, idx, idx + 1);
+    this->apply(kind, channel, idx, idx + 1);
+    if (!this->updating) {
+        this->fireEvents();
+    }
+}
+
+void TweenManager::remove(Tween *tween) {
+    int idx = tween->managedIndex;
+    if (idx < 0) return;
+    auto &channel = this->getChannel(tween->getKind());
+    if (idx >= (int)channel.tweens.size() || channel.tweens[idx] != tween) {
+        tween->managedIndex = -1;
+        return;
+    }
+    this->removeAt(channel, idx);
+}
+
+void TweenManager::setPaused(Tween *tween, bool paused) {
+    int idx = tween->managedIndex;
+    if (idx < 0) return;
+    auto &channel = this->getChannel(tween->getKind());
+    if (idx >= (int)channel.tweens.size() || channel.tweens[idx] != tween) return;
+    if (paused) {
+        channel.states[idx] |= TWEEN_STATE_PAUSED;
+    } else {
+        channel.states[idx] &= ~TWEEN_STATE_PAUSED;
+    }
+}
+
+int TweenManager::getCount() {
+    int count = 0;
+    for (int k = 0; k < TWEEN_KIND_NUM; k++) {
+        count += (int)this->channels[k].tweens.size();
+    }
+    return count;
+}
+
+void TweenManager::update(float delta) {
+    this->updating = true;
+    for (int k = 0; k < TWEEN_KIND_NUM; k++) {
+        auto &channel = this->channels[k];
+        int num = (int)channel.tweens.size();
+        if (num == 0) continue;
+
+        for (int i = 0; i < num; i++) {
+            if (channel.drawables[i].expired()) {
+                channel.states[i] = (channel.states[i] | TWEEN_STATE_FINISHED) & ~TWEEN_STATE_MODIFIED;
+                continue;
+            }
+            this->advance(channel, i, delta);
+        }
+        this->interpolate(channel, 0, num);
+        this->apply((TweenKind)(k + 1), channel, 0, num);
+    }
+    this->fireEvents();
+}
+
+void TweenManager::advance(Channel &channel, int idx, float delta) {
+    unsigned char &state = channel.states[idx];
+    state &= ~TWEEN_STATE_MODIFIED;
+    if ((state & (TWEEN_STATE_PAUSED | TWEEN_STATE_FINISHED)) > 0) return;
+
+    if ((state & TWEEN_STATE_STARTED) == 0) {
+        if (channel.delayTimes[idx] > 0) {
+            channel.delayTimes[idx] -= delta;
+            if (channel.delayTimes[idx] > 0) return;
+        }
+        state |= TWEEN_STATE_STARTED;
+        this->events.emplace_back(Event{channel.tweens[idx]->shared_from_this(), channel.drawables[idx], EventType::Start});
+        delta = 0;
+    }
+
+    bool reversed = (channel.loopTypes[idx] == LoopType::PingPong && channel.currentCounts[idx] % 2 == 1);
+    channel.elapsedTimes[idx] += delta;
+    state |= TWEEN_STATE_MODIFIED;
+
+    if (channel.elapsedTimes[idx] >= channel.durations[idx]) {
+        channel.percents[idx] = reversed ? 0 : 1.0f;
+        if (channel.loopTypes[idx] == LoopType::None ||
+            (channel.loopCounts[idx] > 0 && channel.currentCounts[idx] + 1 >= channel.loopCounts[idx])) {
+            state |= TWEEN_STATE_FINISHED;
+            this->events.emplace_back(Event{channel.tweens[idx]->shared_from_this(), channel.drawables[idx], EventType::Finish});
+        } else {
+            channel.elapsedTimes[idx] = 0;
+            channel.currentCounts[idx]++;
+            this->events.emplace_back(Event{channel.tweens[idx]->shared_from_this(), channel.drawables[idx], EventType::Restart});
+        }
+        return;
+    }
+
+    float percent = EasingFunc::ease(channel.easings[idx], channel.elapsedTimes[idx] / channel.durations[idx]);
+    channel.percents[idx] = reversed ? 1.0f - percent : percent;
+}
+
+void TweenManager::interpolate(Channel &channel, int begin, int end) {
+    int n = channel.valueNum;
+    const float *percents = channel.percents.data();
+    const float *startValues = channel.startValues.data();
+    const float *endValues = channel.endValues.data();
+    float *values = channel.values.data();
+    for (int i = begin; i < end; i++) {
+        float p = percents[i];
+        float q = 1.0f - p;
+        for (int j = i * n; j < (i + 1) * n; j++) {
+            values[j] = startValues[j] * q + endValues[j] * p;
+        }
+    }
+}
+
+void TweenManager::apply(TweenKind kind, Channel &channel, int begin, int end) {
+    const unsigned char *states = channel.states.data();
+    const float *v = channel.values.data();
+    Drawable **targets = channel.targets.data();
+
+    switch (kind) {
+        case TweenKind::Move:
+            for (int i = begin; i < end; i++) {
+                if ((states[i] & TWEEN_STATE_MODIFIED) == 0) continue;
+                targets[i]->setPosition(Point(v[i * 2], v[i * 2 + 1]));
+            }
+            break;
+        case TweenKind::Scale:
+            for (int i = begin; i < end; i++) {
+                if ((states[i] & TWEEN_STATE_MODIFIED) == 0) continue;
+                targets[i]->setScale(Point(v[i * 2], v[i * 2 + 1]));
+            }
+            break;
+        case TweenKind::Rotate:
+            for (int i = begin; i < end; i++) {
+                if ((states[i] & TWEEN_STATE_MODIFIED) == 0) continue;
+                targets[i]->setRotation(v[i]);
+            }
+            break;
+        case TweenKind::Alpha:
+            for (int i = begin; i < end; i++) {
+                if ((states[i] & TWEEN_STATE_MODIFIED) == 0) continue;
+                targets[i]->setColorA(v[i]);
+            }
+            break;
+        case TweenKind::Color:
+            for (int i = begin; i < end; i++) {
+                if ((states[i] & TWEEN_STATE_MODIFIED) == 0) continue;
+                targets[i]->setColor(Color(v[i * 4], v[i * 4 + 1], v[i * 4 + 2], v[i * 4 + 3]));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void TweenManager::fireEvents() {
+    // callbacks may run or cancel tweens, so new events are appended and handled in the same pass
+    this->updating = true;
+    for (int i = 0; i < (int)this->events.size(); i++) {
+        auto event = this->events[i];
+        auto drawable = event.drawable.lock();
+        if (!drawable) continue;
+        auto &tween = event.tween;
+        switch (event.type) {
+            case EventType::Start:
+                tween->started = true;
+                tween->onStart(drawable);
+                break;
+            case EventType::Restart:
+                tween->onRestart(drawable);
+                break;
+            case EventType::Finish:
+                tween->onFinish(drawable);
+                for (auto ev : tween->onFinishEventsForParent) {
+                    ev(tween);
+                }
+                break;
+        }
+    }
+    this->events.clear();
+    this->updating = false;
+
+    for (int k = 0; k < TWEEN_KIND_NUM; k++) {
+        auto &channel = this->channels[k];
+        for (int i = (int)channel.tweens.size() - 1; i >= 0; i--) {
+            if ((channel.states[i] & TWEEN_STATE_FINISHED) > 0) {
+                this->removeAt(channel, i);
+            }
+        }
+    }
+}
+
+void TweenManager::removeAt(Channel &channel, int idx) {
+    // a tween whose drawable has been released may already be gone, so it is not touched
+    if (!channel.drawables[idx].expired()) {
+        channel.tweens[idx]->managedIndex = -1;
+    }
+    int last = (int)channel.tweens.size() - 1;
+    int n = channel.valueNum;
+    if (idx != last) {
+        channel.tweens[idx] = channel.tweens[last];
+        channel.drawables[idx] = channel.drawables[last];
+        channel.targets[idx] = channel.targets[last];
+        channel.states[idx] = channel.states[last];
+        channel.easings[idx] = channel.easings[last];
+        channel.loopTypes[idx] = channel.loopTypes[last];
+        channel.loopCounts[idx] = channel.loopCounts[last];
+        channel.currentCounts[idx] = channel.currentCounts[last];
+        channel.delayTimes[idx] = channel.delayTimes[last];
+        channel.durations[idx] = channel.durations[last];
+        channel.elapsedTimes[idx] = channel.elapsedTimes[last];
+        channel.percents[idx] = channel.percents[last];
+        for (int j = 0; j < n; j++) {
+            channel.startValues[idx * n + j] = channel.startValues[last * n + j];
+            channel.endValues[idx * n + j] = channel.endValues[last * n + j];
+            channel.values[idx * n + j] = channel.values[last * n + j];
+        }
+        if (!channel.drawables[idx].expired()) {
+            channel.tweens[idx]->managedIndex = idx;
+        }
+    }
+    channel.tweens.pop_back();
+    channel.drawables.pop_back();
+    channel.targets.pop_back();
+    channel.states.pop_back();
+    channel.easings.pop_back();
+    channel.loopTypes.pop_back();
+    channel.loopCounts.pop_back();
+    channel.currentCounts.pop_back();
+    channel.delayTimes.pop_back();
+    channel.durations.pop_back();
+    channel.elapsedTimes.pop_back();
+    channel.percents.pop_back();
+    channel.startValues.resize(last * n);
+    channel.endValues.resize(last * n);
+    channel.values.resize(last * n);
+}
@@ -0,0 +1,71 @@
+#ifndef TweenManager_h
+#define TweenManager_h
+
+#include <memory>
+#include <vector>
+#include "mog/core/Tween.h"
+
+#define TWEEN_KIND_NUM 5
+
+namespace mog {
+    class Drawable;
+
+    class TweenManager {
+    public:
+        static std::shared_ptr<TweenManager> getInstance();
+
+        void add(const std::shared_ptr<Tween> &tween, const std::shared_ptr<Drawable> &drawable);
+        void remove(Tween *tween);
+        void setPaused(Tween *tween, bool paused);
+        void update(float delta);
+        int getCount();
+
+    private:
+        enum class EventType {
+            Start,
+            Restart,
+            Finish,
+        };
+
+        struct Event {
+            std::shared_ptr<Tween> tween;
+            std::weak_ptr<Drawable> drawable;
+            EventType type;
+        };
+
+        struct Channel {
+            int valueNum = 0;
+            std::vector<Tween *> tweens;
+            std::vector<std::weak_ptr<Drawable>> drawables;
+            std::vector<Drawable *> targets;
+            std::vector<unsigned char> states;
+            std::vector<Easing> easings;
+            std::vector<LoopType> loopTypes;
+            std::vector<int> loopCounts;
+            std::vector<int> currentCounts;
+            std::vector<float> delayTimes;
+            std::vector<float> durations;
+            std::vector<float> elapsedTimes;
+            std::vector<float> percents;
+            std::vector<float> startValues;
+            std::vector<float> endValues;
+            std::vector<float> values;
+        };
+
+        static std::shared_ptr<TweenManager> instance;
+
+        Channel channels[TWEEN_KIND_NUM];
+        std::vector<Event> events;
+        bool updating = false;
+
+        TweenManager();
+        void advance(Channel &channel, int idx, float delta);
+        void interpolate(Channel &channel, int begin, int end);
+        void apply(TweenKind kind, Channel &channel, int begin, int end);
+        void fireEvents();
+        void removeAt(Channel &channel, int idx);
+        Channel &getChannel(TweenKind kind);
+    };
+}
+
+#endif /* TweenManager_h */
@@ -87,6 +87,26 @@ void main() {\
 }\
 ";
 
+static const GLchar *instanced_vertexShaderSource = "\
+attribute highp vec2 a_position;\
+attribute highp vec4 a_transform;\
+attribute highp vec2 a_translate;\
+attribute highp vec4 a_uvRect;\
+attribute mediump vec4 a_color;\
+uniform highp mat4 u_matrix;\
+uniform highp vec2 u_screenSize;\
+uniform mediump vec4 u_color;\
+varying highp vec2 v_uv0;\
+varying mediump vec4 v_color;\
+void main() {\
+    v_uv0 = a_uvRect.xy + a_position * a_uvRect.zw;\
+    v_color = a_color * u_color;\
+    highp vec2 p = a_transform.xy * a_position.x + a_transform.zw * a_position.y + a_translate;\
+    highp vec4 pos = u_matrix * vec4(p, 0.0, 1.0);\
+    gl_Position = vec4(pos.x / u_screenSize.x * 2.0 - 1.0, 1.0 - pos.y / u_screenSize.y * 2.0, 0.0, 1.0);\
+}\
+";
+
 static const GLchar *pointSprite_vertexShaderSource = "\
 attribute highp vec2 a_position;\
 attribute mediump vec4 a_color;\
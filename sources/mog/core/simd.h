@@ -0,0 +1,193 @@
+#ifndef simd_h
+#define simd_h
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MOG_SIMD_SSE
+#include <xmmintrin.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MOG_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MOG_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace mog {
+    namespace simd {
+
+#if defined(MOG_SIMD_SSE)
+        typedef __m128 f32x4;
+        static inline f32x4 load4(const float *p) { return _mm_loadu_ps(p); }
+        static inline f32x4 set4(float s) { return _mm_set1_ps(s); }
+        static inline f32x4 add4(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+        static inline f32x4 sub4(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+        static inline f32x4 mul4(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+        static inline f32x4 min4(f32x4 a, f32x4 b) { return _mm_min_ps(a, b); }
+        static inline f32x4 max4(f32x4 a, f32x4 b) { return _mm_max_ps(a, b); }
+        static inline f32x4 abs4(f32x4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        // bit i is set when a[i] < b[i]
+        static inline int lessMask4(f32x4 a, f32x4 b) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+        static inline int lessEqualMask4(f32x4 a, f32x4 b) { return _mm_movemask_ps(_mm_cmple_ps(a, b)); }
+#elif defined(MOG_SIMD_NEON)
+        typedef float32x4_t f32x4;
+        static inline f32x4 load4(const float *p) { return vld1q_f32(p); }
+        static inline f32x4 set4(float s) { return vdupq_n_f32(s); }
+        static inline f32x4 add4(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+        static inline f32x4 sub4(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+        static inline f32x4 mul4(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+        static inline f32x4 min4(f32x4 a, f32x4 b) { return vminq_f32(a, b); }
+        static inline f32x4 max4(f32x4 a, f32x4 b) { return vmaxq_f32(a, b); }
+        static inline f32x4 abs4(f32x4 a) { return vabsq_f32(a); }
+        static inline int movemask4(uint32x4_t m) {
+            return (int)((vgetq_lane_u32(m, 0) & 1) | (vgetq_lane_u32(m, 1) & 2) |
+                         (vgetq_lane_u32(m, 2) & 4) | (vgetq_lane_u32(m, 3) & 8));
+        }
+        static inline int lessMask4(f32x4 a, f32x4 b) { return movemask4(vcltq_f32(a, b)); }
+        static inline int lessEqualMask4(f32x4 a, f32x4 b) { return movemask4(vcleq_f32(a, b)); }
+#else
+        struct f32x4 {
+            float v[4];
+        };
+        static inline f32x4 load4(const float *p) { f32x4 r = {{p[0], p[1], p[2], p[3]}}; return r; }
+        static inline f32x4 set4(float s) { f32x4 r = {{s, s, s, s}}; return r; }
+#define MOG_SIMD_SCALAR_OP(name, expr) \
+        static inline f32x4 name(f32x4 a, f32x4 b) { f32x4 r; for (int i = 0; i < 4; i++) { float x = a.v[i]; float y = b.v[i]; r.v[i] = (expr); } return r; }
+        MOG_SIMD_SCALAR_OP(add4, x + y)
+        MOG_SIMD_SCALAR_OP(sub4, x - y)
+        MOG_SIMD_SCALAR_OP(mul4, x * y)
+        MOG_SIMD_SCALAR_OP(min4, (x < y) ? x : y)
+        MOG_SIMD_SCALAR_OP(max4, (x > y) ? x : y)
+#undef MOG_SIMD_SCALAR_OP
+        static inline f32x4 abs4(f32x4 a) { f32x4 r; for (int i = 0; i < 4; i++) r.v[i] = (a.v[i] < 0) ? -a.v[i] : a.v[i]; return r; }
+        static inline int lessMask4(f32x4 a, f32x4 b) { int m = 0; for (int i = 0; i < 4; i++) if (a.v[i] < b.v[i]) m |= (1 << i); return m; }
+        static inline int lessEqualMask4(f32x4 a, f32x4 b) { int m = 0; for (int i = 0; i < 4; i++) if (a.v[i] <= b.v[i]) m |= (1 << i); return m; }
+#endif
+
+        // dst[i] += src[i] * s
+        static inline void madd(float *dst, const float *src, float s, int n) {
+            int i = 0;
+#if defined(MOG_SIMD_SSE)
+            __m128 vs = _mm_set1_ps(s);
+            for (; i + 4 <= n; i += 4) {
+                __m128 vd = _mm_loadu_ps(dst + i);
+                __m128 vx = _mm_loadu_ps(src + i);
+                _mm_storeu_ps(dst + i, _mm_add_ps(vd, _mm_mul_ps(vx, vs)));
+            }
+#elif defined(MOG_SIMD_NEON)
+            float32x4_t vs = vdupq_n_f32(s);
+            for (; i + 4 <= n; i += 4) {
+                float32x4_t vd = vld1q_f32(dst + i);
+                float32x4_t vx = vld1q_f32(src + i);
+                vst1q_f32(dst + i, vmlaq_f32(vd, vx, vs));
+            }
+#endif
+            for (; i < n; i++) {
+                dst[i] += src[i] * s;
+            }
+        }
+
+        // dst[i] += s
+        static inline void add(float *dst, float s, int n) {
+            int i = 0;
+#if defined(MOG_SIMD_SSE)
+            __m128 vs = _mm_set1_ps(s);
+            for (; i + 4 <= n; i += 4) {
+                _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), vs));
+            }
+#elif defined(MOG_SIMD_NEON)
+            float32x4_t vs = vdupq_n_f32(s);
+            for (; i + 4 <= n; i += 4) {
+                vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vs));
+            }
+#endif
+            for (; i < n; i++) {
+                dst[i] += s;
+            }
+        }
+
+        // dst[i] *= s
+        static inline void mul(float *dst, float s, int n) {
+            int i = 0;
+#if defined(MOG_SIMD_SSE)
+            __m128 vs = _mm_set1_ps(s);
+            for (; i + 4 <= n; i += 4) {
+                _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), vs));
+            }
+#elif defined(MOG_SIMD_NEON)
+            float32x4_t vs = vdupq_n_f32(s);
+            for (; i + 4 <= n; i += 4) {
+                vst1q_f32(dst + i, vmulq_f32(vld1q_f32(dst + i), vs));
+            }
+#endif
+            for (; i < n; i++) {
+                dst[i] *= s;
+            }
+        }
+
+        // index of the first '"' or '\\' in p[0, n), or n
+        static inline int findQuoteOrEscape(const char *p, int n) {
+            int i = 0;
+#if defined(MOG_SIMD_SSE2)
+            __m128i quote = _mm_set1_epi8('"');
+            __m128i escape = _mm_set1_epi8('\\');
+            for (; i + 16 <= n; i += 16) {
+                __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+                int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, escape)));
+                if (mask != 0) {
+                    return i + __builtin_ctz(mask);
+                }
+            }
+#elif defined(MOG_SIMD_NEON)
+            uint8x16_t quote = vdupq_n_u8('"');
+            uint8x16_t escape = vdupq_n_u8('\\');
+            for (; i + 16 <= n; i += 16) {
+                uint8x16_t v = vld1q_u8((const uint8_t *)(p + i));
+                uint8x16_t m = vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, escape));
+                uint8x8_t m8 = vorr_u8(vget_low_u8(m), vget_high_u8(m));
+                if (vget_lane_u64(vreinterpret_u64_u8(m8), 0) != 0) break;
+            }
+#endif
+            for (; i < n; i++) {
+                if (p[i] == '"' || p[i] == '\\') return i;
+            }
+            return n;
+        }
+
+        // index of the first byte that must be escaped in a json string, or n
+        static inline int findJsonEscape(const char *p, int n) {
+            int i = 0;
+#if defined(MOG_SIMD_SSE2)
+            __m128i quote = _mm_set1_epi8('"');
+            __m128i escape = _mm_set1_epi8('\\');
+            __m128i control = _mm_set1_epi8(0x1F);
+            for (; i + 16 <= n; i += 16) {
+                __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+                __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, escape));
+                m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+                int mask = _mm_movemask_epi8(m);
+                if (mask != 0) {
+                    return i + __builtin_ctz(mask);
+                }
+            }
+#elif defined(MOG_SIMD_NEON)
+            uint8x16_t quote = vdupq_n_u8('"');
+            uint8x16_t escape = vdupq_n_u8('\\');
+            uint8x16_t space = vdupq_n_u8(0x20);
+            for (; i + 16 <= n; i += 16) {
+                uint8x16_t v = vld1q_u8((const uint8_t *)(p + i));
+                uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, escape)), vcltq_u8(v, space));
+                uint8x8_t m8 = vorr_u8(vget_low_u8(m), vget_high_u8(m));
+                if (vget_lane_u64(vreinterpret_u64_u8(m8), 0) != 0) break;
+            }
+#endif
+            for (; i < n; i++) {
+                unsigned char c = (unsigned char)p[i];
+                if (c == '"' || c == '\\' || c < 0x20) return i;
+            }
+            return n;
+        }
+    }
+}
+
+#endif /* simd_h */
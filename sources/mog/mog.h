@@ -4,14 +4,19 @@
 #include "mog/Constants.h"
 #include "mog/core/plain_objects.h"
 #include "mog/core/Tween.h"
+#include "mog/core/TweenManager.h"
 #include "mog/core/Touch.h"
 #include "mog/core/TouchEventListener.h"
+#include "mog/core/CollisionWorld.h"
 #include "mog/core/AudioPlayer.h"
 #include "mog/core/FileUtils.h"
 #include "mog/core/Preference.h"
+#include "mog/core/Symbol.h"
 #include "mog/core/Data.h"
+#include "mog/core/DataPack.h"
 #include "mog/core/Json.h"
 #include "mog/core/DataStore.h"
+#include "mog/core/Compression.h"
 #include "mog/core/PubSub.h"
 #include "mog/core/Http.h"
 #include "mog/core/MogUILoader.h"
@@ -25,6 +30,8 @@
 #include "mog/base/Slice9Sprite.h"
 #include "mog/base/TiledSprite.h"
 #include "mog/base/SpriteSheet.h"
+#include "mog/base/ParticleSystem.h"
+#include "mog/base/AnimationClip.h"
 #include "mog/base/Label.h"
 #include "mog/base/DrawableGroup.h"
 #include "mog/base/Group.h"
@@ -1,7 +1,54 @@
 #ifndef opengl_h
 #define opengl_h
 
+#include <EGL/egl.h>
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
+#include <string.h>
+#include <string>
+
+#define MOG_GL_INSTANCING
+// the entry points are resolved by glLoadInstancingMOG when instancing support is checked
+#define MOG_GL_INSTANCING_LOADER
+
+struct GLInstancingProcsMOG {
+    PFNGLDRAWELEMENTSINSTANCEDEXTPROC drawElementsInstanced = nullptr;
+    PFNGLVERTEXATTRIBDIVISOREXTPROC vertexAttribDivisor = nullptr;
+};
+
+inline GLInstancingProcsMOG &getGLInstancingProcsMOG() {
+    static GLInstancingProcsMOG procs;
+    return procs;
+}
+
+// core names on ES3, then the EXT and ANGLE instanced arrays extensions on ES2
+inline bool glLoadInstancingMOG(const char *version, const char *extensions) {
+    struct Candidate {
+        bool available;
+        const char *suffix;
+    };
+    Candidate candidates[] = {
+        {version && strstr(version, "OpenGL ES 3") != nullptr, ""},
+        {extensions && strstr(extensions, "GL_EXT_instanced_arrays") != nullptr, "EXT"},
+        {extensions && strstr(extensions, "GL_ANGLE_instanced_arrays") != nullptr, "ANGLE"},
+    };
+    auto &procs = getGLInstancingProcsMOG();
+    for (const auto &candidate : candidates) {
+        if (!candidate.available) continue;
+        procs.drawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDEXTPROC)eglGetProcAddress((std::string("glDrawElementsInstanced") + candidate.suffix).c_str());
+        procs.vertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISOREXTPROC)eglGetProcAddress((std::string("glVertexAttribDivisor") + candidate.suffix).c_str());
+        if (procs.drawElementsInstanced && procs.vertexAttribDivisor) return true;
+    }
+    procs = GLInstancingProcsMOG();
+    return false;
+}
+
+static inline void glDrawElementsInstancedMOG(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instanceCount) {
+    getGLInstancingProcsMOG().drawElementsInstanced(mode, count, type, indices, instanceCount);
+}
+
+static inline void glVertexAttribDivisorMOG(GLuint index, GLuint divisor) {
+    getGLInstancingProcsMOG().vertexAttribDivisor(index, divisor);
+}
 
 #endif /* opengl_h */
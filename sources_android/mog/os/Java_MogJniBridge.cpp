@@ -1,5 +1,6 @@
 #include <android/asset_manager_jni.h>
 #include <jni.h>
+#include <EGL/egl.h>
 #include "mog/core/Engine.h"
 #include "app/App.h"
 #include "mog/Constants.h"
@@ -49,6 +50,7 @@ public:
     }
     
     void onDrawFrame(JNIEnv* env, jobject obj) {
+        this->updateSwapBehavior();
         this->engine->onDrawFrame(this->touches);
         
         if (this->removeTouchIds.size() > 0) {
@@ -62,6 +64,8 @@ public:
     void onSurfaceCreated(JNIEnv* env, jobject obj) {
         mogmalloc_initialize();
         this->surfaceCreated = true;
+        this->swapPreserved = false;
+        this->engine->setPresentSkippable(false);
     }
     
     void onSurfaceChanged(JNIEnv* env, jobject obj, jint w, jint h, int vw, int vh, float scaleFactor) {
@@ -95,6 +99,18 @@ public:
     }
 
 private:
+    // GLSurfaceView swaps after every frame, so skipped frames need the back buffer to be preserved.
+    // preserving costs a full framebuffer restore per frame on tiled gpus, so it is only requested while frames may be skipped.
+    void updateSwapBehavior() {
+        bool preserve = this->engine->isFrameSkippingActive();
+        if (preserve == this->swapPreserved) return;
+        this->swapPreserved = preserve;
+        EGLBoolean ret = eglSurfaceAttrib(eglGetCurrentDisplay(), eglGetCurrentSurface(EGL_DRAW), EGL_SWAP_BEHAVIOR,
+                                          preserve ? EGL_BUFFER_PRESERVED : EGL_BUFFER_DESTROYED);
+        this->engine->setPresentSkippable(preserve && ret == EGL_TRUE);
+        this->engine->requestRender();
+    }
+
     enum NativeTouchAction {
         Down = 1,
         Up = 2,
@@ -106,6 +122,7 @@ private:
     std::map<unsigned int, TouchInput> touches;
     std::vector<unsigned int> removeTouchIds;
     bool surfaceCreated = false;
+    bool swapPreserved = false;
     float scaleFactor = 1.0f;
 };
 MogRenderer *MogRenderer::instance;
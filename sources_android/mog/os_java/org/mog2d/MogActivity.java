@@ -148,6 +148,7 @@ public class MogActivity extends Activity {
         this.layout = new FrameLayout(this);
         this.glSurfaceView = new GLSurfaceView(this);
         this.glSurfaceView.setEGLContextClientVersion(2);
+        this.glSurfaceView.setEGLContextFactory(new MogEGLContextFactory());
         this.glSurfaceView.setRenderer(new MogRenderer(this.glSurfaceView, this.density));
 //        this.glSurfaceView.setPreserveEGLContextOnPause(true);
         layout.addView(this.glSurfaceView);
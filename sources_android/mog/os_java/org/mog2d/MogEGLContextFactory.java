@@ -0,0 +1,29 @@
+package org.mog2d;
+
+import android.opengl.GLSurfaceView;
+
+import javax.microedition.khronos.egl.EGL10;
+import javax.microedition.khronos.egl.EGLConfig;
+import javax.microedition.khronos.egl.EGLContext;
+import javax.microedition.khronos.egl.EGLDisplay;
+
+public class MogEGLContextFactory implements GLSurfaceView.EGLContextFactory {
+
+    private static final int EGL_CONTEXT_CLIENT_VERSION = 0x3098;
+
+    @Override
+    public EGLContext createContext(EGL10 egl, EGLDisplay display, EGLConfig eglConfig) {
+        int[] attribList = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL10.EGL_NONE};
+        EGLContext context = egl.eglCreateContext(display, eglConfig, EGL10.EGL_NO_CONTEXT, attribList);
+        if (context == null || context == EGL10.EGL_NO_CONTEXT) {
+            attribList[1] = 2;
+            context = egl.eglCreateContext(display, eglConfig, EGL10.EGL_NO_CONTEXT, attribList);
+        }
+        return context;
+    }
+
+    @Override
+    public void destroyContext(EGL10 egl, EGLDisplay display, EGLContext context) {
+        egl.eglDestroyContext(display, context);
+    }
+}
@@ -81,9 +81,13 @@ static EM_BOOL mouse_callback(int eventType, const EmscriptenMouseEvent *e, void
 int main(int argc, char **argv) {
     EmscriptenWebGLContextAttributes attr;
     emscripten_webgl_init_context_attributes(&attr);
-    attr.majorVersion = 1;
+    attr.majorVersion = 2;
     attr.minorVersion = 0;
     EMSCRIPTEN_WEBGL_CONTEXT_HANDLE ctx = emscripten_webgl_create_context(0, &attr);
+    if (ctx <= 0) {
+        attr.majorVersion = 1;
+        ctx = emscripten_webgl_create_context(0, &attr);
+    }
     emscripten_webgl_make_context_current(ctx);
     emscripten_set_canvas_size(WIDTH, HEIGHT);
 
@@ -6,4 +6,8 @@
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
 
+#define MOG_GL_INSTANCING
+#define glDrawElementsInstancedMOG glDrawElementsInstancedANGLE
+#define glVertexAttribDivisorMOG glVertexAttribDivisorANGLE
+
 #endif /* opengl_h */
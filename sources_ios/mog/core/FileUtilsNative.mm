@@ -50,10 +50,26 @@ bool FileUtilsNative::readBytesAsset(std::string filename, unsigned char **data,
         }
     }
     
-    NSData *nsData = [NSData dataWithContentsOfFile:path];
-    unsigned int l = (unsigned int)nsData.length;
+    // read straight into the returned buffer instead of copying out of an NSData
+    FILE *fp = fopen(path.fileSystemRepresentation, "rb");
+    if (fp == nullptr) {
+        *data = nullptr;
+        if (len) *len = 0;
+        return false;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    unsigned int l = size > 0 ? (unsigned int)size : 0;
     *data = (unsigned char *)mogmalloc(sizeof(unsigned char) * l);
-    memcpy(*data, (unsigned char *)nsData.bytes, sizeof(unsigned char) * l);
+    size_t readLength = fread(*data, sizeof(unsigned char), l, fp);
+    fclose(fp);
+    if (size < 0 || readLength != l) {
+        mogfree(*data);
+        *data = nullptr;
+        if (len) *len = 0;
+        return false;
+    }
     if (len) *len = l;
     
     return true;
@@ -35,7 +35,10 @@ using namespace mog;
     }
     
     if (req.body) {
-        NSData *data = [NSData dataWithBytes:req.body->getBytes() length:(NSUInteger)req.body->getLength()];
+        auto body = req.body;
+        NSData *data = [[NSData alloc] initWithBytesNoCopy:body->getBytes() length:(NSUInteger)body->getLength() deallocator:^(void *bytes, NSUInteger length) {
+            (void)body;
+        }];
         [urlReq setHTTPBody:data];
     }
     
@@ -46,7 +49,12 @@ using namespace mog;
             Http::Response httpRes;
             httpRes.statusCode = (int)[(NSHTTPURLResponse *)response statusCode];
             if (error) httpRes.errorDescription = error.description.UTF8String;
-            if (data) httpRes.data = ByteArray::create((unsigned char *)data.bytes, (unsigned int )data.length, true);
+            if (data) {
+                CFTypeRef retained = CFBridgingRetain(data);
+                httpRes.data = ByteArray::createWithDeleter((unsigned char *)data.bytes, (unsigned int)data.length, [retained](unsigned char *value) {
+                    CFRelease(retained);
+                });
+            }
             if (callback) callback(httpRes);
         });
     }];
@@ -3,7 +3,11 @@
 
 #define	GL_GLEXT_PROTOTYPES
 
-#include <OpenGLES/ES2/gl.h>
-#include <OpenGLES/ES2/glext.h>
+#include <OpenGLES/ES3/gl.h>
+#include <OpenGLES/ES3/glext.h>
+
+#define MOG_GL_INSTANCING
+#define glDrawElementsInstancedMOG glDrawElementsInstanced
+#define glVertexAttribDivisorMOG glVertexAttribDivisor
 
 #endif /* opengl_h */
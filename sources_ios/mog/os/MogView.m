@@ -50,7 +50,10 @@
     glLayer.drawableProperties = @{kEAGLDrawablePropertyRetainedBacking:[NSNumber numberWithBool:FALSE],
                                    kEAGLDrawablePropertyColorFormat:kEAGLColorFormatRGBA8};
     
-    self.glContext = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES2];
+    self.glContext = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    if (!self.glContext) {
+        self.glContext = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES2];
+    }
     [EAGLContext setCurrentContext:self.glContext];
     
     glGenFramebuffers(1, &_frameBuffer);
@@ -58,7 +61,7 @@
     
     glGenRenderbuffers(1, &_colorBuffer);
     glBindRenderbuffer(GL_RENDERBUFFER, self.colorBuffer);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8_OES, _glWidth, _glHeight);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, _glWidth, _glHeight);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, self.colorBuffer);
 
     /*
@@ -37,7 +37,12 @@ using namespace mog;
             Http::Response httpRes;
             httpRes.statusCode = (int)[(NSHTTPURLResponse *)response statusCode];
             if (error) httpRes.errorDescription = error.description.UTF8String;
-            if (data) httpRes.data = ByteArray::create((unsigned char *)data.bytes, (unsigned int )data.length, true);
+            if (data) {
+                CFTypeRef retained = CFBridgingRetain(data);
+                httpRes.data = ByteArray::createWithDeleter((unsigned char *)data.bytes, (unsigned int)data.length, [retained](unsigned char *value) {
+                    CFRelease(retained);
+                });
+            }
             if (callback) callback(httpRes);
         });
     }];
@@ -6,4 +6,8 @@
 #include <OpenGL/gl.h>
 #include <OpenGL/glext.h>
 
+#define MOG_GL_INSTANCING
+#define glDrawElementsInstancedMOG glDrawElementsInstancedARB
+#define glVertexAttribDivisorMOG glVertexAttribDivisorARB
+
 #endif /* opengl_h */
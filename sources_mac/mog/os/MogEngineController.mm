@@ -90,10 +90,12 @@
         
         [EAGLContext setCurrentContext:_mogView.glContext];
         
-        _engine->onDrawFrame(_touches);
+        bool rendered = _engine->onDrawFrame(_touches);
         [self clearTouchEvent];
         
-        [_mogView.glContext presentRenderbuffer:GL_RENDERBUFFER];
+        if (rendered) {
+            [_mogView.glContext presentRenderbuffer:GL_RENDERBUFFER];
+        }
         
         if (_launchScreenView) {
             [_launchScreenView removeFromSuperview];